@@ -23,6 +23,7 @@
 using System;
 using System.Collections.Generic;
 using System.IO;
+using System.Threading.Tasks;
 using System.Windows.Forms;
 
 using zuki.ronin.data;
@@ -99,29 +100,69 @@ namespace zuki.ronin
 		private void OnExport(object sender, EventArgs args)
 		{
 			Exception exception = null;
+			string folder = m_folder.Text;
+
+			// Enumerates the cards in the database in fixed-size batches
+			IEnumerable<List<Card>> batches()
+			{
+				List<Card> batch = new List<Card>(ArtworkBatchSize);
+				foreach(Card card in m_database.EnumerateCards())
+				{
+					batch.Add(card);
+					if(batch.Count < ArtworkBatchSize) continue;
+
+					yield return batch;
+					batch = new List<Card>(ArtworkBatchSize);
+				}
+
+				if(batch.Count > 0) yield return batch;
+			}
 
 			// Action<> to perform as the background task
 			void export()
 			{
-				// Iterate over all of the cards in the database
-				m_database.EnumerateCards(card =>
+				// The cards are read in batches and each batch is exported in parallel; the artwork
+				// for all of the cards in a batch is retrieved with a single query
+				try
 				{
-					string name = card.Name;
-					foreach(char ch in Path.GetInvalidFileNameChars())
-					{
-						name = name.Replace(ch, '_');
-					}
-
-					List<Artwork> art = card.GetArtwork();
-					for(int index = 0; index < art.Count; index++)
+					Parallel.ForEach(batches(), batch =>
 					{
-						// "Dark Magician (1).jpg"
-						string filename = Path.Combine(m_folder.Text, name);
-						if(index > 0) filename += " (" + index.ToString() + ")";
-						filename += "." + art[index].Format.ToLower();
-						File.WriteAllBytes(filename, art[index].Image);
-					}
-				});
+						Dictionary<Card, List<Artwork>> artwork = m_database.GetArtwork(batch);
+
+						foreach(Card card in batch)
+						{
+							string name = card.Name;
+							foreach(char ch in Path.GetInvalidFileNameChars())
+							{
+								name = name.Replace(ch, '_');
+							}
+
+							List<Artwork> art = artwork[card];
+							for(int index = 0; index < art.Count; index++)
+							{
+								// "Dark Magician (1).jpg"
+								string filename = Path.Combine(folder, name);
+								if(index > 0) filename += " (" + index.ToString() + ")";
+								filename += "." + art[index].Format.ToLower();
+
+								// Stream the image directly from the database into the file
+								using(Stream image = art[index].OpenImageStream())
+								using(FileStream file = File.Create(filename))
+								{
+									image.CopyTo(file);
+								}
+							}
+						}
+					});
+				}
+				catch(AggregateException ex)
+				{
+					exception = ex.Flatten().InnerExceptions[0];
+				}
+				catch(Exception ex)
+				{
+					exception = ex;
+				}
 			}
 
 			// Use a background task dialog to execute the operation
@@ -147,6 +188,15 @@ namespace zuki.ronin
 			m_export.Enabled = Directory.Exists(m_folder.Text);
 		}
 
+		//---------------------------------------------------------------------
+		// Private Constants
+		//---------------------------------------------------------------------
+
+		/// <summary>
+		/// Number of cards to retrieve artwork metadata for in a single query
+		/// </summary>
+		private const int ArtworkBatchSize = 64;
+
 		//---------------------------------------------------------------------
 		// Member Variables
 		//---------------------------------------------------------------------
@@ -101,25 +101,39 @@ namespace zuki.ronin
 		private void OnExport(object sender, EventArgs args)
 		{
 			Exception exception = null;
+			string folder = m_folder.Text;
 
 			// Action<> to perform as the background task
 			void export()
 			{
-				// Iterate over all of the cards in the database
-				m_database.EnumerateCards(card =>
+				// Iterate over all of the cards in the database; the cards are read on a separate
+				// thread ahead of the renderer.  The renderer shares GDI+ resources between calls
+				// that cannot be used by more than one thread, there is only a single consumer
+				try
 				{
-					using(Bitmap bmp = Renderer.RenderCard(card))
+					m_database.EnumerateCards(card =>
 					{
-						// "Dark Magician.png"
-						string name = card.Name;
-						foreach(char ch in Path.GetInvalidFileNameChars())
+						using(Bitmap bmp = Renderer.RenderCard(card))
 						{
-							name = name.Replace(ch, '_');
+							// "Dark Magician.png"
+							string name = card.Name;
+							foreach(char ch in Path.GetInvalidFileNameChars())
+							{
+								name = name.Replace(ch, '_');
+							}
+							string filename = Path.Combine(folder, name + ".png");
+							bmp.Save(filename, ImageFormat.Png);
 						}
-						string filename = Path.Combine(m_folder.Text, name + ".png");
-						bmp.Save(filename, ImageFormat.Png);
-					}
-				});
+					}, QueueCapacity, 1);
+				}
+				catch(AggregateException ex)
+				{
+					exception = ex.Flatten().InnerExceptions[0];
+				}
+				catch(Exception ex)
+				{
+					exception = ex;
+				}
 			}
 
 			// Use a background task dialog to execute the operation
@@ -145,6 +159,15 @@ namespace zuki.ronin
 			m_export.Enabled = Directory.Exists(m_folder.Text);
 		}
 
+		//---------------------------------------------------------------------
+		// Private Constants
+		//---------------------------------------------------------------------
+
+		/// <summary>
+		/// Maximum number of cards read ahead of the renderer
+		/// </summary>
+		private const int QueueCapacity = 64;
+
 		//---------------------------------------------------------------------
 		// Member Variables
 		//---------------------------------------------------------------------
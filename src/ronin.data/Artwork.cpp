@@ -83,6 +83,17 @@ bool Artwork::operator!=(Artwork^ lhs, Artwork^ rhs)
 	return lhs->m_artworkid != rhs->m_artworkid;
 }
 
+//---------------------------------------------------------------------------
+// Artwork::CardID::get (internal)
+//
+// Gets the card unique identifier
+
+CardId^ Artwork::CardID::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return m_cardid;
+}
+
 //---------------------------------------------------------------------------
 // Artwork::Equals
 //
@@ -187,6 +198,15 @@ void Artwork::Height::set(int value)
 array<Byte>^ Artwork::Image::get(void)
 {
 	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_database));
+
+	// Metadata-only queries do not select the image; load it on first access
+	if(!m_imageloaded) {
+
+		m_image = m_database->SelectArtworkImage(m_artworkid);
+		m_imageloaded = true;
+	}
+
 	return m_image;
 }
 
@@ -200,6 +220,24 @@ void Artwork::Image::set(array<Byte>^ value)
 	CHECK_DISPOSED(m_disposed);
 	if(CLRISNOTNULL(m_image)) delete m_image;
 	m_image = value;
+	m_imageloaded = true;
+}
+
+//---------------------------------------------------------------------------
+// Artwork::OpenImageStream
+//
+// Opens a read-only stream against the artwork image in the database
+//
+// Arguments:
+//
+//	NONE
+
+Stream^ Artwork::OpenImageStream(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_database));
+
+	return m_database->OpenArtworkImage(m_artworkid);
 }
 
 //---------------------------------------------------------------------------
@@ -231,9 +269,11 @@ void Artwork::SetDefault(void)
 Bitmap^ Artwork::ToBitmap(void)
 {
 	CHECK_DISPOSED(m_disposed);
-	if(CLRISNULL(m_image)) return nullptr;
 
-	msclr::auto_handle<MemoryStream> stream(gcnew MemoryStream(m_image));
+	array<Byte>^ image = Image;
+	if(CLRISNULL(image)) return nullptr;
+
+	msclr::auto_handle<MemoryStream> stream(gcnew MemoryStream(image));
 	return gcnew Bitmap(stream.get());
 }
 
@@ -281,6 +321,7 @@ void Artwork::UpdateImage(String^ format, int width, int height, array<Byte>^ im
 
 	if(CLRISNOTNULL(m_image)) delete m_image;
 	m_image = image;
+	m_imageloaded = true;
 }
 
 //---------------------------------------------------------------------------
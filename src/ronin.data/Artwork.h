@@ -31,6 +31,7 @@
 
 using namespace System;
 using namespace System::Drawing;
+using namespace System::IO;
 
 namespace zuki::ronin::data {
 
@@ -78,6 +79,11 @@ public:
 	// Overrides Object::GetHashCode()
 	virtual int GetHashCode(void) override;
 
+	// OpenImageStream
+	//
+	// Opens a read-only stream against the artwork image in the database
+	Stream^ OpenImageStream(void);
+
 	// SetDefault
 	//
 	// Sets the artwork as the default for the Card
@@ -121,7 +127,7 @@ public:
 
 	// Image
 	//
-	// Gets the artwork image
+	// Gets the artwork image; loaded from the database on first access
 	property array<Byte>^ Image
 	{
 		array<Byte>^ get(void);
@@ -143,6 +149,14 @@ internal:
 	//
 	Artwork(Database^ database, ArtworkId^ artworkid, CardId^ cardid);
 
+	// CardID
+	//
+	// Gets the card unique identifier
+	property CardId^ CardID
+	{
+		CardId^ get(void);
+	}
+
 private:
 
 	// Destructor
@@ -160,6 +174,7 @@ private:
 	String^					m_format = String::Empty;	// Image format
 	int						m_height = 0;				// Image height
 	array<Byte>^			m_image;					// Image
+	bool					m_imageloaded = false;		// Image loaded flag
 	int						m_width = 0;				// Image width
 };
 
@@ -42,9 +42,10 @@ ref class ArtworkId : public Uuid
 {
 public:
 
-	// Instance Constructor
+	// Instance Constructors
 	//
 	ArtworkId(Guid uuid) : Uuid(uuid) {}
+	ArtworkId(uuidkey_t const& key) : Uuid(key) {}
 };
 
 //---------------------------------------------------------------------------
@@ -0,0 +1,301 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "ArtworkStream.h"
+
+#include "SQLiteException.h"
+
+#pragma warning(push, 4)
+
+namespace zuki::ronin::data {
+
+//---------------------------------------------------------------------------
+// ArtworkStream Constructor
+//
+// Arguments:
+//
+//	pool		- Database connection pool
+//	artworkid	- Artwork identifier
+
+ArtworkStream::ArtworkStream(ConnectionPool^ pool, ArtworkId^ artworkid)
+{
+	sqlite3_blob* blob = nullptr;
+
+	if(CLRISNULL(pool)) throw gcnew ArgumentNullException("pool");
+	if(CLRISNULL(artworkid)) throw gcnew ArgumentNullException("artworkid");
+
+	// Lease a connection for the lifetime of the stream; the lease is detached
+	// from the calling thread as the stream may be read from any thread
+	m_instance = gcnew ConnectionPool::Lease(pool, ConnectionPool::LeaseMode::Detached);
+
+	try {
+
+		sqlite3* instance = *m_instance;
+
+		// sqlite3_blob_open() requires the ROWID of the artwork row
+		auto sql = L"select rowid from artwork where artworkid = ?1";
+
+		// Convert the artworkid into a native key
+		uuidkey_t _artworkid = artworkid->ToKey();
+
+		// Acquire the prepared query from the statement cache
+		sqlite3_stmt* statement = m_instance->Statements->Acquire(instance, sql);
+
+		try {
+
+			// Bind the query parameter(s)
+			int result = sqlite3_bind_blob(statement, 1, &_artworkid, sizeof(uuidkey_t), SQLITE_STATIC);
+			if(result != SQLITE_OK) throw gcnew SQLiteException(result);
+
+			// Execute the query; there should be exactly one row returned
+			result = sqlite3_step(statement);
+			if(result == SQLITE_DONE) throw gcnew ArgumentException("Specified artwork does not exist in the database", "artworkid");
+			else if(result != SQLITE_ROW) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+
+			// Open the artwork.image BLOB for read-only access while the query is still positioned on
+			// the row; both share one read transaction, which the BLOB handle then holds open for the
+			// lifetime of the stream, so the ROWID cannot be removed or renumbered in between
+			result = sqlite3_blob_open(instance, "main", "artwork", "image", sqlite3_column_int64(statement, 0), 0, &blob);
+			if(result != SQLITE_OK) {
+
+				if(blob != nullptr) sqlite3_blob_close(blob);
+				throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+			}
+		}
+
+		finally { m_instance->Statements->Release(statement); }
+
+		m_blob = blob;
+		m_length = sqlite3_blob_bytes(blob);
+	}
+
+	catch(Exception^) { delete m_instance; throw; }
+}
+
+//---------------------------------------------------------------------------
+// ArtworkStream Destructor
+
+ArtworkStream::~ArtworkStream()
+{
+	if(m_disposed) return;
+
+	this->!ArtworkStream();
+
+	// The connection lease is a managed object and is only released here, it
+	// cannot be returned to the connection pool from the finalizer thread
+	if(CLRISNOTNULL(m_instance)) { delete m_instance; m_instance = nullptr; }
+
+	m_disposed = true;
+}
+
+//---------------------------------------------------------------------------
+// ArtworkStream Finalizer
+
+ArtworkStream::!ArtworkStream()
+{
+	// The BLOB handle must be closed before the connection lease is released;
+	// the SQLiteSafeHandle is a critical finalizer object and will not be
+	// released before this finalizer has been executed
+	if(m_blob != nullptr) { sqlite3_blob_close(m_blob); m_blob = nullptr; }
+}
+
+//---------------------------------------------------------------------------
+// ArtworkStream::CanRead::get
+//
+// Gets a value indicating whether the stream supports reading
+
+bool ArtworkStream::CanRead::get(void)
+{
+	return !m_disposed;
+}
+
+//---------------------------------------------------------------------------
+// ArtworkStream::CanSeek::get
+//
+// Gets a value indicating whether the stream supports seeking
+
+bool ArtworkStream::CanSeek::get(void)
+{
+	return !m_disposed;
+}
+
+//---------------------------------------------------------------------------
+// ArtworkStream::CanWrite::get
+//
+// Gets a value indicating whether the stream supports writing
+
+bool ArtworkStream::CanWrite::get(void)
+{
+	return false;
+}
+
+//---------------------------------------------------------------------------
+// ArtworkStream::Flush
+//
+// Clears all buffers for this stream
+//
+// Arguments:
+//
+//	NONE
+
+void ArtworkStream::Flush(void)
+{
+	CHECK_DISPOSED(m_disposed);
+}
+
+//---------------------------------------------------------------------------
+// ArtworkStream::Length::get
+//
+// Gets the length of the stream in bytes
+
+int64_t ArtworkStream::Length::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return m_length;
+}
+
+//---------------------------------------------------------------------------
+// ArtworkStream::Position::get
+//
+// Gets the position within the stream
+
+int64_t ArtworkStream::Position::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return m_position;
+}
+
+//---------------------------------------------------------------------------
+// ArtworkStream::Position::set
+//
+// Sets the position within the stream
+
+void ArtworkStream::Position::set(int64_t value)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if(value < 0) throw gcnew ArgumentOutOfRangeException("value");
+	m_position = value;
+}
+
+//---------------------------------------------------------------------------
+// ArtworkStream::Read
+//
+// Reads a sequence of bytes from the stream
+//
+// Arguments:
+//
+//	buffer		- Destination buffer
+//	offset		- Offset within buffer to begin writing data
+//	count		- Maximum number of bytes to read
+
+int ArtworkStream::Read(array<Byte>^ buffer, int offset, int count)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if(CLRISNULL(buffer)) throw gcnew ArgumentNullException("buffer");
+	if(offset < 0) throw gcnew ArgumentOutOfRangeException("offset");
+	if(count < 0) throw gcnew ArgumentOutOfRangeException("count");
+	if((buffer->Length - offset) < count) throw gcnew ArgumentException("The sum of offset and count is larger than the buffer length");
+
+	// Reading at or past the end of the BLOB returns zero bytes
+	if(m_position >= m_length) return 0;
+
+	// Don't attempt to read past the end of the BLOB, sqlite3_blob_read() will fail
+	count = static_cast<int>(Math::Min(static_cast<int64_t>(count), m_length - m_position));
+	if(count == 0) return 0;
+
+	// Read the data directly into the pinned managed buffer
+	pin_ptr<Byte> pinbuffer = &buffer[offset];
+	int result = sqlite3_blob_read(m_blob, pinbuffer, count, static_cast<int>(m_position));
+	if(result != SQLITE_OK) throw gcnew SQLiteException(result);
+
+	m_position += count;
+	return count;
+}
+
+//---------------------------------------------------------------------------
+// ArtworkStream::Seek
+//
+// Sets the position within the stream
+//
+// Arguments:
+//
+//	offset		- Byte offset relative to the origin
+//	origin		- Reference point used to obtain the new position
+
+int64_t ArtworkStream::Seek(int64_t offset, SeekOrigin origin)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	int64_t position = 0;
+
+	switch(origin) {
+
+		case SeekOrigin::Begin: position = offset; break;
+		case SeekOrigin::Current: position = m_position + offset; break;
+		case SeekOrigin::End: position = m_length + offset; break;
+		default: throw gcnew ArgumentOutOfRangeException("origin");
+	}
+
+	if(position < 0) throw gcnew IOException("An attempt was made to move the position before the beginning of the stream");
+
+	m_position = position;
+	return m_position;
+}
+
+//---------------------------------------------------------------------------
+// ArtworkStream::SetLength
+//
+// Sets the length of the stream
+//
+// Arguments:
+//
+//	value		- New stream length
+
+void ArtworkStream::SetLength(int64_t /*value*/)
+{
+	throw gcnew NotSupportedException();
+}
+
+//---------------------------------------------------------------------------
+// ArtworkStream::Write
+//
+// Writes a sequence of bytes to the stream
+//
+// Arguments:
+//
+//	buffer		- Source buffer
+//	offset		- Offset within buffer to begin reading data
+//	count		- Number of bytes to write
+
+void ArtworkStream::Write(array<Byte>^ /*buffer*/, int /*offset*/, int /*count*/)
+{
+	throw gcnew NotSupportedException();
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::ronin::data
+
+#pragma warning(pop)
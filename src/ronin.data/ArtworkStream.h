@@ -0,0 +1,150 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __ARTWORKSTREAM_H_
+#define __ARTWORKSTREAM_H_
+#pragma once
+
+#include "ArtworkId.h"
+#include "ConnectionPool.h"
+
+#pragma warning(push, 4)
+
+using namespace System;
+using namespace System::IO;
+
+namespace zuki::ronin::data {
+
+//---------------------------------------------------------------------------
+// Class ArtworkStream (internal)
+//
+// Read-only Stream implementation over an artwork image BLOB; data is read
+// directly from the database in chunks as requested by the caller
+//---------------------------------------------------------------------------
+
+ref class ArtworkStream : public Stream
+{
+public:
+
+	// Instance Constructor
+	//
+	ArtworkStream(ConnectionPool^ pool, ArtworkId^ artworkid);
+
+	// Destructor
+	//
+	~ArtworkStream();
+
+	// Finalizer
+	//
+	!ArtworkStream();
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Flush (Stream)
+	//
+	// Clears all buffers for this stream
+	virtual void Flush(void) override;
+
+	// Read (Stream)
+	//
+	// Reads a sequence of bytes from the stream
+	virtual int Read(array<Byte>^ buffer, int offset, int count) override;
+
+	// Seek (Stream)
+	//
+	// Sets the position within the stream
+	virtual int64_t Seek(int64_t offset, SeekOrigin origin) override;
+
+	// SetLength (Stream)
+	//
+	// Sets the length of the stream
+	virtual void SetLength(int64_t value) override;
+
+	// Write (Stream)
+	//
+	// Writes a sequence of bytes to the stream
+	virtual void Write(array<Byte>^ buffer, int offset, int count) override;
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// CanRead (Stream)
+	//
+	// Gets a value indicating whether the stream supports reading
+	property bool CanRead
+	{
+		virtual bool get(void) override;
+	}
+
+	// CanSeek (Stream)
+	//
+	// Gets a value indicating whether the stream supports seeking
+	property bool CanSeek
+	{
+		virtual bool get(void) override;
+	}
+
+	// CanWrite (Stream)
+	//
+	// Gets a value indicating whether the stream supports writing
+	property bool CanWrite
+	{
+		virtual bool get(void) override;
+	}
+
+	// Length (Stream)
+	//
+	// Gets the length of the stream in bytes
+	property int64_t Length
+	{
+		virtual int64_t get(void) override;
+	}
+
+	// Position (Stream)
+	//
+	// Gets or sets the position within the stream
+	property int64_t Position
+	{
+		virtual int64_t get(void) override;
+		virtual void set(int64_t value) override;
+	}
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	bool							m_disposed = false;		// Object disposal flag
+	ConnectionPool::Lease^			m_instance;				// Database connection lease
+	sqlite3_blob*					m_blob = nullptr;		// BLOB handle
+	int								m_length = 0;			// Length of the BLOB
+	int64_t							m_position = 0;			// Current stream position
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::ronin::data
+
+#pragma warning(pop)
+
+#endif	// __ARTWORKSTREAM_H_
@@ -97,6 +97,16 @@ void Card::ArtworkID::set(ArtworkId^ value)
 	m_artworkid = value;
 }
 
+//---------------------------------------------------------------------------
+// Card::CardID::get (internal)
+//
+// Gets the card unique identifier
+
+CardId^ Card::CardID::get(void)
+{
+	return m_cardid;
+}
+
 //---------------------------------------------------------------------------
 // Card::Equals
 //
@@ -335,17 +345,17 @@ CardType Card::Type::get(void)
 //---------------------------------------------------------------------------
 // Card::UpdateRulings
 //
-// Updates the rulings for this card in the database
+// Updates the rulings for this card in the database and returns the number of rows written
 //
 // Arguments:
 //
 //	rulings		- New rulings to assign to the card
 
-void Card::UpdateRulings(IEnumerable<String^>^ rulings)
+int Card::UpdateRulings(IEnumerable<String^>^ rulings)
 {
 	CLRASSERT(CLRISNOTNULL(m_database));
 
-	m_database->UpdateCardRulings(m_cardid, rulings);
+	return m_database->UpdateCardRulings(m_cardid, rulings);
 }
 
 //---------------------------------------------------------------------------
@@ -118,8 +118,8 @@ public:
 
 	// UpdateRulings
 	//
-	// Updates the rulings for this card in the database
-	void UpdateRulings(IEnumerable<String^>^ rulings);
+	// Updates the rulings for this card in the database and returns the number of rows written
+	int UpdateRulings(IEnumerable<String^>^ rulings);
 
 	// UpdateText
 	//
@@ -187,6 +187,14 @@ internal:
 		internal: void set(ArtworkId^ value);
 	}
 
+	// CardID
+	//
+	// Gets the card unique identifier
+	property CardId^ CardID
+	{
+		CardId^ get(void);
+	}
+
 private:
 
 	//-----------------------------------------------------------------------
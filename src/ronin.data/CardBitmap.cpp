@@ -0,0 +1,192 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "CardBitmap.h"
+
+#include "CardBitmapIndex.h"
+
+#pragma warning(push, 4)
+
+namespace zuki::ronin::data {
+
+//---------------------------------------------------------------------------
+// CardBitmap Constructor (internal)
+//
+// Arguments:
+//
+//	index		- Owning CardBitmapIndex instance
+
+CardBitmap::CardBitmap(CardBitmapIndex^ index) : CardBitmap(index, new roaringbitmap())
+{
+}
+
+//---------------------------------------------------------------------------
+// CardBitmap Constructor (internal)
+//
+// Arguments:
+//
+//	index		- Owning CardBitmapIndex instance
+//	bitmap		- Native set of card ordinals; ownership is transferred
+
+CardBitmap::CardBitmap(CardBitmapIndex^ index, roaringbitmap* bitmap) : m_index(index), m_bitmap(bitmap)
+{
+	CLRASSERT(CLRISNOTNULL(index));
+	CLRASSERT(bitmap != nullptr);
+}
+
+//---------------------------------------------------------------------------
+// CardBitmap Finalizer
+
+CardBitmap::!CardBitmap()
+{
+	if(m_bitmap != nullptr) { delete m_bitmap; m_bitmap = nullptr; }
+}
+
+//---------------------------------------------------------------------------
+// CardBitmap::Add (internal)
+//
+// Adds a card ordinal to the set
+//
+// Arguments:
+//
+//	ordinal		- Card ordinal to be added
+
+void CardBitmap::Add(int ordinal)
+{
+	CLRASSERT(ordinal >= 0);
+	m_bitmap->add(static_cast<uint32_t>(ordinal));
+}
+
+//---------------------------------------------------------------------------
+// CardBitmap::And
+//
+// Generates the set of Cards present in both this set and another set
+//
+// Arguments:
+//
+//	rhs			- Set to intersect with this set
+
+CardBitmap^ CardBitmap::And(CardBitmap^ rhs)
+{
+	ValidateOperand(rhs);
+
+	CardBitmap^ result = gcnew CardBitmap(m_index, new roaringbitmap(roaringbitmap::intersect(*m_bitmap, *rhs->m_bitmap)));
+	GC::KeepAlive(rhs);
+
+	return result;
+}
+
+//---------------------------------------------------------------------------
+// CardBitmap::AndNot
+//
+// Generates the set of Cards present in this set but not in another set
+//
+// Arguments:
+//
+//	rhs			- Set to subtract from this set
+
+CardBitmap^ CardBitmap::AndNot(CardBitmap^ rhs)
+{
+	ValidateOperand(rhs);
+
+	CardBitmap^ result = gcnew CardBitmap(m_index, new roaringbitmap(roaringbitmap::subtract(*m_bitmap, *rhs->m_bitmap)));
+	GC::KeepAlive(rhs);
+
+	return result;
+}
+
+//---------------------------------------------------------------------------
+// CardBitmap::Count::get
+//
+// Gets the number of Cards in the set
+
+int CardBitmap::Count::get(void)
+{
+	return static_cast<int>(m_bitmap->cardinality());
+}
+
+//---------------------------------------------------------------------------
+// CardBitmap::GetOrdinals (internal)
+//
+// Gets the card ordinals in the set in ascending order
+//
+// Arguments:
+//
+//	ordinals	- Vector to receive the card ordinals
+
+void CardBitmap::GetOrdinals(std::vector<uint32_t>& ordinals)
+{
+	m_bitmap->values(ordinals);
+}
+
+//---------------------------------------------------------------------------
+// CardBitmap::Index::get (internal)
+//
+// Gets the CardBitmapIndex that the set was generated from
+
+CardBitmapIndex^ CardBitmap::Index::get(void)
+{
+	return m_index;
+}
+
+//---------------------------------------------------------------------------
+// CardBitmap::Or
+//
+// Generates the set of Cards present in either this set or another set
+//
+// Arguments:
+//
+//	rhs			- Set to unite with this set
+
+CardBitmap^ CardBitmap::Or(CardBitmap^ rhs)
+{
+	ValidateOperand(rhs);
+
+	CardBitmap^ result = gcnew CardBitmap(m_index, new roaringbitmap(roaringbitmap::unite(*m_bitmap, *rhs->m_bitmap)));
+	GC::KeepAlive(rhs);
+
+	return result;
+}
+
+//---------------------------------------------------------------------------
+// CardBitmap::ValidateOperand (private)
+//
+// Ensures that another set can be combined with this set
+//
+// Arguments:
+//
+//	rhs			- Set to be validated
+
+void CardBitmap::ValidateOperand(CardBitmap^ rhs)
+{
+	if(CLRISNULL(rhs)) throw gcnew ArgumentNullException("rhs");
+
+	// Card ordinals are only meaningful within the same CardBitmapIndex
+	if(!Object::ReferenceEquals(m_index, rhs->m_index)) throw gcnew ArgumentException("CardBitmap was generated from a different CardBitmapIndex", "rhs");
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::ronin::data
+
+#pragma warning(pop)
@@ -0,0 +1,138 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __CARDBITMAP_H_
+#define __CARDBITMAP_H_
+#pragma once
+
+#include "roaringbitmap.h"
+
+#pragma warning(push, 4)
+
+using namespace System;
+
+namespace zuki::ronin::data {
+
+// FORWARD DECLARATIONS
+//
+ref class CardBitmapIndex;
+
+//---------------------------------------------------------------------------
+// Class CardBitmap
+//
+// Immutable set of Cards from a CardBitmapIndex; sets from the same index can
+// be combined and counted without accessing the database
+//---------------------------------------------------------------------------
+
+public ref class CardBitmap
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// And
+	//
+	// Generates the set of Cards present in both this set and another set
+	CardBitmap^ And(CardBitmap^ rhs);
+
+	// AndNot
+	//
+	// Generates the set of Cards present in this set but not in another set
+	CardBitmap^ AndNot(CardBitmap^ rhs);
+
+	// Or
+	//
+	// Generates the set of Cards present in either this set or another set
+	CardBitmap^ Or(CardBitmap^ rhs);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Count
+	//
+	// Gets the number of Cards in the set
+	property int Count
+	{
+		int get(void);
+	}
+
+internal:
+
+	// Instance Constructors
+	//
+	CardBitmap(CardBitmapIndex^ index);
+	CardBitmap(CardBitmapIndex^ index, roaringbitmap* bitmap);
+
+	// Finalizer
+	//
+	// Instances are shared by the CardBitmapIndex and are not IDisposable
+	!CardBitmap();
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// Add
+	//
+	// Adds a card ordinal to the set
+	void Add(int ordinal);
+
+	// GetOrdinals
+	//
+	// Gets the card ordinals in the set in ascending order
+	void GetOrdinals(std::vector<uint32_t>& ordinals);
+
+	//-----------------------------------------------------------------------
+	// Internal Properties
+
+	// Index
+	//
+	// Gets the CardBitmapIndex that the set was generated from
+	property CardBitmapIndex^ Index
+	{
+		CardBitmapIndex^ get(void);
+	}
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// ValidateOperand
+	//
+	// Ensures that another set can be combined with this set
+	void ValidateOperand(CardBitmap^ rhs);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	CardBitmapIndex^			m_index;			// Owning CardBitmapIndex
+	roaringbitmap*				m_bitmap;			// Native set of card ordinals
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::ronin::data
+
+#pragma warning(pop)
+
+#endif	// __CARDBITMAP_H_
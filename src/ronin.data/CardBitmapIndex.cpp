@@ -0,0 +1,340 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "CardBitmapIndex.h"
+
+#include "MonsterCard.h"
+#include "SpellCard.h"
+#include "TrapCard.h"
+
+#pragma warning(push, 4)
+
+namespace zuki::ronin::data {
+
+//---------------------------------------------------------------------------
+// add_ordinal (local)
+//
+// Adds a card ordinal to the set associated with a key, creating the set
+//
+// Arguments:
+//
+//	index		- Owning CardBitmapIndex instance
+//	bitmaps		- Sets keyed on the attribute value
+//	key			- Attribute value of the card
+//	ordinal		- Card ordinal
+
+template<typename _key>
+static void add_ordinal(CardBitmapIndex^ index, Dictionary<_key, CardBitmap^>^ bitmaps, _key key, int ordinal)
+{
+	CardBitmap^ bitmap = nullptr;
+
+	if(!bitmaps->TryGetValue(key, bitmap)) {
+
+		bitmap = gcnew CardBitmap(index);
+		bitmaps->Add(key, bitmap);
+	}
+
+	bitmap->Add(ordinal);
+}
+
+//---------------------------------------------------------------------------
+// find_bitmap (local)
+//
+// Gets the set associated with a key, or an empty set if there is none
+//
+// Arguments:
+//
+//	index		- Owning CardBitmapIndex instance
+//	bitmaps		- Sets keyed on the attribute value
+//	key			- Attribute value to look up
+
+template<typename _key>
+static CardBitmap^ find_bitmap(CardBitmapIndex^ index, Dictionary<_key, CardBitmap^>^ bitmaps, _key key)
+{
+	CardBitmap^ bitmap = nullptr;
+	return (bitmaps->TryGetValue(key, bitmap)) ? bitmap : gcnew CardBitmap(index);
+}
+
+//---------------------------------------------------------------------------
+// CardBitmapIndex Constructor (internal)
+//
+// Arguments:
+//
+//	cards		- Enumerable collection of Cards to load into the index
+
+CardBitmapIndex::CardBitmapIndex(IEnumerable<Card^>^ cards)
+{
+	if(CLRISNULL(cards)) throw gcnew ArgumentNullException("cards");
+
+	m_cards = gcnew List<Card^>(cards);
+	m_ordinals = gcnew Dictionary<CardId^, int>(m_cards->Count);
+	m_all = gcnew CardBitmap(this);
+	m_rulings = gcnew CardBitmap(this);
+	m_attributes = gcnew Dictionary<CardAttribute, CardBitmap^>();
+	m_icons = gcnew Dictionary<CardIcon, CardBitmap^>();
+	m_types = gcnew Dictionary<CardType, CardBitmap^>();
+	m_kinds = gcnew Dictionary<MonsterKind, CardBitmap^>();
+	m_monstertypes = gcnew Dictionary<MonsterType, CardBitmap^>();
+	m_restrictions = gcnew Dictionary<RestrictionListId^, array<CardBitmap^>^>();
+
+	for(int ordinal = 0; ordinal < m_cards->Count; ordinal++) {
+
+		Card^ card = m_cards[ordinal];
+
+		m_ordinals->Add(card->CardID, ordinal);
+		m_all->Add(ordinal);
+		add_ordinal(this, m_types, card->Type, ordinal);
+
+		MonsterCard^ monster = dynamic_cast<MonsterCard^>(card);
+		if(CLRISNOTNULL(monster)) {
+
+			add_ordinal(this, m_attributes, monster->Attribute, ordinal);
+			add_ordinal(this, m_monstertypes, monster->Type, ordinal);
+
+			if(monster->Normal) add_ordinal(this, m_kinds, MonsterKind::Normal, ordinal);
+			if(monster->Effect) add_ordinal(this, m_kinds, MonsterKind::Effect, ordinal);
+			if(monster->Fusion) add_ordinal(this, m_kinds, MonsterKind::Fusion, ordinal);
+			if(monster->Ritual) add_ordinal(this, m_kinds, MonsterKind::Ritual, ordinal);
+			if(monster->Toon) add_ordinal(this, m_kinds, MonsterKind::Toon, ordinal);
+			if(monster->Union) add_ordinal(this, m_kinds, MonsterKind::Union, ordinal);
+			if(monster->Spirit) add_ordinal(this, m_kinds, MonsterKind::Spirit, ordinal);
+			if(monster->Gemini) add_ordinal(this, m_kinds, MonsterKind::Gemini, ordinal);
+		}
+
+		SpellCard^ spell = dynamic_cast<SpellCard^>(card);
+		if(CLRISNOTNULL(spell)) add_ordinal(this, m_icons, spell->Icon, ordinal);
+
+		TrapCard^ trap = dynamic_cast<TrapCard^>(card);
+		if(CLRISNOTNULL(trap)) add_ordinal(this, m_icons, trap->Icon, ordinal);
+	}
+}
+
+//---------------------------------------------------------------------------
+// CardBitmapIndex::AddRestriction (internal)
+//
+// Adds the restriction of a card on a restriction list to the index
+//
+// Arguments:
+//
+//	restrictionlistid	- Restriction list identifier
+//	cardid				- Card identifier
+//	restriction			- Restriction of the card on the list
+
+void CardBitmapIndex::AddRestriction(RestrictionListId^ restrictionlistid, CardId^ cardid, Restriction restriction)
+{
+	CLRASSERT(CLRISNOTNULL(restrictionlistid));
+	CLRASSERT(CLRISNOTNULL(cardid));
+
+	// Unlimited cards are not stored; they are everything not otherwise restricted
+	if((restriction < Restriction::Forbidden) || (restriction >= Restriction::Unlimited)) return;
+
+	int ordinal = 0;
+	if(!m_ordinals->TryGetValue(cardid, ordinal)) return;
+
+	array<CardBitmap^>^ bitmaps = nullptr;
+	if(!m_restrictions->TryGetValue(restrictionlistid, bitmaps)) {
+
+		bitmaps = gcnew array<CardBitmap^>(static_cast<int>(Restriction::Unlimited));
+		for(int index = 0; index < bitmaps->Length; index++) bitmaps[index] = gcnew CardBitmap(this);
+
+		m_restrictions->Add(restrictionlistid, bitmaps);
+	}
+
+	bitmaps[static_cast<int>(restriction)]->Add(ordinal);
+}
+
+//---------------------------------------------------------------------------
+// CardBitmapIndex::AddRuling (internal)
+//
+// Adds a card that has a ruling to the index
+//
+// Arguments:
+//
+//	cardid		- Card identifier
+
+void CardBitmapIndex::AddRuling(CardId^ cardid)
+{
+	CLRASSERT(CLRISNOTNULL(cardid));
+
+	int ordinal = 0;
+	if(m_ordinals->TryGetValue(cardid, ordinal)) m_rulings->Add(ordinal);
+}
+
+//---------------------------------------------------------------------------
+// CardBitmapIndex::All::get
+//
+// Gets the set of all Cards in the index
+
+CardBitmap^ CardBitmapIndex::All::get(void)
+{
+	return m_all;
+}
+
+//---------------------------------------------------------------------------
+// CardBitmapIndex::Count::get
+//
+// Gets the number of Cards in the index
+
+int CardBitmapIndex::Count::get(void)
+{
+	return m_cards->Count;
+}
+
+//---------------------------------------------------------------------------
+// CardBitmapIndex::Get
+//
+// Gets the set of Cards that have an attribute value
+//
+// Arguments:
+//
+//	attribute	- Monster attribute
+
+CardBitmap^ CardBitmapIndex::Get(CardAttribute attribute)
+{
+	return find_bitmap(this, m_attributes, attribute);
+}
+
+//---------------------------------------------------------------------------
+// CardBitmapIndex::Get
+//
+// Gets the set of Cards that have an attribute value
+//
+// Arguments:
+//
+//	icon		- Spell or trap icon
+
+CardBitmap^ CardBitmapIndex::Get(CardIcon icon)
+{
+	return find_bitmap(this, m_icons, icon);
+}
+
+//---------------------------------------------------------------------------
+// CardBitmapIndex::Get
+//
+// Gets the set of Cards that have an attribute value
+//
+// Arguments:
+//
+//	type		- Card type
+
+CardBitmap^ CardBitmapIndex::Get(CardType type)
+{
+	return find_bitmap(this, m_types, type);
+}
+
+//---------------------------------------------------------------------------
+// CardBitmapIndex::Get
+//
+// Gets the set of Cards that have an attribute value
+//
+// Arguments:
+//
+//	kind		- Monster kind
+
+CardBitmap^ CardBitmapIndex::Get(MonsterKind kind)
+{
+	return find_bitmap(this, m_kinds, kind);
+}
+
+//---------------------------------------------------------------------------
+// CardBitmapIndex::Get
+//
+// Gets the set of Cards that have an attribute value
+//
+// Arguments:
+//
+//	type		- Monster type
+
+CardBitmap^ CardBitmapIndex::Get(MonsterType type)
+{
+	return find_bitmap(this, m_monstertypes, type);
+}
+
+//---------------------------------------------------------------------------
+// CardBitmapIndex::Get
+//
+// Gets the set of Cards that have an attribute value
+//
+// Arguments:
+//
+//	restrictionlist	- Restriction list
+//	restriction		- Restriction of the cards on the list
+
+CardBitmap^ CardBitmapIndex::Get(RestrictionList^ restrictionlist, Restriction restriction)
+{
+	if(CLRISNULL(restrictionlist)) throw gcnew ArgumentNullException("restrictionlist");
+
+	array<CardBitmap^>^ bitmaps = nullptr;
+	bool found = m_restrictions->TryGetValue(restrictionlist->RestrictionListID, bitmaps);
+
+	// Unlimited cards are those that are not Forbidden, Limited or Semi-Limited
+	if(restriction == Restriction::Unlimited) {
+
+		if(!found) return m_all;
+		return m_all->AndNot(bitmaps[static_cast<int>(Restriction::Forbidden)]->Or(bitmaps[static_cast<int>(Restriction::Limited)])
+			->Or(bitmaps[static_cast<int>(Restriction::SemiLimited)]));
+	}
+
+	if((!found) || (restriction < Restriction::Forbidden) || (restriction > Restriction::Unlimited)) return gcnew CardBitmap(this);
+	return bitmaps[static_cast<int>(restriction)];
+}
+
+//---------------------------------------------------------------------------
+// CardBitmapIndex::Select
+//
+// Gets the Cards in a set
+//
+// Arguments:
+//
+//	bitmap		- Set of Cards generated from this index
+
+List<Card^>^ CardBitmapIndex::Select(CardBitmap^ bitmap)
+{
+	if(CLRISNULL(bitmap)) throw gcnew ArgumentNullException("bitmap");
+	if(!Object::ReferenceEquals(bitmap->Index, this)) throw gcnew ArgumentException("CardBitmap was generated from a different CardBitmapIndex", "bitmap");
+
+	std::vector<uint32_t> ordinals;
+	bitmap->GetOrdinals(ordinals);
+
+	// Ordinals are assigned in name order, as are the returned Cards
+	List<Card^>^ cards = gcnew List<Card^>(static_cast<int>(ordinals.size()));
+	for(uint32_t ordinal : ordinals) cards->Add(m_cards[static_cast<int>(ordinal)]);
+
+	return cards;
+}
+
+//---------------------------------------------------------------------------
+// CardBitmapIndex::WithRulings::get
+//
+// Gets the set of Cards that have at least one ruling
+
+CardBitmap^ CardBitmapIndex::WithRulings::get(void)
+{
+	return m_rulings;
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::ronin::data
+
+#pragma warning(pop)
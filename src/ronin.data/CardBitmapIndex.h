@@ -0,0 +1,148 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __CARDBITMAPINDEX_H_
+#define __CARDBITMAPINDEX_H_
+#pragma once
+
+#include "Card.h"
+#include "CardAttribute.h"
+#include "CardBitmap.h"
+#include "CardIcon.h"
+#include "CardId.h"
+#include "CardType.h"
+#include "MonsterKind.h"
+#include "MonsterType.h"
+#include "Restriction.h"
+#include "RestrictionList.h"
+#include "RestrictionListId.h"
+
+#pragma warning(push, 4)
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+namespace zuki::ronin::data {
+
+//---------------------------------------------------------------------------
+// Class CardBitmapIndex
+//
+// In-memory bitmap index of card attribute sets. Each card is assigned a dense
+// ordinal in name order and every indexed attribute value is a compressed set
+// of those ordinals. Changes made to the database after the index has been
+// loaded are not reflected in the index
+//---------------------------------------------------------------------------
+
+public ref class CardBitmapIndex
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Get
+	//
+	// Gets the set of Cards that have an attribute value
+	CardBitmap^ Get(CardAttribute attribute);
+	CardBitmap^ Get(CardIcon icon);
+	CardBitmap^ Get(CardType type);
+	CardBitmap^ Get(MonsterKind kind);
+	CardBitmap^ Get(MonsterType type);
+	CardBitmap^ Get(RestrictionList^ restrictionlist, Restriction restriction);
+
+	// Select
+	//
+	// Gets the Cards in a set
+	List<Card^>^ Select(CardBitmap^ bitmap);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// All
+	//
+	// Gets the set of all Cards in the index
+	property CardBitmap^ All
+	{
+		CardBitmap^ get(void);
+	}
+
+	// Count
+	//
+	// Gets the number of Cards in the index
+	property int Count
+	{
+		int get(void);
+	}
+
+	// WithRulings
+	//
+	// Gets the set of Cards that have at least one ruling
+	property CardBitmap^ WithRulings
+	{
+		CardBitmap^ get(void);
+	}
+
+internal:
+
+	// Instance Constructor
+	//
+	CardBitmapIndex(IEnumerable<Card^>^ cards);
+
+	//-----------------------------------------------------------------------
+	// Internal Member Functions
+
+	// AddRestriction
+	//
+	// Adds the restriction of a card on a restriction list to the index
+	void AddRestriction(RestrictionListId^ restrictionlistid, CardId^ cardid, Restriction restriction);
+
+	// AddRuling
+	//
+	// Adds a card that has a ruling to the index
+	void AddRuling(CardId^ cardid);
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	List<Card^>^								m_cards;			// Cards by ordinal
+	Dictionary<CardId^, int>^					m_ordinals;			// Ordinals by CardId
+	CardBitmap^									m_all;				// All cards
+	CardBitmap^									m_rulings;			// Cards with rulings
+	Dictionary<CardAttribute, CardBitmap^>^		m_attributes;		// Cards by attribute
+	Dictionary<CardIcon, CardBitmap^>^			m_icons;			// Cards by icon
+	Dictionary<CardType, CardBitmap^>^			m_types;			// Cards by type
+	Dictionary<MonsterKind, CardBitmap^>^		m_kinds;			// Cards by monster kind
+	Dictionary<MonsterType, CardBitmap^>^		m_monstertypes;		// Cards by monster type
+
+	// Forbidden, Limited and Semi-Limited cards by restriction list
+	Dictionary<RestrictionListId^, array<CardBitmap^>^>^	m_restrictions;
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::ronin::data
+
+#pragma warning(pop)
+
+#endif	// __CARDBITMAPINDEX_H_
@@ -0,0 +1,244 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "CardCatalog.h"
+
+#include "MonsterCard.h"
+#include "SpellCard.h"
+#include "TrapCard.h"
+
+#pragma warning(push, 4)
+
+namespace zuki::ronin::data {
+
+//---------------------------------------------------------------------------
+// set_range (local)
+//
+// Activates a column range in a native filter from optional bounds
+//
+// Arguments:
+//
+//	filter		- Native filter instance
+//	column		- Column to be filtered
+//	minimum		- Optional minimum column value
+//	maximum		- Optional maximum column value
+
+static void set_range(cardcolumns::filter_t& filter, cardcolumns::column_t column, Nullable<int> minimum, Nullable<int> maximum)
+{
+	if(!minimum.HasValue && !maximum.HasValue) return;
+
+	filter.active[column] = true;
+	if(minimum.HasValue) filter.minimum[column] = minimum.Value;
+	if(maximum.HasValue) filter.maximum[column] = maximum.Value;
+}
+
+//---------------------------------------------------------------------------
+// to_day (local)
+//
+// Converts a DateTime into a day number column value
+//
+// Arguments:
+//
+//	date		- DateTime to be converted
+
+static int32_t to_day(DateTime date)
+{
+	return (date == DateTime::MinValue) ? CARDCOLUMNS_NULL : static_cast<int32_t>(date.Ticks / TimeSpan::TicksPerDay);
+}
+
+//---------------------------------------------------------------------------
+// CardCatalog Constructor (internal)
+//
+// Arguments:
+//
+//	cards		- Enumerable collection of Cards to load into the catalog
+
+CardCatalog::CardCatalog(IEnumerable<Card^>^ cards)
+{
+	if(CLRISNULL(cards)) throw gcnew ArgumentNullException("cards");
+
+	m_cards = gcnew List<Card^>(cards);
+	m_columns = new cardcolumns(static_cast<size_t>(m_cards->Count));
+
+	try {
+
+		for each(Card^ card in m_cards) {
+
+			int32_t values[cardcolumns::columncount];
+			uint32_t flags = 0;
+
+			// Columns that do not apply to the card type are null
+			for(auto& value : values) value = CARDCOLUMNS_NULL;
+
+			values[cardcolumns::type] = static_cast<int32_t>(card->Type);
+			values[cardcolumns::releaseday] = to_day(card->ReleaseDate);
+
+			MonsterCard^ monster = dynamic_cast<MonsterCard^>(card);
+			if(CLRISNOTNULL(monster)) {
+
+				values[cardcolumns::attribute] = static_cast<int32_t>(monster->Attribute);
+				values[cardcolumns::monstertype] = static_cast<int32_t>(monster->Type);
+				values[cardcolumns::level] = monster->Level;
+				values[cardcolumns::attack] = monster->Attack;
+				values[cardcolumns::defense] = monster->Defense;
+
+				if(monster->Normal) flags |= CARDFLAG_MONSTERNORMAL;
+				if(monster->Effect) flags |= CARDFLAG_MONSTEREFFECT;
+				if(monster->Fusion) flags |= CARDFLAG_MONSTERFUSION;
+				if(monster->Ritual) flags |= CARDFLAG_MONSTERRITUAL;
+				if(monster->Toon) flags |= CARDFLAG_MONSTERTOON;
+				if(monster->Union) flags |= CARDFLAG_MONSTERUNION;
+				if(monster->Spirit) flags |= CARDFLAG_MONSTERSPIRIT;
+				if(monster->Gemini) flags |= CARDFLAG_MONSTERGEMINI;
+			}
+
+			SpellCard^ spell = dynamic_cast<SpellCard^>(card);
+			if(CLRISNOTNULL(spell)) {
+
+				if(spell->Normal) flags |= CARDFLAG_SPELLNORMAL;
+				if(spell->Continuous) flags |= CARDFLAG_SPELLCONTINUOUS;
+				if(spell->Equip) flags |= CARDFLAG_SPELLEQUIP;
+				if(spell->Field) flags |= CARDFLAG_SPELLFIELD;
+				if(spell->QuickPlay) flags |= CARDFLAG_SPELLQUICKPLAY;
+				if(spell->Ritual) flags |= CARDFLAG_SPELLRITUAL;
+			}
+
+			TrapCard^ trap = dynamic_cast<TrapCard^>(card);
+			if(CLRISNOTNULL(trap)) {
+
+				if(trap->Normal) flags |= CARDFLAG_TRAPNORMAL;
+				if(trap->Continuous) flags |= CARDFLAG_TRAPCONTINUOUS;
+				if(trap->Counter) flags |= CARDFLAG_TRAPCOUNTER;
+			}
+
+			m_columns->append(values, flags);
+		}
+	}
+
+	catch(Exception^) { delete m_columns; m_columns = nullptr; throw; }
+}
+
+//---------------------------------------------------------------------------
+// CardCatalog Destructor
+
+CardCatalog::~CardCatalog()
+{
+	if(m_disposed) return;
+
+	this->!CardCatalog();
+	m_disposed = true;
+}
+
+//---------------------------------------------------------------------------
+// CardCatalog Finalizer
+
+CardCatalog::!CardCatalog()
+{
+	if(m_columns != nullptr) { delete m_columns; m_columns = nullptr; }
+}
+
+//---------------------------------------------------------------------------
+// CardCatalog::Count::get
+//
+// Gets the number of Cards in the catalog
+
+int CardCatalog::Count::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return m_cards->Count;
+}
+
+//---------------------------------------------------------------------------
+// CardCatalog::Query
+//
+// Selects the Cards that match a CardFilter from the catalog
+//
+// Arguments:
+//
+//	filter		- CardFilter describing the Cards to select
+
+List<Card^>^ CardCatalog::Query(CardFilter^ filter)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if(CLRISNULL(filter)) throw gcnew ArgumentNullException("filter");
+
+	// Restrictions are not part of the catalog, use Database::QueryCards instead
+	if(CLRISNOTNULL(filter->RestrictionList) || filter->Restriction.HasValue)
+		throw gcnew NotSupportedException("CardCatalog does not support filtering on restrictions");
+
+	cardcolumns::filter_t criteria;
+	cardcolumns::initialize(criteria);
+
+	// type | attribute | monstertype
+	if(filter->Type.HasValue) set_range(criteria, cardcolumns::type, static_cast<int>(filter->Type.Value), static_cast<int>(filter->Type.Value));
+	if(filter->Attribute.HasValue) 
+		set_range(criteria, cardcolumns::attribute, static_cast<int>(filter->Attribute.Value), static_cast<int>(filter->Attribute.Value));
+	if(filter->MonsterType.HasValue) 
+		set_range(criteria, cardcolumns::monstertype, static_cast<int>(filter->MonsterType.Value), static_cast<int>(filter->MonsterType.Value));
+
+	// level | attack | defense
+	set_range(criteria, cardcolumns::level, filter->MinimumLevel, filter->MaximumLevel);
+	set_range(criteria, cardcolumns::attack, filter->MinimumAttack, filter->MaximumAttack);
+	set_range(criteria, cardcolumns::defense, filter->MinimumDefense, filter->MaximumDefense);
+
+	// releaseday
+	if(filter->MinimumReleaseDate.HasValue || filter->MaximumReleaseDate.HasValue) {
+
+		criteria.active[cardcolumns::releaseday] = true;
+		if(filter->MinimumReleaseDate.HasValue) criteria.minimum[cardcolumns::releaseday] = to_day(filter->MinimumReleaseDate.Value.Date);
+		if(filter->MaximumReleaseDate.HasValue) criteria.maximum[cardcolumns::releaseday] = to_day(filter->MaximumReleaseDate.Value.Date);
+	}
+
+	// flags
+	if(filter->Icon.HasValue) {
+
+		switch(filter->Icon.Value) {
+
+			case CardIcon::None: criteria.anyflags = CARDFLAG_SPELLNORMAL | CARDFLAG_TRAPNORMAL; break;
+			case CardIcon::Continuous: criteria.anyflags = CARDFLAG_SPELLCONTINUOUS | CARDFLAG_TRAPCONTINUOUS; break;
+			case CardIcon::Counter: criteria.anyflags = CARDFLAG_TRAPCOUNTER; break;
+			case CardIcon::Equip: criteria.anyflags = CARDFLAG_SPELLEQUIP; break;
+			case CardIcon::Field: criteria.anyflags = CARDFLAG_SPELLFIELD; break;
+			case CardIcon::QuickPlay: criteria.anyflags = CARDFLAG_SPELLQUICKPLAY; break;
+			case CardIcon::Ritual: criteria.anyflags = CARDFLAG_SPELLRITUAL; break;
+			default: throw gcnew ArgumentOutOfRangeException("filter");
+		}
+	}
+
+	// Evaluate the filter against the native columns
+	std::vector<uint32_t> selection;
+	size_t count = m_columns->select(criteria, selection);
+
+	// Only the Card instances for the selected rows are returned
+	List<Card^>^ cards = gcnew List<Card^>(static_cast<int>(count));
+	for(size_t index = 0; index < count; index++) cards->Add(m_cards[static_cast<int>(selection[index])]);
+
+	return cards;
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::ronin::data
+
+#pragma warning(pop)
@@ -0,0 +1,99 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __CARDCATALOG_H_
+#define __CARDCATALOG_H_
+#pragma once
+
+#include "Card.h"
+#include "CardFilter.h"
+#include "cardcolumns.h"
+
+#pragma warning(push, 4)
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+namespace zuki::ronin::data {
+
+//---------------------------------------------------------------------------
+// Class CardCatalog
+//
+// In-memory columnar snapshot of the cards in a database that can be filtered
+// without accessing the database. Changes made to the database after the
+// catalog has been loaded are not reflected in the catalog
+//---------------------------------------------------------------------------
+
+public ref class CardCatalog
+{
+public:
+
+	// Destructor
+	//
+	~CardCatalog();
+
+	// Finalizer
+	//
+	!CardCatalog();
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Query
+	//
+	// Selects the Cards that match a CardFilter from the catalog
+	List<Card^>^ Query(CardFilter^ filter);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Count
+	//
+	// Gets the number of Cards in the catalog
+	property int Count
+	{
+		int get(void);
+	}
+
+internal:
+
+	// Instance Constructor
+	//
+	CardCatalog(IEnumerable<Card^>^ cards);
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	bool					m_disposed = false;		// Object disposal flag
+	cardcolumns*			m_columns = nullptr;	// Native column store
+	List<Card^>^			m_cards;				// Card instances by row
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::ronin::data
+
+#pragma warning(pop)
+
+#endif	// __CARDCATALOG_H_
@@ -0,0 +1,325 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "CardFilter.h"
+
+#pragma warning(push, 4)
+
+namespace zuki::ronin::data {
+
+//---------------------------------------------------------------------------
+// CardFilter Constructor
+//
+// Arguments:
+//
+//	NONE
+
+CardFilter::CardFilter()
+{
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::Attribute::get
+//
+// Gets the monster attribute to filter on
+
+Nullable<CardAttribute> CardFilter::Attribute::get(void)
+{
+	return m_attribute;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::Attribute::set
+//
+// Sets the monster attribute to filter on
+
+void CardFilter::Attribute::set(Nullable<CardAttribute> value)
+{
+	m_attribute = value;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::Icon::get
+//
+// Gets the spell or trap icon to filter on
+
+Nullable<CardIcon> CardFilter::Icon::get(void)
+{
+	return m_icon;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::Icon::set
+//
+// Sets the spell or trap icon to filter on
+
+void CardFilter::Icon::set(Nullable<CardIcon> value)
+{
+	m_icon = value;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::MaximumAttack::get
+//
+// Gets the maximum monster attack value to filter on
+
+Nullable<int> CardFilter::MaximumAttack::get(void)
+{
+	return m_maxattack;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::MaximumAttack::set
+//
+// Sets the maximum monster attack value to filter on
+
+void CardFilter::MaximumAttack::set(Nullable<int> value)
+{
+	m_maxattack = value;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::MaximumDefense::get
+//
+// Gets the maximum monster defense value to filter on
+
+Nullable<int> CardFilter::MaximumDefense::get(void)
+{
+	return m_maxdefense;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::MaximumDefense::set
+//
+// Sets the maximum monster defense value to filter on
+
+void CardFilter::MaximumDefense::set(Nullable<int> value)
+{
+	m_maxdefense = value;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::MaximumLevel::get
+//
+// Gets the maximum monster level to filter on
+
+Nullable<int> CardFilter::MaximumLevel::get(void)
+{
+	return m_maxlevel;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::MaximumLevel::set
+//
+// Sets the maximum monster level to filter on
+
+void CardFilter::MaximumLevel::set(Nullable<int> value)
+{
+	m_maxlevel = value;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::MaximumReleaseDate::get
+//
+// Gets the latest release date to filter on
+
+Nullable<DateTime> CardFilter::MaximumReleaseDate::get(void)
+{
+	return m_maxreleasedate;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::MaximumReleaseDate::set
+//
+// Sets the latest release date to filter on
+
+void CardFilter::MaximumReleaseDate::set(Nullable<DateTime> value)
+{
+	m_maxreleasedate = value;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::MinimumAttack::get
+//
+// Gets the minimum monster attack value to filter on
+
+Nullable<int> CardFilter::MinimumAttack::get(void)
+{
+	return m_minattack;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::MinimumAttack::set
+//
+// Sets the minimum monster attack value to filter on
+
+void CardFilter::MinimumAttack::set(Nullable<int> value)
+{
+	m_minattack = value;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::MinimumDefense::get
+//
+// Gets the minimum monster defense value to filter on
+
+Nullable<int> CardFilter::MinimumDefense::get(void)
+{
+	return m_mindefense;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::MinimumDefense::set
+//
+// Sets the minimum monster defense value to filter on
+
+void CardFilter::MinimumDefense::set(Nullable<int> value)
+{
+	m_mindefense = value;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::MinimumLevel::get
+//
+// Gets the minimum monster level to filter on
+
+Nullable<int> CardFilter::MinimumLevel::get(void)
+{
+	return m_minlevel;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::MinimumLevel::set
+//
+// Sets the minimum monster level to filter on
+
+void CardFilter::MinimumLevel::set(Nullable<int> value)
+{
+	m_minlevel = value;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::MinimumReleaseDate::get
+//
+// Gets the earliest release date to filter on
+
+Nullable<DateTime> CardFilter::MinimumReleaseDate::get(void)
+{
+	return m_minreleasedate;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::MinimumReleaseDate::set
+//
+// Sets the earliest release date to filter on
+
+void CardFilter::MinimumReleaseDate::set(Nullable<DateTime> value)
+{
+	m_minreleasedate = value;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::MonsterType::get
+//
+// Gets the monster type to filter on
+
+Nullable<zuki::ronin::data::MonsterType> CardFilter::MonsterType::get(void)
+{
+	return m_monstertype;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::MonsterType::set
+//
+// Sets the monster type to filter on
+
+void CardFilter::MonsterType::set(Nullable<zuki::ronin::data::MonsterType> value)
+{
+	m_monstertype = value;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::Restriction::get
+//
+// Gets the restriction to filter on
+
+Nullable<zuki::ronin::data::Restriction> CardFilter::Restriction::get(void)
+{
+	return m_restriction;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::Restriction::set
+//
+// Sets the restriction to filter on
+
+void CardFilter::Restriction::set(Nullable<zuki::ronin::data::Restriction> value)
+{
+	m_restriction = value;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::RestrictionList::get
+//
+// Gets the restriction list to filter on
+
+zuki::ronin::data::RestrictionList^ CardFilter::RestrictionList::get(void)
+{
+	return m_restrictionlist;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::RestrictionList::set
+//
+// Sets the restriction list to filter on
+
+void CardFilter::RestrictionList::set(zuki::ronin::data::RestrictionList^ value)
+{
+	m_restrictionlist = value;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::Type::get
+//
+// Gets the card type to filter on
+
+Nullable<CardType> CardFilter::Type::get(void)
+{
+	return m_type;
+}
+
+//---------------------------------------------------------------------------
+// CardFilter::Type::set
+//
+// Sets the card type to filter on
+
+void CardFilter::Type::set(Nullable<CardType> value)
+{
+	m_type = value;
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::ronin::data
+
+#pragma warning(pop)
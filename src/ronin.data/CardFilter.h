@@ -0,0 +1,211 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __CARDFILTER_H_
+#define __CARDFILTER_H_
+#pragma once
+
+#include "CardAttribute.h"
+#include "CardIcon.h"
+#include "CardType.h"
+#include "MonsterType.h"
+#include "Restriction.h"
+#include "RestrictionList.h"
+
+#pragma warning(push, 4)
+
+using namespace System;
+
+namespace zuki::ronin::data {
+
+//---------------------------------------------------------------------------
+// Class CardFilter
+//
+// Describes the criteria used to select Cards with Database::QueryCards; any
+// criteria that have not been set do not participate in the filter
+//---------------------------------------------------------------------------
+
+public ref class CardFilter
+{
+public:
+
+	// Instance Constructor
+	//
+	CardFilter();
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Attribute
+	//
+	// Gets/sets the monster attribute to filter on
+	property Nullable<CardAttribute> Attribute
+	{
+		Nullable<CardAttribute> get(void);
+		void set(Nullable<CardAttribute> value);
+	}
+
+	// Icon
+	//
+	// Gets/sets the spell or trap icon to filter on; CardIcon::None selects normal spells and traps
+	property Nullable<CardIcon> Icon
+	{
+		Nullable<CardIcon> get(void);
+		void set(Nullable<CardIcon> value);
+	}
+
+	// MaximumAttack
+	//
+	// Gets/sets the maximum monster attack value to filter on
+	property Nullable<int> MaximumAttack
+	{
+		Nullable<int> get(void);
+		void set(Nullable<int> value);
+	}
+
+	// MaximumDefense
+	//
+	// Gets/sets the maximum monster defense value to filter on
+	property Nullable<int> MaximumDefense
+	{
+		Nullable<int> get(void);
+		void set(Nullable<int> value);
+	}
+
+	// MaximumLevel
+	//
+	// Gets/sets the maximum monster level to filter on
+	property Nullable<int> MaximumLevel
+	{
+		Nullable<int> get(void);
+		void set(Nullable<int> value);
+	}
+
+	// MaximumReleaseDate
+	//
+	// Gets/sets the latest release date to filter on
+	property Nullable<DateTime> MaximumReleaseDate
+	{
+		Nullable<DateTime> get(void);
+		void set(Nullable<DateTime> value);
+	}
+
+	// MinimumAttack
+	//
+	// Gets/sets the minimum monster attack value to filter on
+	property Nullable<int> MinimumAttack
+	{
+		Nullable<int> get(void);
+		void set(Nullable<int> value);
+	}
+
+	// MinimumDefense
+	//
+	// Gets/sets the minimum monster defense value to filter on
+	property Nullable<int> MinimumDefense
+	{
+		Nullable<int> get(void);
+		void set(Nullable<int> value);
+	}
+
+	// MinimumLevel
+	//
+	// Gets/sets the minimum monster level to filter on
+	property Nullable<int> MinimumLevel
+	{
+		Nullable<int> get(void);
+		void set(Nullable<int> value);
+	}
+
+	// MinimumReleaseDate
+	//
+	// Gets/sets the earliest release date to filter on
+	property Nullable<DateTime> MinimumReleaseDate
+	{
+		Nullable<DateTime> get(void);
+		void set(Nullable<DateTime> value);
+	}
+
+	// MonsterType
+	//
+	// Gets/sets the monster type to filter on
+	property Nullable<zuki::ronin::data::MonsterType> MonsterType
+	{
+		Nullable<zuki::ronin::data::MonsterType> get(void);
+		void set(Nullable<zuki::ronin::data::MonsterType> value);
+	}
+
+	// Restriction
+	//
+	// Gets/sets the restriction to filter on; requires RestrictionList
+	property Nullable<zuki::ronin::data::Restriction> Restriction
+	{
+		Nullable<zuki::ronin::data::Restriction> get(void);
+		void set(Nullable<zuki::ronin::data::Restriction> value);
+	}
+
+	// RestrictionList
+	//
+	// Gets/sets the restriction list to filter on
+	property zuki::ronin::data::RestrictionList^ RestrictionList
+	{
+		zuki::ronin::data::RestrictionList^ get(void);
+		void set(zuki::ronin::data::RestrictionList^ value);
+	}
+
+	// Type
+	//
+	// Gets/sets the card type to filter on
+	property Nullable<CardType> Type
+	{
+		Nullable<CardType> get(void);
+		void set(Nullable<CardType> value);
+	}
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	Nullable<CardAttribute>						m_attribute;		// Monster attribute
+	Nullable<CardIcon>							m_icon;				// Spell/trap icon
+	Nullable<int>								m_maxattack;		// Maximum monster attack
+	Nullable<int>								m_maxdefense;		// Maximum monster defense
+	Nullable<int>								m_maxlevel;			// Maximum monster level
+	Nullable<DateTime>							m_maxreleasedate;	// Latest release date
+	Nullable<int>								m_minattack;		// Minimum monster attack
+	Nullable<int>								m_mindefense;		// Minimum monster defense
+	Nullable<int>								m_minlevel;			// Minimum monster level
+	Nullable<DateTime>							m_minreleasedate;	// Earliest release date
+	Nullable<zuki::ronin::data::MonsterType>	m_monstertype;		// Monster type
+	Nullable<zuki::ronin::data::Restriction>	m_restriction;		// Restriction
+	zuki::ronin::data::RestrictionList^			m_restrictionlist;	// Restriction list
+	Nullable<CardType>							m_type;				// Card type
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::ronin::data
+
+#pragma warning(pop)
+
+#endif	// __CARDFILTER_H_
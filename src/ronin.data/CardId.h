@@ -42,9 +42,10 @@ ref class CardId : public Uuid
 {
 public:
 
-	// Instance Constructor
+	// Instance Constructors
 	//
 	CardId(Guid uuid) : Uuid(uuid) {}
+	CardId(uuidkey_t const& key) : Uuid(key) {}
 };
 
 //---------------------------------------------------------------------------
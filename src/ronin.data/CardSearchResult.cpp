@@ -0,0 +1,94 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "CardSearchResult.h"
+
+#pragma warning(push, 4)
+
+namespace zuki::ronin::data {
+
+//---------------------------------------------------------------------------
+// CardSearchResult Constructor (internal)
+//
+// Arguments:
+//
+//	card		- Card that matched the search
+//	snippet		- Highlighted fragment of the matching text
+//	rank		- Relevance rank of the result
+
+CardSearchResult::CardSearchResult(zuki::ronin::data::Card^ card, String^ snippet, double rank) :
+	m_card(card), m_snippet(snippet), m_rank(rank)
+{
+	if(CLRISNULL(card)) throw gcnew ArgumentNullException("card");
+	if(CLRISNULL(m_snippet)) m_snippet = String::Empty;
+}
+
+//---------------------------------------------------------------------------
+// CardSearchResult::Card::get
+//
+// Gets the Card that matched the search
+
+zuki::ronin::data::Card^ CardSearchResult::Card::get(void)
+{
+	return m_card;
+}
+
+//---------------------------------------------------------------------------
+// CardSearchResult::Rank::get
+//
+// Gets the relevance rank of the result; lower values are more relevant
+
+double CardSearchResult::Rank::get(void)
+{
+	return m_rank;
+}
+
+//---------------------------------------------------------------------------
+// CardSearchResult::Snippet::get
+//
+// Gets the fragment of the matching text with the search terms highlighted
+
+String^ CardSearchResult::Snippet::get(void)
+{
+	return m_snippet;
+}
+
+//---------------------------------------------------------------------------
+// CardSearchResult::ToString
+//
+// Overrides Object::ToString()
+//
+// Arguments:
+//
+//	NONE
+
+String^ CardSearchResult::ToString(void)
+{
+	return m_card->ToString();
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::ronin::data
+
+#pragma warning(pop)
@@ -0,0 +1,102 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __CARDSEARCHRESULT_H_
+#define __CARDSEARCHRESULT_H_
+#pragma once
+
+#include "Card.h"
+
+#pragma warning(push, 4)
+
+using namespace System;
+
+namespace zuki::ronin::data {
+
+//---------------------------------------------------------------------------
+// Class CardSearchResult
+//
+// Describes a single ranked result from a full-text card search
+//---------------------------------------------------------------------------
+
+public ref class CardSearchResult
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// ToString
+	//
+	// Overrides Object::ToString()
+	virtual String^ ToString(void) override;
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Card
+	//
+	// Gets the Card that matched the search
+	property zuki::ronin::data::Card^ Card
+	{
+		zuki::ronin::data::Card^ get(void);
+	}
+
+	// Rank
+	//
+	// Gets the relevance rank of the result; lower values are more relevant
+	property double Rank
+	{
+		double get(void);
+	}
+
+	// Snippet
+	//
+	// Gets the fragment of the matching text with the search terms highlighted
+	property String^ Snippet
+	{
+		String^ get(void);
+	}
+
+internal:
+
+	// Instance Constructor
+	//
+	CardSearchResult(zuki::ronin::data::Card^ card, String^ snippet, double rank);
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	initonly zuki::ronin::data::Card^	m_card;			// Matching Card
+	initonly String^					m_snippet;		// Highlighted snippet
+	initonly double						m_rank;			// Relevance rank
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::ronin::data
+
+#pragma warning(pop)
+
+#endif	// __CARDSEARCHRESULT_H_
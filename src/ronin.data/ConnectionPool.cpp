@@ -0,0 +1,630 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "ConnectionPool.h"
+
+#include "SQLiteException.h"
+
+#pragma warning(push, 4)
+
+using namespace System::IO;
+using namespace System::Threading;
+
+namespace zuki::ronin::data {
+
+//---------------------------------------------------------------------------
+// ConnectionPool Constructor
+//
+// Arguments:
+//
+//	writer		- SQLiteSafeHandle of the writer connection
+//	path		- Database file path or URI filename, or nullptr if readers cannot be opened
+//	readers		- Maximum number of read-only connections
+//	immutable	- Flag to open read-only connections as immutable
+
+ConnectionPool::ConnectionPool(SQLiteSafeHandle^ writer, String^ path, int readers, bool immutable) : 
+	m_lock(gcnew Object()), m_immutable(immutable)
+{
+	if(CLRISNULL(writer)) throw gcnew ArgumentNullException("writer");
+	if(readers < 0) throw gcnew ArgumentOutOfRangeException("readers");
+
+	m_path = (CLRISNULL(path) || IsUri(path)) ? path : Path::GetFullPath(path);
+	m_maxreaders = (CLRISNULL(m_path)) ? 0 : readers;
+
+	m_writer = gcnew Connection(writer);
+	m_writegate = gcnew SemaphoreSlim(1, 1);
+	m_readers = gcnew List<Connection^>();
+	m_idle = gcnew Stack<Connection^>();
+	m_threads = gcnew Dictionary<int, Connection^>();
+}
+
+//---------------------------------------------------------------------------
+// ConnectionPool Destructor
+
+ConnectionPool::~ConnectionPool()
+{
+	if(m_disposed) return;
+
+	msclr::lock lock(m_lock);
+
+	// Close all of the idle read-only connections; connections that are still
+	// leased will be closed when they are released back into the pool
+	while(m_idle->Count > 0) CloseConnection(m_idle->Pop());
+
+	// The writer connection handle is owned by the caller, only the
+	// statement cache is released here
+	delete m_writer->Statements;
+
+	m_disposed = true;
+
+	// Wake any threads waiting on a read-only connection
+	Monitor::PulseAll(m_lock);
+}
+
+//---------------------------------------------------------------------------
+// ConnectionPool::AcquireConnection (private)
+//
+// Acquires a connection from the pool
+//
+// Arguments:
+//
+//	mode		- Lease mode
+
+ConnectionPool::Connection^ ConnectionPool::AcquireConnection(LeaseMode mode)
+{
+	Connection^ connection = nullptr;
+
+	CHECK_DISPOSED(m_disposed);
+
+	// A detached lease may be released from a different thread and can never share the
+	// writer connection; SQLite connections cannot be used by two threads at once
+	if((mode == LeaseMode::Detached) && CLRISNULL(m_path))
+		throw gcnew InvalidOperationException("A detached lease requires a read-only connection");
+
+	int threadid = Thread::CurrentThread->ManagedThreadId;
+
+	// The writer is used for write and read leases when there are no read-only connections,
+	// or when the thread already holds the writer so uncommitted changes are visible
+	if((mode == LeaseMode::Write) || ((mode == LeaseMode::Read) && ((m_maxreaders == 0) || (m_writer->Owner == threadid))))
+		return AcquireWriter();
+
+	msclr::lock lock(m_lock);
+
+	// Nested read leases on the same thread share the same connection
+	if((mode == LeaseMode::Read) && m_threads->TryGetValue(threadid, connection)) {
+
+		connection->LeaseCount++;
+		return connection;
+	}
+
+	// Read leases wait for an idle connection when the pool is at capacity,
+	// detached leases are allowed to exceed the limit to prevent a deadlock
+	// with a thread that holds a read lease while opening a detached one; this
+	// includes a pool that is limited to no read-only connections at all
+	if(mode == LeaseMode::Read) {
+
+		while((m_idle->Count == 0) && (m_readers->Count >= m_maxreaders)) {
+
+			Monitor::Wait(m_lock);
+			CHECK_DISPOSED(m_disposed);
+		}
+	}
+
+	connection = (m_idle->Count > 0) ? m_idle->Pop() : OpenConnection();
+	connection->Owner = (mode == LeaseMode::Read) ? threadid : 0;
+	connection->LeaseCount = 1;
+
+	if(mode == LeaseMode::Read) m_threads->Add(threadid, connection);
+
+	return connection;
+}
+
+//---------------------------------------------------------------------------
+// ConnectionPool::AcquireWriter (private)
+//
+// Acquires the writer connection
+//
+// Arguments:
+//
+//	NONE
+
+ConnectionPool::Connection^ ConnectionPool::AcquireWriter(void)
+{
+	int threadid = Thread::CurrentThread->ManagedThreadId;
+
+	// Nested leases on the thread that holds the writer share it; the owner is checked
+	// under the lock since an abandoned writer can be reclaimed by another thread
+	{
+		msclr::lock lock(m_lock);
+
+		if(m_writer->Owner == threadid) {
+
+			m_writer->LeaseCount++;
+			return m_writer;
+		}
+	}
+
+	// Wait for the writer gate; a writer held by a lease that has been abandoned is
+	// rolled back and released by the threads waiting for it
+	while(!m_writegate->Wait(WRITER_RECLAIM_INTERVAL)) {
+
+		CHECK_DISPOSED(m_disposed);
+		ReclaimWriter();
+	}
+
+	msclr::lock lock(m_lock);
+
+	m_writer->Owner = threadid;
+	m_writer->LeaseCount = 1;
+
+	return m_writer;
+}
+
+//---------------------------------------------------------------------------
+// ConnectionPool::CloseConnection (private)
+//
+// Closes a read-only connection and removes it from the pool
+//
+// Arguments:
+//
+//	connection	- Connection to be closed
+
+void ConnectionPool::CloseConnection(Connection^ connection)
+{
+	CLRASSERT(CLRISNOTNULL(connection));
+	CLRASSERT(connection != m_writer);
+
+	m_readers->Remove(connection);
+
+	delete connection->Statements;		// Finalize all cached statements
+	delete connection->Handle;			// Release the safe handle
+}
+
+//---------------------------------------------------------------------------
+// ConnectionPool::IsUri (private, static)
+//
+// Determines if a database path is a SQLite URI filename
+//
+// Arguments:
+//
+//	path		- Database path
+
+bool ConnectionPool::IsUri(String^ path)
+{
+	CLRASSERT(CLRISNOTNULL(path));
+	return path->StartsWith("file:", StringComparison::OrdinalIgnoreCase);
+}
+
+//---------------------------------------------------------------------------
+// ConnectionPool::OpenConnection (private)
+//
+// Opens a new read-only connection and adds it to the pool
+//
+// Arguments:
+//
+//	NONE
+
+ConnectionPool::Connection^ ConnectionPool::OpenConnection(void)
+{
+	CLRASSERT(CLRISNOTNULL(m_path));
+
+	// The schema has already been initialized by the writer connection
+	Connection^ connection = gcnew Connection(OpenReadOnly(m_path, m_immutable));
+	m_readers->Add(connection);
+
+	return connection;
+}
+
+//---------------------------------------------------------------------------
+// ConnectionPool::OpenReadOnly (static)
+//
+// Opens a read-only connection against a database file
+//
+// Arguments:
+//
+//	path		- Database file path
+//	immutable	- Flag to open the database file as immutable
+
+SQLiteSafeHandle^ ConnectionPool::OpenReadOnly(String^ path, bool immutable)
+{
+	sqlite3* instance = nullptr;
+
+	if(CLRISNULL(path)) throw gcnew ArgumentNullException("path");
+
+	// URI filenames, such as a named in-memory database, are passed to SQLite as-is
+	bool isuri = IsUri(path);
+	if(!isuri) path = Path::GetFullPath(path);
+
+	// Immutable databases are opened through a URI filename; SQLite assumes the file
+	// cannot change and performs no locking or change detection against it
+	if(immutable && !isuri) path = String::Concat((gcnew Uri(path))->AbsoluteUri, "?immutable=1");
+	isuri |= immutable;
+
+	// Create a marshaling context to convert the String^ into an ANSI C-style string
+	msclr::auto_handle<msclr::interop::marshal_context> context(gcnew msclr::interop::marshal_context());
+
+	// Attempt to open a read-only connection against the database file
+	int result = sqlite3_open_v2(context->marshal_as<char const*>(path), &instance, 
+		SQLITE_OPEN_READONLY | ((isuri) ? SQLITE_OPEN_URI : 0), nullptr);
+	if(result != SQLITE_OK) {
+
+		if(instance != nullptr) sqlite3_close(instance);
+		throw gcnew SQLiteException(result);
+	}
+
+	// Set the instance to report extended error codes
+	sqlite3_extended_result_codes(instance, TRUE);
+
+	// Set a busy timeout handler for this connection
+	sqlite3_busy_timeout(instance, 5000);
+
+	// Immutable databases are read through memory-mapped I/O (256MiB)
+	if(immutable) {
+
+		result = sqlite3_exec(instance, "pragma mmap_size=268435456", nullptr, nullptr, nullptr);
+		if(result != SQLITE_OK) {
+
+			SQLiteException^ exception = gcnew SQLiteException(result, sqlite3_errmsg(instance));
+			sqlite3_close(instance);
+			throw exception;
+		}
+	}
+
+	// Create the safe handle wrapper around the sqlite3*
+	SQLiteSafeHandle^ handle = gcnew SQLiteSafeHandle(std::move(instance));
+	CLRASSERT(instance == nullptr);
+
+	return handle;
+}
+
+//---------------------------------------------------------------------------
+// ConnectionPool::ReclaimWriter (private)
+//
+// Rolls back and releases the writer if its guarded lease has been abandoned
+//
+// Arguments:
+//
+//	NONE
+
+bool ConnectionPool::ReclaimWriter(void)
+{
+	Lease^ lease = nullptr;
+
+	{
+		msclr::lock lock(m_lock);
+
+		// The guarded lease is abandoned when its owner has been collected or has given it up
+		if(CLRISNULL(m_guardlease) || (CLRISNOTNULL(m_guardowner) && m_guardowner->IsAlive)) return false;
+
+		// The thread that held the writer may still be using it through other leases
+		if(m_writer->LeaseCount != 1) return false;
+
+		lease = m_guardlease;
+		m_guardlease = nullptr;
+		m_guardowner = nullptr;
+
+		// Nothing else can use the writer while the lock is held; undo any open transaction
+		sqlite3* instance = *lease;
+		if(sqlite3_get_autocommit(instance) == 0) sqlite3_exec(instance, "rollback transaction", nullptr, nullptr, nullptr);
+	}
+
+	delete lease;					// Releases the writer gate
+
+	return true;
+}
+
+//---------------------------------------------------------------------------
+// ConnectionPool::ReleaseConnection (private)
+//
+// Releases a connection back into the pool
+//
+// Arguments:
+//
+//	connection	- Connection to be released
+//	mode		- Lease mode the connection was acquired with
+
+void ConnectionPool::ReleaseConnection(Connection^ connection, LeaseMode mode)
+{
+	CLRASSERT(CLRISNOTNULL(connection));
+
+	msclr::lock lock(m_lock);
+
+	if(connection == m_writer) {
+
+		CLRASSERT(mode != LeaseMode::Detached);
+
+		if(--m_writer->LeaseCount > 0) return;
+
+		m_writer->Owner = 0;
+		m_writegate->Release();
+
+		return;
+	}
+
+	if(--connection->LeaseCount > 0) return;
+
+	if(mode == LeaseMode::Read) m_threads->Remove(connection->Owner);
+	connection->Owner = 0;
+
+	// Close the connection if the pool has been disposed of or if it was
+	// opened in excess of the limit for a detached lease
+	if(m_disposed || (m_readers->Count > m_maxreaders)) CloseConnection(connection);
+	else m_idle->Push(connection);
+
+	Monitor::Pulse(m_lock);
+}
+
+//---------------------------------------------------------------------------
+// ConnectionPool::Generation::get
+//
+// Gets the current database change generation
+
+int64_t ConnectionPool::Generation::get(void)
+{
+	return Interlocked::Read(m_generation);
+}
+
+//---------------------------------------------------------------------------
+// ConnectionPool::StatementCacheHits::get
+//
+// Gets the number of statements reused from all connection caches
+
+int64_t ConnectionPool::StatementCacheHits::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	msclr::lock lock(m_lock);
+
+	int64_t hits = m_writer->Statements->Hits;
+	for each(Connection^ connection in m_readers) hits += connection->Statements->Hits;
+
+	return hits;
+}
+
+//---------------------------------------------------------------------------
+// ConnectionPool::StatementCacheMisses::get
+//
+// Gets the number of statements created by all connection caches
+
+int64_t ConnectionPool::StatementCacheMisses::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	msclr::lock lock(m_lock);
+
+	int64_t misses = m_writer->Statements->Misses;
+	for each(Connection^ connection in m_readers) misses += connection->Statements->Misses;
+
+	return misses;
+}
+
+//---------------------------------------------------------------------------
+// ConnectionPool::Lease Constructor
+//
+// Arguments:
+//
+//	pool		- Parent ConnectionPool instance
+//	mode		- Lease mode
+
+ConnectionPool::Lease::Lease(ConnectionPool^ pool, LeaseMode mode) : m_pool(pool), m_mode(mode)
+{
+	if(CLRISNULL(pool)) throw gcnew ArgumentNullException("pool");
+
+	m_connection = pool->AcquireConnection(mode);
+
+	// Hold a reference against the connection handle for the lifetime of the lease
+	try { m_instance = gcnew SQLiteSafeHandle::Reference(m_connection->Handle); }
+	catch(Exception^) { pool->ReleaseConnection(m_connection, mode); throw; }
+
+	// Write leases record the writer change count to detect changes made through the lease
+	if(mode == LeaseMode::Write) m_changes = sqlite3_total_changes64(*m_instance);
+}
+
+//---------------------------------------------------------------------------
+// ConnectionPool::Lease Destructor
+
+ConnectionPool::Lease::~Lease()
+{
+	if(CLRISNULL(m_connection)) return;
+
+	// Remove the guard from the lease when it is released normally
+	{
+		msclr::lock lock(m_pool->m_lock);
+
+		if(Object::ReferenceEquals(m_pool->m_guardlease, this)) {
+
+			m_pool->m_guardlease = nullptr;
+			m_pool->m_guardowner = nullptr;
+		}
+	}
+
+	// Advance the change generation while the writer is still held if anything was
+	// written through this lease; sqlite3_total_changes64() includes rolled back changes
+	if((m_mode == LeaseMode::Write) && (sqlite3_total_changes64(*m_instance) != m_changes))
+		Interlocked::Increment(m_pool->m_generation);
+
+	delete m_instance;
+	m_pool->ReleaseConnection(m_connection, m_mode);
+
+	m_instance = nullptr;
+	m_connection = nullptr;
+}
+
+//---------------------------------------------------------------------------
+// ConnectionPool::Lease::Abandon
+//
+// Abandons a guarded write lease; the pool rolls back the writer and releases it
+//
+// Arguments:
+//
+//	NONE
+
+void ConnectionPool::Lease::Abandon(void)
+{
+	CHECK_DISPOSED(CLRISNULL(m_connection));
+
+	{
+		msclr::lock lock(m_pool->m_lock);
+
+		if(!Object::ReferenceEquals(m_pool->m_guardlease, this)) throw gcnew InvalidOperationException("Only a guarded lease can be abandoned");
+		m_pool->m_guardowner = nullptr;
+	}
+
+	// The writer is reclaimed immediately if the thread that held it has no other leases
+	// outstanding, otherwise it is reclaimed by the next thread that waits for it
+	m_pool->ReclaimWriter();
+}
+
+//---------------------------------------------------------------------------
+// ConnectionPool::Lease::Guard
+//
+// Ties a write lease to the lifetime of an owner object; if the owner is collected
+// without releasing the lease, the writer is rolled back and released by the pool
+//
+// Arguments:
+//
+//	owner		- Object that owns the lease
+
+void ConnectionPool::Lease::Guard(Object^ owner)
+{
+	CHECK_DISPOSED(CLRISNULL(m_connection));
+
+	if(CLRISNULL(owner)) throw gcnew ArgumentNullException("owner");
+	if(m_mode != LeaseMode::Write) throw gcnew InvalidOperationException("Only a write lease can be guarded");
+
+	msclr::lock lock(m_pool->m_lock);
+
+	m_pool->m_guardlease = this;
+	m_pool->m_guardowner = gcnew WeakReference(owner);
+}
+
+//---------------------------------------------------------------------------
+// ConnectionPool::Lease::ObserveDataVersion (private)
+//
+// Observes the data version of the leased connection, advancing the generation on a change
+//
+// Arguments:
+//
+//	NONE
+
+bool ConnectionPool::Lease::ObserveDataVersion(void)
+{
+	int64_t dataversion = 0;
+
+	CHECK_DISPOSED(CLRISNULL(m_connection));
+
+	// PRAGMA data_version changes when any other connection commits to the database,
+	// including the writer as seen from a read-only connection.  The values cannot be
+	// compared between connections, each connection tracks the last value it observed.
+	// Inside an open read transaction the value is that of the transaction's snapshot
+	sqlite3_stmt* statement = m_connection->Statements->Acquire(*m_instance, L"pragma data_version");
+
+	try {
+
+		int result = sqlite3_step(statement);
+		if(result != SQLITE_ROW) throw gcnew SQLiteException(result, sqlite3_errmsg(*m_instance));
+
+		dataversion = sqlite3_column_int64(statement, 0);
+	}
+
+	finally { m_connection->Statements->Release(statement); }
+
+	// A connection is only used by one thread at a time so its last observed value needs no
+	// synchronization.  A newly opened connection cannot know what changed before it was
+	// opened and always advances the generation
+	if(dataversion == m_connection->DataVersion) return false;
+
+	m_connection->DataVersion = dataversion;
+	Interlocked::Increment(m_pool->m_generation);
+
+	return true;
+}
+
+//---------------------------------------------------------------------------
+// ConnectionPool::Lease::Snapshot
+//
+// Gets the change generation of the read transaction open on the leased connection,
+// or -1 if the generation of the transaction's snapshot cannot be determined
+//
+// Arguments:
+//
+//	generation	- Pool generation observed before the read transaction was started
+
+int64_t ConnectionPool::Lease::Snapshot(int64_t generation)
+{
+	// If the connection has not observed a change, nothing was committed between its last
+	// observation and the start of the transaction, both of which precede the generation
+	// that was read by the caller.  Otherwise the snapshot may be older or newer than the
+	// current generation, and there is no way to tell which
+	return ObserveDataVersion() ? -1 : generation;
+}
+
+//---------------------------------------------------------------------------
+// ConnectionPool::Lease::operator sqlite3*
+//
+// Converts the lease into the leased sqlite3 instance
+
+ConnectionPool::Lease::operator sqlite3*()
+{
+	CHECK_DISPOSED(CLRISNULL(m_connection));
+	return *m_instance;
+}
+
+//---------------------------------------------------------------------------
+// ConnectionPool::Lease::Handle::get
+//
+// Gets the safe handle of the leased connection
+
+SQLiteSafeHandle^ ConnectionPool::Lease::Handle::get(void)
+{
+	CHECK_DISPOSED(CLRISNULL(m_connection));
+	return m_connection->Handle;
+}
+
+//---------------------------------------------------------------------------
+// ConnectionPool::Lease::Statements::get
+//
+// Gets the statement cache of the leased connection
+
+StatementCache^ ConnectionPool::Lease::Statements::get(void)
+{
+	CHECK_DISPOSED(CLRISNULL(m_connection));
+	return m_connection->Statements;
+}
+
+//---------------------------------------------------------------------------
+// ConnectionPool::Lease::Version::get
+//
+// Gets the database change generation as observed through the leased connection
+
+int64_t ConnectionPool::Lease::Version::get(void)
+{
+	ObserveDataVersion();
+	return Interlocked::Read(m_pool->m_generation);
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::ronin::data
+
+#pragma warning(pop)
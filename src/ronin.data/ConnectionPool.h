@@ -0,0 +1,290 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __CONNECTIONPOOL_H_
+#define __CONNECTIONPOOL_H_
+#pragma once
+
+#include "SQLiteSafeHandle.h"
+#include "StatementCache.h"
+
+#pragma warning(push, 4)
+
+using namespace System;
+using namespace System::Collections::Generic;
+using namespace System::Threading;
+
+namespace zuki::ronin::data {
+
+//---------------------------------------------------------------------------
+// Class ConnectionPool (internal)
+//
+// Manages the single writer connection and a bounded set of read-only
+// connections against the same database file.  Read leases are tracked per
+// thread so nested operations on one thread share a single connection; a
+// thread that holds the writer performs its reads on the writer as well.
+// The writer is held through a gate that is not bound to a thread, so that a
+// write lease can be released on a thread other than the one that took it
+//---------------------------------------------------------------------------
+
+ref class ConnectionPool
+{
+	// FORWARD DECLARATIONS
+	//
+	ref class Connection;
+
+public:
+
+	// Instance Constructor
+	//
+	ConnectionPool(SQLiteSafeHandle^ writer, String^ path, int readers, bool immutable);
+
+	// Destructor
+	//
+	~ConnectionPool();
+
+	//-----------------------------------------------------------------------
+	// Type Declarations
+
+	// LeaseMode
+	//
+	// Specifies the type of connection lease to acquire
+	enum class LeaseMode
+	{
+		Read		= 0,		// Read-only connection, shared by the thread
+		Write,					// Writer connection, exclusive to the thread
+		Detached,				// Read-only connection, not bound to a thread
+	};
+
+	// Class Lease
+	//
+	// Leases a connection from the pool for the lifetime of the object
+	ref class Lease
+	{
+	public:
+
+		// Instance Constructor
+		//
+		Lease(ConnectionPool^ pool, LeaseMode mode);
+
+		// Destructor
+		//
+		~Lease();
+
+		//-------------------------------------------------------------------
+		// Member Functions
+
+		// Abandon
+		//
+		// Abandons a guarded write lease; the pool rolls back the writer and releases it
+		void Abandon(void);
+
+		// Guard
+		//
+		// Ties a write lease to the lifetime of an owner object
+		void Guard(Object^ owner);
+
+		// Snapshot
+		//
+		// Gets the change generation of the read transaction open on the leased connection
+		int64_t Snapshot(int64_t generation);
+
+		//-------------------------------------------------------------------
+		// Operators
+
+		// sqlite3* conversion operator
+		//
+		operator sqlite3*();
+
+		// Handle
+		//
+		// Gets the safe handle of the leased connection
+		property SQLiteSafeHandle^ Handle
+		{
+			SQLiteSafeHandle^ get(void);
+		}
+
+		// Statements
+		//
+		// Gets the statement cache of the leased connection
+		property StatementCache^ Statements
+		{
+			StatementCache^ get(void);
+		}
+
+		// Version
+		//
+		// Gets the database change generation as observed through the leased connection
+		property int64_t Version
+		{
+			int64_t get(void);
+		}
+
+	private:
+
+		//-------------------------------------------------------------------
+		// Private Member Functions
+
+		// ObserveDataVersion
+		//
+		// Observes the data version of the leased connection, advancing the generation on a change
+		bool ObserveDataVersion(void);
+
+		//-------------------------------------------------------------------
+		// Member Variables
+
+		ConnectionPool^					m_pool;				// Parent ConnectionPool
+		Connection^						m_connection;		// Leased connection
+		LeaseMode						m_mode;				// Lease mode
+		SQLiteSafeHandle::Reference^	m_instance;			// Handle reference
+		int64_t							m_changes = 0;		// Writer changes at acquisition
+	};
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// OpenReadOnly (static)
+	//
+	// Opens a read-only connection against a database file
+	static SQLiteSafeHandle^ OpenReadOnly(String^ path, bool immutable);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Generation
+	//
+	// Gets the current database change generation
+	property int64_t Generation
+	{
+		int64_t get(void);
+	}
+
+	// StatementCacheHits
+	//
+	// Gets the number of statements reused from all connection caches
+	property int64_t StatementCacheHits
+	{
+		int64_t get(void);
+	}
+
+	// StatementCacheMisses
+	//
+	// Gets the number of statements created by all connection caches
+	property int64_t StatementCacheMisses
+	{
+		int64_t get(void);
+	}
+
+private:
+
+	// Class Connection
+	//
+	// Pairs a database connection with its statement cache
+	ref class Connection
+	{
+	public:
+
+		// Instance Constructor
+		//
+		Connection(SQLiteSafeHandle^ handle) : Handle(handle), Statements(gcnew StatementCache()) {}
+
+		//-------------------------------------------------------------------
+		// Fields
+
+		initonly SQLiteSafeHandle^		Handle;				// Connection handle
+		initonly StatementCache^		Statements;			// Statement cache
+		int								LeaseCount = 0;		// Number of active leases
+		int								Owner = 0;			// Owning managed thread id
+		int64_t							DataVersion = -1;	// Last observed data_version
+	};
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// AcquireConnection
+	//
+	// Acquires a connection from the pool
+	Connection^ AcquireConnection(LeaseMode mode);
+
+	// AcquireWriter
+	//
+	// Acquires the writer connection
+	Connection^ AcquireWriter(void);
+
+	// CloseConnection
+	//
+	// Closes a read-only connection and removes it from the pool
+	void CloseConnection(Connection^ connection);
+
+	// IsUri (static)
+	//
+	// Determines if a database path is a SQLite URI filename
+	static bool IsUri(String^ path);
+
+	// OpenConnection
+	//
+	// Opens a new read-only connection and adds it to the pool
+	Connection^ OpenConnection(void);
+
+	// ReclaimWriter
+	//
+	// Rolls back and releases the writer if its guarded lease has been abandoned
+	bool ReclaimWriter(void);
+
+	// ReleaseConnection
+	//
+	// Releases a connection back into the pool
+	void ReleaseConnection(Connection^ connection, LeaseMode mode);
+
+	//-----------------------------------------------------------------------
+	// Private Constants
+
+	// WRITER_RECLAIM_INTERVAL
+	//
+	// Interval, in milliseconds, at which a thread waiting on the writer checks for an abandoned lease
+	literal int WRITER_RECLAIM_INTERVAL = 1000;
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	bool							m_disposed = false;		// Object disposal flag
+	Object^							m_lock;					// Synchronization object
+	String^							m_path;					// Database file path
+	int								m_maxreaders;			// Read-only connection limit
+	bool							m_immutable;			// Immutable database flag
+	Connection^						m_writer;				// Writer connection
+	SemaphoreSlim^					m_writegate;			// Writer connection gate
+	Lease^							m_guardlease;			// Guarded writer lease
+	WeakReference^					m_guardowner;			// Owner of the guarded lease
+	List<Connection^>^				m_readers;				// Open read-only connections
+	Stack<Connection^>^				m_idle;					// Idle read-only connections
+	Dictionary<int, Connection^>^	m_threads;				// Read leases by thread
+	int64_t							m_generation = 0;		// Database change generation
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::ronin::data
+
+#pragma warning(pop)
+
+#endif	// __CONNECTIONPOOL_H_
@@ -40,6 +40,41 @@ using namespace System::Runtime::InteropServices;
 
 namespace zuki::ronin::data {
 
+//---------------------------------------------------------------------------
+// add_parameter (local)
+//
+// Adds a query parameter value to a collection and returns the numbered marker
+//
+// Arguments:
+//
+//	parameters		- Collection of query parameter values
+//	value			- Value to be added to the collection
+
+static String^ add_parameter(List<Object^>^ parameters, Object^ value)
+{
+	CLRASSERT(CLRISNOTNULL(parameters));
+
+	parameters->Add(value);
+	return "?" + parameters->Count.ToString();
+}
+
+//---------------------------------------------------------------------------
+// bind_parameter (local)
+//
+// Used by execute_non_query to bind an integer parameter
+//
+// Arguments:
+//
+//	statement		- SQL statement instance
+//	paramindex		- Index of the parameter to bind; will be incremented
+//	value			- Value to bind as the parameter
+
+static void bind_parameter(sqlite3_stmt* statement, int& paramindex, int value)
+{
+	int result = sqlite3_bind_int(statement, paramindex++, value);
+	if(result != SQLITE_OK) throw gcnew SQLiteException(result);
+}
+
 //---------------------------------------------------------------------------
 // bind_parameter (local)
 //
@@ -82,15 +117,122 @@ static void bind_parameter(sqlite3_stmt* statement, int& paramindex, Uuid^ value
 {
 	int					result;				// Result from binding operation
 
-	// Convert the Guid into a byte array and pin it
-	array<Byte>^ guid = value->ToByteArray();
-	pin_ptr<Byte> pinguid = &guid[0];
+	// Convert the Uuid into a native key on the stack
+	uuidkey_t key = value->ToKey();
 
 	// Specify SQLITE_TRANSIENT to have SQLite copy the data
-	result = sqlite3_bind_blob(statement, paramindex++, pinguid, guid->Length, SQLITE_TRANSIENT);
+	result = sqlite3_bind_blob(statement, paramindex++, &key, sizeof(uuidkey_t), SQLITE_TRANSIENT);
+	if(result != SQLITE_OK) throw gcnew SQLiteException(result);
+}
+
+//---------------------------------------------------------------------------
+// bind_parameter (local)
+//
+// Binds a boxed String^, int or Uuid^ parameter
+//
+// Arguments:
+//
+//	statement		- SQL statement instance
+//	paramindex		- Index of the parameter to bind; will be incremented
+//	value			- Value to bind as the parameter
+
+static void bind_parameter(sqlite3_stmt* statement, int& paramindex, Object^ value)
+{
+	CLRASSERT(CLRISNOTNULL(value));
+
+	if(value->GetType() == String::typeid) bind_parameter(statement, paramindex, safe_cast<String^>(value));
+	else if(value->GetType() == int::typeid) bind_parameter(statement, paramindex, safe_cast<int>(value));
+	else bind_parameter(statement, paramindex, safe_cast<Uuid^>(value));
+}
+
+//---------------------------------------------------------------------------
+// uuidarray_free (local)
+//
+// Releases a uuidarray_t bound to a statement with sqlite3_bind_pointer
+//
+// Arguments:
+//
+//	ptr				- Pointer to the uuidarray_t instance
+
+static void uuidarray_free(void* ptr)
+{
+	delete reinterpret_cast<uuidarray_t*>(ptr);
+}
+
+//---------------------------------------------------------------------------
+// bind_uuidarray (local)
+//
+// Binds a collection of Uuids as a pointer for the uuidarray table-valued function
+//
+// Arguments:
+//
+//	statement		- SQL statement instance
+//	paramindex		- Index of the parameter to bind
+//	values			- Collection of Uuid values to bind as the parameter
+
+static void bind_uuidarray(sqlite3_stmt* statement, int paramindex, System::Collections::IEnumerable^ values)
+{
+	uuidarray_t* uuids = new uuidarray_t();
+
+	try {
+
+		for each(Uuid^ value in values) {
+
+			if(CLRISNULL(value)) continue;
+
+			uuids->push_back(value->ToKey());
+		}
+	}
+
+	catch(Exception^) { delete uuids; throw; }
+
+	// SQLite takes ownership of the array and will invoke the destructor even if the bind fails
+	int result = sqlite3_bind_pointer(statement, paramindex, uuids, UUIDARRAY_POINTER_TYPE, uuidarray_free);
 	if(result != SQLITE_OK) throw gcnew SQLiteException(result);
 }
 
+//---------------------------------------------------------------------------
+// column_blob (local)
+//
+// Converts a SQLite BLOB result column into a managed byte array
+//
+// Arguments:
+//
+//	statement		- SQL statement instance
+//	index			- Index of the result column
+
+static array<Byte>^ column_blob(sqlite3_stmt* statement, int index)
+{
+	int length = sqlite3_column_bytes(statement, index);
+	if(length == 0) return nullptr;
+
+	void const* blob = sqlite3_column_blob(statement, index);
+	if(blob == nullptr) return nullptr;
+
+	array<Byte>^ data = gcnew array<Byte>(length);
+	Marshal::Copy(IntPtr(const_cast<void*>(blob)), data, 0, length);
+
+	return data;
+}
+
+//---------------------------------------------------------------------------
+// column_day (local)
+//
+// Converts a SQLite integer day number result column into a DateTime
+//
+// Arguments:
+//
+//	statement		- SQL statement instance
+//	index			- Index of the result column
+
+static Nullable<DateTime> column_day(sqlite3_stmt* statement, int index)
+{
+	if(sqlite3_column_type(statement, index) == SQLITE_NULL) return Nullable<DateTime>();
+
+	// Day numbers count the days since 0001-01-01, the same epoch as DateTime
+	return DateTime(sqlite3_column_int64(statement, index) * TimeSpan::TicksPerDay);
+}
+
 //---------------------------------------------------------------------------
 // column_string (local)
 //
@@ -103,30 +245,268 @@ static void bind_parameter(sqlite3_stmt* statement, int& paramindex, Uuid^ value
 
 static String^ column_string(sqlite3_stmt* statement, int index)
 {
-	wchar_t const* stringptr = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, index));
-	return (stringptr == nullptr) ? String::Empty : gcnew String(stringptr);
+	// Access the UTF-8 text directly to avoid a conversion inside of SQLite, the
+	// only conversion to UTF-16 happens here at the managed boundary
+	char const* stringptr = reinterpret_cast<char const*>(sqlite3_column_text(statement, index));
+	if(stringptr == nullptr) return String::Empty;
+
+	int length = sqlite3_column_bytes(statement, index);
+	return (length == 0) ? String::Empty : gcnew String(stringptr, 0, length, Text::Encoding::UTF8);
+}
+
+//---------------------------------------------------------------------------
+// column_string (local)
+//
+// Converts a low-cardinality SQLite text result column into an interned System::String
+//
+// Arguments:
+//
+//	statement		- SQL statement instance
+//	index			- Index of the result column
+//	strings			- Intern pool to resolve the string from
+
+static String^ column_string(sqlite3_stmt* statement, int index, StringPool^ strings)
+{
+	CLRASSERT(CLRISNOTNULL(strings));
+
+	char const* stringptr = reinterpret_cast<char const*>(sqlite3_column_text(statement, index));
+	if(stringptr == nullptr) return String::Empty;
+
+	return strings->Intern(stringptr, sqlite3_column_bytes(statement, index));
 }
 
 //---------------------------------------------------------------------------
 // column_uuid (local)
 //
-// Converts a SQLite BLOB result column into a System::Guid
+// Converts a SQLite BLOB result column into a native UUID key
 //
 // Arguments:
 //
 //	statement		- SQL statement instance
 //	index			- Index of the result column
 
-static Guid column_uuid(sqlite3_stmt* statement, int index)
+static uuidkey_t column_uuid(sqlite3_stmt* statement, int index)
 {
+	uuidkey_t key = { 0, 0 };
+
 	int bloblen = sqlite3_column_bytes(statement, index);
-	if(bloblen == 0) return Guid::Empty;
-	if(bloblen != sizeof(UUID)) throw gcnew Exception("Invalid BLOB length for conversion to System::Guid");
+	if(bloblen == 0) return key;
+	if(bloblen != sizeof(uuidkey_t)) throw gcnew Exception("Invalid BLOB length for conversion to a UUID");
+
+	// Copy the BLOB directly into the key on the stack
+	memcpy(&key, sqlite3_column_blob(statement, index), sizeof(uuidkey_t));
+	return key;
+}
+
+//---------------------------------------------------------------------------
+// compile_cardfilter (local)
+//
+// Compiles a CardFilter into a parameterized query against the cardsummary table
+//
+// Arguments:
+//
+//	filter			- CardFilter to be compiled
+//	parameters		- On output, contains the values to bind to the query
+
+static String^ compile_cardfilter(CardFilter^ filter, List<Object^>^ parameters)
+{
+	CLRASSERT(CLRISNOTNULL(filter));
+	CLRASSERT(CLRISNOTNULL(parameters));
+
+	List<String^>^ predicates = gcnew List<String^>();
+
+	// type
+	if(filter->Type.HasValue) predicates->Add("type = " + add_parameter(parameters, static_cast<int>(filter->Type.Value)));
+
+	// monsterattribute | monstertype | monsterlevel | monsterattack | monsterdefense
+	if(filter->Attribute.HasValue) predicates->Add("monsterattribute = " + add_parameter(parameters, static_cast<int>(filter->Attribute.Value)));
+	if(filter->MonsterType.HasValue) predicates->Add("monstertype = " + add_parameter(parameters, static_cast<int>(filter->MonsterType.Value)));
+	if(filter->MinimumLevel.HasValue) predicates->Add("monsterlevel >= " + add_parameter(parameters, filter->MinimumLevel.Value));
+	if(filter->MaximumLevel.HasValue) predicates->Add("monsterlevel <= " + add_parameter(parameters, filter->MaximumLevel.Value));
+	if(filter->MinimumAttack.HasValue) predicates->Add("monsterattack >= " + add_parameter(parameters, filter->MinimumAttack.Value));
+	if(filter->MaximumAttack.HasValue) predicates->Add("monsterattack <= " + add_parameter(parameters, filter->MaximumAttack.Value));
+	if(filter->MinimumDefense.HasValue) predicates->Add("monsterdefense >= " + add_parameter(parameters, filter->MinimumDefense.Value));
+	if(filter->MaximumDefense.HasValue) predicates->Add("monsterdefense <= " + add_parameter(parameters, filter->MaximumDefense.Value));
+
+	// spellxxxx | trapxxxx; the icon columns are null for cards of the other types
+	if(filter->Icon.HasValue) {
+
+		switch(filter->Icon.Value) {
+
+			case CardIcon::None: predicates->Add("(spellnormal = 1 or trapnormal = 1)"); break;
+			case CardIcon::Continuous: predicates->Add("(spellcontinuous = 1 or trapcontinuous = 1)"); break;
+			case CardIcon::Counter: predicates->Add("trapcounter = 1"); break;
+			case CardIcon::Equip: predicates->Add("spellequip = 1"); break;
+			case CardIcon::Field: predicates->Add("spellfield = 1"); break;
+			case CardIcon::QuickPlay: predicates->Add("spellquickplay = 1"); break;
+			case CardIcon::Ritual: predicates->Add("spellritual = 1"); break;
+			default: throw gcnew ArgumentOutOfRangeException("filter");
+		}
+	}
+
+	// releaseday
+	if(filter->MinimumReleaseDate.HasValue) 
+		predicates->Add("releaseday >= " + add_parameter(parameters, ReleaseIndex::ToDay(filter->MinimumReleaseDate.Value)));
+	if(filter->MaximumReleaseDate.HasValue) 
+		predicates->Add("releaseday <= " + add_parameter(parameters, ReleaseIndex::ToDay(filter->MaximumReleaseDate.Value)));
+
+	// restrictionlistid | restriction
+	if(CLRISNOTNULL(filter->RestrictionList)) {
+
+		String^ restriction = "select 1 from restriction where restrictionlistid = " + add_parameter(parameters, filter->RestrictionList->RestrictionListID) +
+			" and cardid = cardsummary.cardid";
+
+		// Unlimited cards are not present in the restriction table
+		if(!filter->Restriction.HasValue) predicates->Add("exists(" + restriction + ")");
+		else if(filter->Restriction.Value == Restriction::Unlimited) predicates->Add("not exists(" + restriction + ")");
+		else predicates->Add("exists(" + restriction + " and restriction = " + add_parameter(parameters, static_cast<int>(filter->Restriction.Value)) + ")");
+	}
+
+	else if(filter->Restriction.HasValue) throw gcnew ArgumentException("Filtering on Restriction requires a RestrictionList", "filter");
+
+	// cardsummary table
+	String^ sql = "select * from cardsummary";
+	if(predicates->Count > 0) sql += " where " + String::Join(" and ", predicates);
 
-	array<byte>^ blob = gcnew array<byte>(bloblen);
-	Marshal::Copy(IntPtr(const_cast<void*>(sqlite3_column_blob(statement, index))), blob, 0, bloblen);
+	return sql + " order by name asc";
+}
+
+//---------------------------------------------------------------------------
+// copy_table (local)
+//
+// Copies all rows of a table from one database instance into another
+//
+// Arguments:
+//
+//	source		- Source database instance
+//	target		- Target database instance
+//	table		- Name of the table to copy
+
+static void copy_table(sqlite3* source, sqlite3* target, String^ table)
+{
+	sqlite3_stmt* select = nullptr;
+	sqlite3_stmt* insert = nullptr;
+
+	CLRASSERT(source != nullptr);
+	CLRASSERT(target != nullptr);
+	CLRASSERT(CLRISNOTNULL(table));
+
+	String^ name = String::Concat("\"", table->Replace("\"", "\"\""), "\"");
+
+	// Generated columns cannot be inserted; only the ordinary columns are copied
+	Text::StringBuilder^ columnlist = gcnew Text::StringBuilder();
+	pin_ptr<wchar_t const> pintable = PtrToStringChars(table);
+	int result = sqlite3_prepare16_v2(source, L"select name from pragma_table_xinfo(?1) where hidden = 0 order by cid", -1, &select, nullptr);
+	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(source));
+
+	try {
+
+		result = sqlite3_bind_text16(select, 1, pintable, -1, SQLITE_STATIC);
+		if(result != SQLITE_OK) throw gcnew SQLiteException(result);
+
+		result = sqlite3_step(select);
+		while(result == SQLITE_ROW) {
+
+			if(columnlist->Length > 0) columnlist->Append(", ");
+			columnlist->Append("\"")->Append(column_string(select, 0)->Replace("\"", "\"\""))->Append("\"");
+			result = sqlite3_step(select);
+		}
+
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(source));
+	}
+
+	finally { sqlite3_finalize(select); }
+	select = nullptr;
+
+	// Prepare the query against the source table
+	pin_ptr<wchar_t const> pinselect = PtrToStringChars(String::Concat("select ", columnlist->ToString(), " from ", name));
+	result = sqlite3_prepare16_v2(source, pinselect, -1, &select, nullptr);
+	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(source));
+
+	try {
+
+		// Generate and prepare the insert statement for the target table
+		Text::StringBuilder^ sql = gcnew Text::StringBuilder(String::Concat("insert into ", name, "(", columnlist->ToString(), ") values("));
+		int columns = sqlite3_column_count(select);
+		for(int index = 0; index < columns; index++) sql->Append((index == 0) ? "?" : ", ?");
+		sql->Append(")");
+
+		pin_ptr<wchar_t const> pininsert = PtrToStringChars(sql->ToString());
+		result = sqlite3_prepare16_v2(target, pininsert, -1, &insert, nullptr);
+		if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(target));
+
+		// Copy each row; text values are converted into the target encoding by SQLite
+		result = sqlite3_step(select);
+		while(result == SQLITE_ROW) {
+
+			for(int index = 0; index < columns; index++) {
+
+				result = sqlite3_bind_value(insert, index + 1, sqlite3_column_value(select, index));
+				if(result != SQLITE_OK) throw gcnew SQLiteException(result);
+			}
+
+			result = sqlite3_step(insert);
+			if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(target));
+
+			result = sqlite3_reset(insert);
+			if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(target));
+
+			result = sqlite3_step(select);
+		}
+
+		// If the final result of the query was not SQLITE_DONE, something bad happened
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(source));
+	}
+
+	finally {
+
+		sqlite3_finalize(insert);
+		sqlite3_finalize(select);
+	}
+}
+
+//---------------------------------------------------------------------------
+// execute_cached_non_query (local)
+//
+// Executes a database query through the connection statement cache and returns
+// the number of rows affected
+//
+// Arguments:
+//
+//	instance		- Leased database connection
+//	sql				- SQL query to execute
+//	parameters		- Parameters to be bound to the query
+
+template<typename... _parameters>
+static int execute_cached_non_query(ConnectionPool::Lease% instance, wchar_t const* sql, _parameters&&... parameters)
+{
+	int	paramindex = 1;
+
+	if(sql == nullptr) throw gcnew ArgumentNullException("sql");
+
+	// Suppress unreferenced local variable warning when there are no parameters to bind
+	(void)paramindex;
+
+	sqlite3_stmt* statement = instance.Statements->Acquire(instance, sql);
+
+	try {
 
-	return Guid(blob);
+		// Bind the provided query parameter(s) by unpacking the parameter pack
+		int unpack[] = { 0, (static_cast<void>(bind_parameter(statement, paramindex, parameters)), 0) ... };
+		(void)unpack;
+
+		// Execute the query; ignore any rows that are returned
+		int result = sqlite3_step(statement);
+		while(result == SQLITE_ROW) result = sqlite3_step(statement);
+
+		// The final result from sqlite3_step should be SQLITE_DONE
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+
+		// Return the number of changes made by the statement
+		return sqlite3_changes(instance);
+	}
+
+	finally { instance.Statements->Release(statement); }
 }
 
 //---------------------------------------------------------------------------
@@ -277,1085 +657,3044 @@ static int64_t execute_scalar_int64(sqlite3* instance, wchar_t const* sql, _para
 }
 
 //---------------------------------------------------------------------------
-// row_cards (local)
+// fts_query (local)
 //
-// Converts a row from a query against the cards view into a Card object
+// Converts free-form search text into an FTS5 query expression; each word is
+// quoted to neutralize FTS5 syntax characters and is matched as a prefix
 //
 // Arguments:
 //
-//	database		- Current Database instance
-//	statement		- Current sqlite3_stmt pointer
+//	text		- Search text to be converted
 
-static Card^ row_cards(Database^ database, sqlite3_stmt* statement)
+static String^ fts_query(String^ text)
 {
-	CLRASSERT(CLRISNOTNULL(database));
-	CLRASSERT(statement != nullptr);
+	CLRASSERT(CLRISNOTNULL(text));
 
-	// Card instance to be returned to the caller for this result set row
-	Card^ card = nullptr;
+	Text::StringBuilder^ builder = gcnew Text::StringBuilder();
 
-	// view: cards
-	//
-	// { 00-06 } cardid | type | name | passcode | text | releasedate | artworkid
-	// { 07-12 } monsterattribute | monsterlevel | monstertype | monsterattack | monsterdefense | monsternormal 
-	// { 13-19 } monstereffect | monsterfusion | monsterritual | monstertoon | monsterunion | monsterspirit | monstergemini
-	// { 20-25 } spellnormal | spellcontinuous | spellequip | spellfield | spellquickplay | spellritual 
-	// { 26-28 } trapnormal | trapcontinuous | trapcounter
+	for each(String^ term in text->Split(static_cast<array<wchar_t>^>(nullptr), StringSplitOptions::RemoveEmptyEntries)) {
 
-	// cardid | type
-	CardId^ cardid = gcnew CardId(column_uuid(statement, 0));
-	CardType type = static_cast<CardType>(sqlite3_column_int(statement, 1));
+		if(builder->Length > 0) builder->Append(L' ');
+		builder->Append(L'"')->Append(term->Replace("\"", "\"\""))->Append("\"*");
+	}
 
-	// MonsterCard
-	if(type == CardType::Monster) {
+	return builder->ToString();
+}
 
-		MonsterCard^ monster = gcnew MonsterCard(database, cardid);
+//---------------------------------------------------------------------------
+// operation_begin (local)
+//
+// Begins a write operation; the operation runs in its own transaction unless a
+// DatabaseBatch already has one open on the connection, in which case it runs
+// inside a savepoint of that transaction. Returns the flag to pass to
+// operation_commit and operation_rollback
+//
+// Arguments:
+//
+//	instance		- Database instance
 
-		monster->Attribute = static_cast<CardAttribute>(sqlite3_column_int(statement, 7));
-		monster->Level = sqlite3_column_int(statement, 8);
-		monster->Type = static_cast<MonsterType>(sqlite3_column_int(statement, 9));
-		monster->Attack = sqlite3_column_int(statement, 10);
-		monster->Defense = sqlite3_column_int(statement, 11);
-		monster->Normal = (sqlite3_column_int(statement, 12) != 0);
-		monster->Effect = (sqlite3_column_int(statement, 13) != 0);
-		monster->Fusion = (sqlite3_column_int(statement, 14) != 0);
-		monster->Ritual = (sqlite3_column_int(statement, 15) != 0);
-		monster->Toon = (sqlite3_column_int(statement, 16) != 0);
-		monster->Union = (sqlite3_column_int(statement, 17) != 0);
-		monster->Spirit = (sqlite3_column_int(statement, 18) != 0);
-		monster->Gemini = (sqlite3_column_int(statement, 19) != 0);
+static bool operation_begin(sqlite3* instance)
+{
+	bool nested = (sqlite3_get_autocommit(instance) == 0);
+	execute_non_query(instance, (nested) ? L"savepoint operation" : L"begin immediate transaction");
 
-		card = static_cast<Card^>(monster);
-	}
+	return nested;
+}
 
-	// SpellCard
-	else if(type == CardType::Spell) {
+//---------------------------------------------------------------------------
+// operation_commit (local)
+//
+// Commits a write operation started with operation_begin
+//
+// Arguments:
+//
+//	instance		- Database instance
+//	nested			- Flag returned from operation_begin
 
-		SpellCard^ spell = gcnew SpellCard(database, cardid);
-
-		spell->Normal = (sqlite3_column_int(statement, 20) != 0);
-		spell->Continuous = (sqlite3_column_int(statement, 21) != 0);
-		spell->Equip = (sqlite3_column_int(statement, 22) != 0);
-		spell->Field = (sqlite3_column_int(statement, 23) != 0);
-		spell->QuickPlay = (sqlite3_column_int(statement, 24) != 0);
-		spell->Ritual = (sqlite3_column_int(statement, 25) != 0);
-
-		card = static_cast<Card^>(spell);
-	}
-
-	// TrapCard
-	else if(type == CardType::Trap) {
-
-		TrapCard^ trap = gcnew TrapCard(database, cardid);
-
-		trap->Normal = (sqlite3_column_int(statement, 26) != 0);
-		trap->Continuous = (sqlite3_column_int(statement, 27) != 0);
-		trap->Counter = (sqlite3_column_int(statement, 28) != 0);
-
-		card = static_cast<Card^>(trap);
-	}
-
-	// Verify that the Card instance has been set above
-	CLRASSERT(CLRISNOTNULL(card));
-
-	// name | passcode | text
-	card->Name = column_string(statement, 2);
-	card->Passcode = column_string(statement, 3);
-	card->Text = column_string(statement, 4);
-
-	// releasedate
-	wchar_t const* releasedateptr = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 5));
-	card->ReleaseDate = (releasedateptr == nullptr) ? DateTime::MinValue : DateTime::Parse(gcnew String(releasedateptr));
-
-	// artworkid
-	card->ArtworkID = gcnew ArtworkId(column_uuid(statement, 6));
-
-	return card;
-}
-
-//---------------------------------------------------------------------------
-// Database Static Constructor (private)
-//
-// Arguments:
-//
-//	NONE
-	
-static Database::Database()
+static void operation_commit(sqlite3* instance, bool nested)
 {
-	// Automatically register the built-in database extension library functions
-	s_result = sqlite3_auto_extension(reinterpret_cast<void(*)()>(sqlite3_extension_init));
+	execute_non_query(instance, (nested) ? L"release operation" : L"commit transaction");
 }
 
 //---------------------------------------------------------------------------
-// Database Constructor (private)
+// operation_rollback (local)
+//
+// Rolls back a write operation started with operation_begin
 //
 // Arguments:
 //
-//	handle		- SQLiteSafeHandle instance
+//	instance		- Database instance
+//	nested			- Flag returned from operation_begin
 
-Database::Database(SQLiteSafeHandle^ handle) : m_handle(handle)
+static void operation_rollback(sqlite3* instance, bool nested)
 {
-	if(CLRISNULL(handle)) throw gcnew ArgumentNullException("handle");
-
-	// Ensure that the static initialization completed successfully
-	if(s_result != SQLITE_OK)
-		throw gcnew Exception("Static initialization failed", gcnew SQLiteException(s_result));
-}
+	// Some errors roll back the transaction automatically, leaving nothing to undo
+	if(sqlite3_get_autocommit(instance) != 0) return;
 
-//---------------------------------------------------------------------------
-// Database Destructor (private)
+	if(nested) {
 
-Database::~Database()
-{
-	if(m_disposed) return;
+		execute_non_query(instance, L"rollback to operation");
+		execute_non_query(instance, L"release operation");
+	}
 
-	delete m_handle;					// Release the safe handle
-	m_disposed = true;					// Object is now in a disposed state
+	else execute_non_query(instance, L"rollback transaction");
 }
 
 //---------------------------------------------------------------------------
-// Database::EnumerateArtwork
+// plan_rulings (local)
 //
-// Enumerates Artwork from the database
+// Aligns a new list of rulings against the stored rulings for a card. Each new
+// ruling is assigned a source row and a sequence number; rulings that are not
+// changed keep their row and sequence, edited rulings reuse the row they replace,
+// moved rulings keep their row under a new sequence and inserted rulings have no
+// source row. Returns false if a gap between sequence numbers is exhausted
 //
 // Arguments:
 //
-//	callback	- Action<> to invoke for each Artwork instance
-
-void Database::EnumerateArtwork(Action<Artwork^>^ callback)
+//	oldsequences	- Sequence numbers of the stored rulings, in ascending order
+//	oldrulings		- Text of the stored rulings
+//	newrulings		- Text of the new rulings
+//	gap				- Distance between sequence numbers assigned after the last ruling
+//	sources			- On output, the index of the stored ruling reused by each new ruling or -1
+//	sequences		- On output, the sequence number assigned to each new ruling
+
+static bool plan_rulings(List<int>^ oldsequences, List<String^>^ oldrulings, List<String^>^ newrulings, int gap,
+	array<int>^ sources, array<int>^ sequences)
 {
-	CHECK_DISPOSED(m_disposed);
-	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
-
-	if(CLRISNULL(callback)) throw gcnew ArgumentNullException("callback");
-
-	SQLiteSafeHandle::Reference instance(m_handle);
-	sqlite3_stmt* statement;
-
-	auto sql = L"select artworkid, cardid, format, width, height, image from artwork";
-
-	// Prepare the query
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	int oldcount = oldrulings->Count;
+	int newcount = newrulings->Count;
 
-	try {
-
-		// Execute the query and iterate over all returned rows
-		result = sqlite3_step(statement);
-		while(result == SQLITE_ROW) {
-
-			// artworkid | cardid
-			Artwork^ artwork = gcnew Artwork(this, gcnew ArtworkId(column_uuid(statement, 0)),
-				gcnew CardId(column_uuid(statement, 1)));
+	CLRASSERT(oldsequences->Count == oldcount);
+	CLRASSERT((sources->Length == newcount) && (sequences->Length == newcount));
 
-			// format
-			artwork->Format = column_string(statement, 2);
+	// Longest common subsequence of the ruling text; the matched rows are not written
+	array<int, 2>^ lengths = gcnew array<int, 2>(oldcount + 1, newcount + 1);
+	for(int o = oldcount - 1; o >= 0; o--) {
 
-			// width
-			artwork->Width = sqlite3_column_int(statement, 3);
+		for(int n = newcount - 1; n >= 0; n--)
+			lengths[o, n] = (String::Equals(oldrulings[o], newrulings[n])) ? lengths[o + 1, n + 1] + 1 : Math::Max(lengths[o + 1, n], lengths[o, n + 1]);
+	}
 
-			// height
-			artwork->Height = sqlite3_column_int(statement, 4);
+	array<bool>^ used = gcnew array<bool>(oldcount);
+	for(int n = 0; n < newcount; n++) sources[n] = -1;
 
-			// image
-			int length = sqlite3_column_bytes(statement, 5);
-			if(length > 0) {
+	for(int o = 0, n = 0; (o < oldcount) && (n < newcount);) {
 
-				array<Byte>^ image = gcnew array<Byte>(length);
+		if(String::Equals(oldrulings[o], newrulings[n])) {
 
-				void const* blob = sqlite3_column_blob(statement, 5);
-				if(blob != nullptr) {
+			sources[n] = o;
+			sequences[n] = oldsequences[o];
+			used[o] = true;
+			o++, n++;
+		}
 
-					Marshal::Copy(IntPtr(const_cast<void*>(blob)), image, 0, length);
-					artwork->Image = image;
-				}
-			}
+		else if(lengths[o + 1, n] >= lengths[o, n + 1]) o++;
+		else n++;
+	}
 
-			// Invoke the callback and just eat any exceptions that occur
-			try { callback->Invoke(artwork); }
-			catch(Exception^) { /* DO NOTHING */ }
+	// Unmatched stored rows are candidates for moved rulings; the sequence numbers of all
+	// unmatched stored rows are avoided so that a moved row never collides with another
+	HashSet<int>^ reserved = gcnew HashSet<int>();
+	Dictionary<String^, Queue<int>^>^ unmatched = gcnew Dictionary<String^, Queue<int>^>();
+	for(int o = 0; o < oldcount; o++) {
 
-			result = sqlite3_step(statement);			// Move to the next result set row
-		}
+		if(used[o]) continue;
+		reserved->Add(oldsequences[o]);
 
-		// If the final result of the query was not SQLITE_DONE, something bad happened
-		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+		Queue<int>^ rows = nullptr;
+		if(!unmatched->TryGetValue(oldrulings[o], rows)) unmatched->Add(oldrulings[o], rows = gcnew Queue<int>());
+		rows->Enqueue(o);
 	}
 
-	finally { sqlite3_finalize(statement); }
-}
+	// Each run of unmatched new rulings falls into the gap between two matched rows
+	int previous = -1;
+	int n = 0;
+	while(n < newcount) {
 
-//---------------------------------------------------------------------------
-// Database::EnumerateCards
-//
-// Enumerates Cards from the database
-//
-// Arguments:
-//
-//	callback	- Action<> to invoke for each Card instance
+		if(sources[n] >= 0) { previous = sources[n++]; continue; }
 
-void Database::EnumerateCards(Action<Card^>^ callback)
-{
-	CHECK_DISPOSED(m_disposed);
-	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
+		int first = n;
+		while((n < newcount) && (sources[n] < 0)) n++;
+		int next = (n < newcount) ? sources[n] : oldcount;
 
-	if(CLRISNULL(callback)) throw gcnew ArgumentNullException("callback");
+		// Edited rulings reuse the unmatched stored rows of the same gap in order
+		int lower = (previous >= 0) ? oldsequences[previous] : 0;
+		int edit = first;
+		for(int o = previous + 1; (o < next) && (edit < n); o++) {
 
-	SQLiteSafeHandle::Reference instance(m_handle);
-	sqlite3_stmt* statement;
+			if(used[o]) continue;
 
-	// cards view
-	auto sql = L"select * from cards order by name asc";
+			sources[edit] = o;
+			sequences[edit++] = lower = oldsequences[o];
+			used[o] = true;
+		}
 
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+		// The remaining rulings are spaced evenly between the last reused row and the next matched row
+		bool bounded = (next < oldcount);
+		int upper = (bounded) ? oldsequences[next] : Int32::MaxValue;
+		int step = (bounded) ? (upper - lower) / (n - edit + 1) : gap;
+		if(step < 1) return false;
 
-	try {
+		int sequence = lower;
+		for(int index = edit; index < n; index++) {
 
-		// Execute the query and iterate over all returned rows
-		result = sqlite3_step(statement);
-		while(result == SQLITE_ROW) {
+			sequence = Math::Max(lower + (step * (index - edit + 1)), sequence + 1);
+			while(reserved->Contains(sequence)) sequence++;
+			if(sequence >= upper) return false;
 
-			try { callback->Invoke(row_cards(this, statement)); }
-			catch(Exception^) { /* DO NOTHING */ }
+			sequences[index] = sequence;
 
-			result = sqlite3_step(statement);			// Move to the next result set row
+			// A ruling that was moved from elsewhere keeps its stored row
+			Queue<int>^ rows = nullptr;
+			if(unmatched->TryGetValue(newrulings[index], rows)) {
+
+				while((rows->Count > 0) && used[rows->Peek()]) rows->Dequeue();
+				if(rows->Count > 0) { sources[index] = rows->Dequeue(); used[sources[index]] = true; }
+			}
 		}
 
-		// If the final result of the query was not SQLITE_DONE, something bad happened
-		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+		previous = next;
 	}
 
-	finally { sqlite3_finalize(statement); }
+	return true;
 }
 
 //---------------------------------------------------------------------------
-// Database::EnumerateCards
+// rebuild_utf8 (local)
 //
-// Enumerates Cards from the database
+// Rebuilds a database into a new, empty UTF-8 encoded database instance
 //
 // Arguments:
 //
-//	callback	- Action<> to invoke for each Card instance
-//	releasedate	- Maximum release date for the card
+//	source		- Source database instance
+//	instance	- Target database instance
 
-void Database::EnumerateCards(DateTime releasedate, Action<Card^>^ callback)
+static void rebuild_utf8(sqlite3* source, sqlite3* instance)
 {
-	CHECK_DISPOSED(m_disposed);
-	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
+	sqlite3_stmt* statement = nullptr;
+	int result = SQLITE_OK;
 
-	if(CLRISNULL(callback)) throw gcnew ArgumentNullException("callback");
+	CLRASSERT(source != nullptr);
+	CLRASSERT(instance != nullptr);
 
-	SQLiteSafeHandle::Reference instance(m_handle);
-	sqlite3_stmt* statement;
+	// The encoding has to be set before anything is written to the database
+	execute_non_query(instance, L"pragma encoding='UTF-8'");
+	execute_non_query(instance, L"begin immediate transaction");
 
-	// releasedate
-	String^ _releasedate = releasedate.ToString("yyyy-MM-dd");
-	pin_ptr<wchar_t const> pinmindate = PtrToStringChars(_releasedate);
+	try {
 
-	// cards view
-	auto sql = L"select * from cards where releasedate <= ?1 order by name asc";
+		// Tables are created and populated before any of the indexes, views and triggers; the
+		// triggers that maintain cardsummary must not fire while that table is being copied
+		auto sql = L"select type, name, sql from sqlite_master where sql is not null and name not like 'sqlite_%' "
+			"order by case type when 'table' then 0 when 'index' then 1 when 'view' then 2 else 3 end, rowid";
 
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+		result = sqlite3_prepare16_v2(source, sql, -1, &statement, nullptr);
+		if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(source));
 
-	try {
+		try {
 
-		// Bind the query parameter(s)
-		result = sqlite3_bind_text16(statement, 1, pinmindate, -1, SQLITE_STATIC);
-		if(result != SQLITE_OK) throw gcnew SQLiteException(result);
+			result = sqlite3_step(statement);
+			while(result == SQLITE_ROW) {
 
-		// Execute the query and iterate over all returned rows
-		result = sqlite3_step(statement);
-		while(result == SQLITE_ROW) {
+				String^ type = column_string(statement, 0);
+				String^ name = column_string(statement, 1);
 
-			// Invoke the callback and just eat any exceptions that occur
-			try { callback->Invoke(row_cards(this, statement)); }
-			catch(Exception^) { /* DO NOTHING */ }
+				// Create the schema object in the target database
+				pin_ptr<wchar_t const> pinsql = PtrToStringChars(column_string(statement, 2));
+				execute_non_query(instance, pinsql);
 
-			result = sqlite3_step(statement);			// Move to the next result set row
+				if(String::Equals(type, "table")) copy_table(source, instance, name);
+
+				result = sqlite3_step(statement);
+			}
+
+			if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(source));
 		}
 
-		// If the final result of the query was not SQLITE_DONE, something bad happened
-		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+		finally { sqlite3_finalize(statement); }
+
+		// Carry the schema version over into the target database
+		pin_ptr<wchar_t const> pinversion = PtrToStringChars(String::Format("pragma user_version = {0}", 
+			execute_scalar_int(source, L"pragma user_version")));
+		execute_non_query(instance, pinversion);
+
+		execute_non_query(instance, L"commit transaction");
 	}
 
-	finally { sqlite3_finalize(statement); }
+	catch(Exception^) {
+
+		if(sqlite3_get_autocommit(instance) == 0) sqlite3_exec(instance, "rollback transaction", nullptr, nullptr, nullptr);
+		throw;
+	}
 }
 
 //---------------------------------------------------------------------------
-// Database::EnumerateCardsWithRulings
+// rebuild_utf8 (local)
 //
-// Enumerates Cards from the database that have Rulings
+// Rebuilds a database into a new UTF-8 encoded database file
 //
 // Arguments:
 //
-//	callback	- Action<> to invoke for each Card instance
+//	source		- Source database instance
+//	path		- Path of the database file to be created
 
-void Database::EnumerateCardsWithRulings(Action<Card^>^ callback)
+static void rebuild_utf8(sqlite3* source, String^ path)
 {
-	CHECK_DISPOSED(m_disposed);
-	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
+	sqlite3* instance = nullptr;
 
-	if(CLRISNULL(callback)) throw gcnew ArgumentNullException("callback");
+	CLRASSERT(source != nullptr);
+	CLRASSERT(CLRISNOTNULL(path));
 
-	SQLiteSafeHandle::Reference instance(m_handle);
-	sqlite3_stmt* statement;
+	if(File::Exists(path)) File::Delete(path);
 
-	// cards view
-	auto sql = L"select * from cards where cardid in (select distinct cardid from ruling) order by name asc";
+	// Create the new database file (sqlite3_open16() implies SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE)
+	pin_ptr<wchar_t const> pinpath = PtrToStringChars(path);
+	int result = sqlite3_open16(pinpath, &instance);
+	if(result != SQLITE_OK) {
 
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+		if(instance != nullptr) sqlite3_close(instance);
+		throw gcnew SQLiteException(result);
+	}
 
 	try {
 
-		// Execute the query and iterate over all returned rows
-		result = sqlite3_step(statement);
-		while(result == SQLITE_ROW) {
+		// The file is discarded on failure so there is no need for a rollback journal
+		execute_non_query(instance, L"pragma journal_mode=off");
+		execute_non_query(instance, L"pragma synchronous=off");
 
-			try { callback->Invoke(row_cards(this, statement)); }
-			catch(Exception^) { /* DO NOTHING */ }
+		rebuild_utf8(source, instance);
+	}
 
-			result = sqlite3_step(statement);			// Move to the next result set row
-		}
+	catch(Exception^) {
 
-		// If the final result of the query was not SQLITE_DONE, something bad happened
-		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+		sqlite3_close(instance);
+		File::Delete(path);
+		throw;
 	}
 
-	finally { sqlite3_finalize(statement); }
+	sqlite3_close(instance);
 }
 
 //---------------------------------------------------------------------------
-// Database::EnumeratePrints
+// row_cards (local)
 //
-// Enumerates Prints from the database
+// Converts a row from a query against the cardsummary table into a Card object
 //
 // Arguments:
 //
-//	callback	- Action<> to invoke for each Print instance
+//	database		- Current Database instance
+//	identitymap		- Card identity map, or nullptr to bypass the map
+//	statement		- Current sqlite3_stmt pointer
 
-void Database::EnumeratePrints(Action<Print^>^ callback)
+static Card^ row_cards(Database^ database, IdentityMap<CardId^, Card^>^ identitymap, sqlite3_stmt* statement)
 {
-	CHECK_DISPOSED(m_disposed);
-	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
+	CLRASSERT(CLRISNOTNULL(database));
+	CLRASSERT(statement != nullptr);
 
-	if(CLRISNULL(callback)) throw gcnew ArgumentNullException("callback");
+	// Card instance to be returned to the caller for this result set row
+	Card^ card = nullptr;
 
-	SQLiteSafeHandle::Reference instance(m_handle);
-	sqlite3_stmt* statement;
+	// table: cardsummary
+	//
+	// { 00-06 } cardid | type | name | passcode | text | releasedate | artworkid
+	// { 07-12 } monsterattribute | monsterlevel | monstertype | monsterattack | monsterdefense | monsternormal 
+	// { 13-19 } monstereffect | monsterfusion | monsterritual | monstertoon | monsterunion | monsterspirit | monstergemini
+	// { 20-25 } spellnormal | spellcontinuous | spellequip | spellfield | spellquickplay | spellritual 
+	// { 26-28 } trapnormal | trapcontinuous | trapcounter
+	// { 29-29 } releaseday
+	CardId^ cardid = gcnew CardId(column_uuid(statement, 0));
 
-	// printid | cardid | seriesid | artworkid | code | language | number | rarity | limitededition | releasedate
-	auto sql = L"select print.printid, print.cardid, print.seriesid, print.artworkid, print.code, print.language, "
-		"print.number, printrarity(print.rarity), print.releasedate from print "
-		"order by print.releasedate asc";
+	// If the Card has already been created, return that instance instead
+	card = CLRISNOTNULL(identitymap) ? identitymap->Find(cardid) : nullptr;
+	if(CLRISNOTNULL(card)) return card;
 
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	// type
+	CardType type = static_cast<CardType>(sqlite3_column_int(statement, 1));
 
-	try {
+	// MonsterCard
+	if(type == CardType::Monster) {
 
-		// Execute the query and iterate over all returned rows
-		result = sqlite3_step(statement);
-		while(result == SQLITE_ROW) {
+		MonsterCard^ monster = gcnew MonsterCard(database, cardid);
 
-			// printid | cardid | seriesid | artworkid
-			Print^ print = gcnew Print(this, gcnew PrintId(column_uuid(statement, 0)),
-				gcnew CardId(column_uuid(statement, 1)), gcnew SeriesId(column_uuid(statement, 2)),
-				gcnew ArtworkId(column_uuid(statement, 3)));
+		monster->Attribute = static_cast<CardAttribute>(sqlite3_column_int(statement, 7));
+		monster->Level = sqlite3_column_int(statement, 8);
+		monster->Type = static_cast<MonsterType>(sqlite3_column_int(statement, 9));
+		monster->Attack = sqlite3_column_int(statement, 10);
+		monster->Defense = sqlite3_column_int(statement, 11);
+		monster->Normal = (sqlite3_column_int(statement, 12) != 0);
+		monster->Effect = (sqlite3_column_int(statement, 13) != 0);
+		monster->Fusion = (sqlite3_column_int(statement, 14) != 0);
+		monster->Ritual = (sqlite3_column_int(statement, 15) != 0);
+		monster->Toon = (sqlite3_column_int(statement, 16) != 0);
+		monster->Union = (sqlite3_column_int(statement, 17) != 0);
+		monster->Spirit = (sqlite3_column_int(statement, 18) != 0);
+		monster->Gemini = (sqlite3_column_int(statement, 19) != 0);
 
-			// code
-			print->Code = column_string(statement, 4);
+		card = static_cast<Card^>(monster);
+	}
 
-			// language
-			print->Language = column_string(statement, 5);
+	// SpellCard
+	else if(type == CardType::Spell) {
 
-			// number
-			print->Number = column_string(statement, 6);
+		SpellCard^ spell = gcnew SpellCard(database, cardid);
 
-			// rarity
-			print->Rarity = static_cast<PrintRarity>(sqlite3_column_int(statement, 7));
+		spell->Normal = (sqlite3_column_int(statement, 20) != 0);
+		spell->Continuous = (sqlite3_column_int(statement, 21) != 0);
+		spell->Equip = (sqlite3_column_int(statement, 22) != 0);
+		spell->Field = (sqlite3_column_int(statement, 23) != 0);
+		spell->QuickPlay = (sqlite3_column_int(statement, 24) != 0);
+		spell->Ritual = (sqlite3_column_int(statement, 25) != 0);
 
-			// limitededition
-			print->LimitedEdition = sqlite3_column_int(statement, 8) != 0;
+		card = static_cast<Card^>(spell);
+	}
 
-			// releasedate
-			wchar_t const* releasedateptr = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 9));
-			print->ReleaseDate = (releasedateptr == nullptr) ? DateTime::MinValue : DateTime::Parse(gcnew String(releasedateptr));
+	// TrapCard
+	else if(type == CardType::Trap) {
 
-			// Invoke the callback and just eat any exceptions that occur
-			try { callback->Invoke(print); }
-			catch(Exception^) { /* DO NOTHING */ }
+		TrapCard^ trap = gcnew TrapCard(database, cardid);
 
-			result = sqlite3_step(statement);			// Move to the next result set row
-		}
+		trap->Normal = (sqlite3_column_int(statement, 26) != 0);
+		trap->Continuous = (sqlite3_column_int(statement, 27) != 0);
+		trap->Counter = (sqlite3_column_int(statement, 28) != 0);
 
-		// If the final result of the query was not SQLITE_DONE, something bad happened
-		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+		card = static_cast<Card^>(trap);
 	}
 
-	finally { sqlite3_finalize(statement); }
+	// Verify that the Card instance has been set above
+	CLRASSERT(CLRISNOTNULL(card));
+
+	// name | passcode | text
+	card->Name = column_string(statement, 2);
+	card->Passcode = column_string(statement, 3);
+	card->Text = column_string(statement, 4);
+
+	// releaseday
+	card->ReleaseDate = column_day(statement, 29).GetValueOrDefault(DateTime::MinValue);
+
+	// artworkid
+	card->ArtworkID = gcnew ArtworkId(column_uuid(statement, 6));
+
+	return CLRISNOTNULL(identitymap) ? identitymap->Add(cardid, card) : card;
 }
 
 //---------------------------------------------------------------------------
-// Database::EnumerateRestrictionLists
+// row_artwork (local)
 //
-// Enumerates RestrictionLists from the database
+// Converts a row from a query against the artwork table into an Artwork object
 //
 // Arguments:
 //
-//	callback	- Action<> to invoke for each Print instance
+//	database		- Current Database instance
+//	strings			- Text column intern pool
+//	statement		- Current sqlite3_stmt pointer
 
-void Database::EnumerateRestrictionLists(Action<RestrictionList^>^ callback)
+static Artwork^ row_artwork(Database^ database, StringPool^ strings, sqlite3_stmt* statement)
 {
-	CHECK_DISPOSED(m_disposed);
-	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
-
-	if(CLRISNULL(callback)) throw gcnew ArgumentNullException("callback");
-
-	SQLiteSafeHandle::Reference instance(m_handle);
-	sqlite3_stmt* statement;
-
-	// restrictionlistid | effective | cardid | restriction
-	auto sql = L"select restrictionlist.restrictionlistid, restrictionlist.effective from restrictionlist "
-		"order by restrictionlist.effective desc";
-
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-
-	try {
+	CLRASSERT(CLRISNOTNULL(database));
+	CLRASSERT(CLRISNOTNULL(strings));
+	CLRASSERT(statement != nullptr);
 
-		// Execute the query and iterate over all returned rows
-		result = sqlite3_step(statement);
-		while(result == SQLITE_ROW) {
+	// table: artwork
+	//
+	// { 00-05 } artworkid | cardid | format | width | height | [image]
 
-			// restrictionlistid
-			RestrictionList^ restrictionlist = gcnew RestrictionList(this, gcnew RestrictionListId(column_uuid(statement, 0)));
+	// artworkid | cardid
+	Artwork^ artwork = gcnew Artwork(database, gcnew ArtworkId(column_uuid(statement, 0)), gcnew CardId(column_uuid(statement, 1)));
 
-			// effective
-			wchar_t const* effectiveptr = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 1));
-			restrictionlist->EffectiveDate = (effectiveptr == nullptr) ? DateTime::MaxValue : DateTime::Parse(gcnew String(effectiveptr));
+	// format
+	artwork->Format = column_string(statement, 2, strings);
 
-			// Invoke the callback and just eat any exceptions that occur
-			try { callback->Invoke(restrictionlist); }
-			catch(Exception^) { /* DO NOTHING */ }
+	// width
+	artwork->Width = sqlite3_column_int(statement, 3);
 
-			result = sqlite3_step(statement);			// Move to the next result set row
-		}
+	// height
+	artwork->Height = sqlite3_column_int(statement, 4);
 
-		// If the final result of the query was not SQLITE_DONE, something bad happened
-		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-	}
+	// image (optional); when not selected the image will be loaded on first access
+	if(sqlite3_column_count(statement) > 5) artwork->Image = column_blob(statement, 5);
 
-	finally { sqlite3_finalize(statement); }
+	return artwork;
 }
 
 //---------------------------------------------------------------------------
-// Database::EnumerateRulings
+// row_prints (local)
 //
-// Enumerates Rulings from the database
+// Converts a row from a query against the print table into a Print object
 //
 // Arguments:
 //
-//	callback	- Action<> to invoke for each Ruling instance
+//	database		- Current Database instance
+//	identitymap		- Print identity map, or nullptr to bypass the map
+//	strings			- Text column intern pool
+//	statement		- Current sqlite3_stmt pointer
 
-void Database::EnumerateRulings(Action<Ruling^>^ callback)
+static Print^ row_prints(Database^ database, IdentityMap<PrintId^, Print^>^ identitymap, StringPool^ strings, sqlite3_stmt* statement)
 {
-	CHECK_DISPOSED(m_disposed);
-	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
-
-	if(CLRISNULL(callback)) throw gcnew ArgumentNullException("callback");
-
-	SQLiteSafeHandle::Reference instance(m_handle);
-	sqlite3_stmt* statement;
+	CLRASSERT(CLRISNOTNULL(database));
+	CLRASSERT(CLRISNOTNULL(strings));
+	CLRASSERT(statement != nullptr);
 
-	// sequence | ruling
-	auto sql = L"select ruling.sequence, ruling.ruling from ruling order by ruling.cardid, ruling.sequence asc";
+	// table: print
+	//
+	// { 00-04 } printid | cardid | seriesid | artworkid | code
+	// { 05-09 } language | number | rarity | limitededition | releaseday
 
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	// printid
+	PrintId^ printid = gcnew PrintId(column_uuid(statement, 0));
 
-	try {
+	// If the Print has already been created, return that instance instead
+	Print^ print = CLRISNOTNULL(identitymap) ? identitymap->Find(printid) : nullptr;
+	if(CLRISNOTNULL(print)) return print;
 
-		// Execute the query and iterate over all returned rows
-		result = sqlite3_step(statement);
-		while(result == SQLITE_ROW) {
+	// cardid | seriesid | artworkid
+	print = gcnew Print(database, printid, gcnew CardId(column_uuid(statement, 1)), 
+		gcnew SeriesId(column_uuid(statement, 2)), gcnew ArtworkId(column_uuid(statement, 3)));
 
-			Ruling^ ruling = gcnew Ruling();
+	// code
+	print->Code = column_string(statement, 4);
 
-			// sequence
-			ruling->Sequence = sqlite3_column_int(statement, 0);
+	// language
+	print->Language = column_string(statement, 5, strings);
 
-			// text
-			ruling->Text = column_string(statement, 1);
+	// number
+	print->Number = column_string(statement, 6);
 
-			// Invoke the callback and just eat any exceptions that occur
-			try { callback->Invoke(ruling); }
-			catch(Exception^) { /* DO NOTHING */ }
+	// rarity
+	print->Rarity = static_cast<PrintRarity>(sqlite3_column_int(statement, 7));
 
-			result = sqlite3_step(statement);			// Move to the next result set row
-		}
+	// limitededition
+	print->LimitedEdition = sqlite3_column_int(statement, 8) != 0;
 
-		// If the final result of the query was not SQLITE_DONE, something bad happened
-		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-	}
+	// releaseday
+	print->ReleaseDate = column_day(statement, 9).GetValueOrDefault(DateTime::MinValue);
 
-	finally { sqlite3_finalize(statement); }
+	return CLRISNOTNULL(identitymap) ? identitymap->Add(printid, print) : print;
 }
 
 //---------------------------------------------------------------------------
-// Database::InitializeInstance (private, static)
+// row_series (local)
 //
-// Initializes the database instance for use
+// Converts a row from a query against the series table into a Series object
 //
 // Arguments:
 //
-//	handle		- SQLiteSafeHandle instance
+//	database		- Current Database instance
+//	identitymap		- Series identity map
+//	strings			- Text column intern pool
+//	statement		- Current sqlite3_stmt pointer
 
-void Database::InitializeInstance(SQLiteSafeHandle^ handle)
+static Series^ row_series(Database^ database, IdentityMap<SeriesId^, Series^>^ identitymap, StringPool^ strings, sqlite3_stmt* statement)
 {
-	if(CLRISNULL(handle)) throw gcnew ArgumentNullException("handle");
-	
-	SQLiteSafeHandle::Reference instance(handle);
+	CLRASSERT(CLRISNOTNULL(database));
+	CLRASSERT(CLRISNOTNULL(identitymap));
+	CLRASSERT(CLRISNOTNULL(strings));
+	CLRASSERT(statement != nullptr);
 
-	// Set the instance to report extended error codes
-	sqlite3_extended_result_codes(instance, TRUE);
+	// table: series
+	//
+	// { 00-04 } seriesid | code | name | boosterpack | releaseday
 
-	// Set a busy timeout handler for this connection
-	sqlite3_busy_timeout(instance, 5000);
+	// seriesid
+	SeriesId^ seriesid = gcnew SeriesId(column_uuid(statement, 0));
 
-	// Switch the database to write-ahead logging
-	execute_non_query(instance, L"pragma journal_mode=wal");
+	// If the Series has already been created, return that instance instead
+	Series^ series = identitymap->Find(seriesid);
+	if(CLRISNOTNULL(series)) return series;
 
-	// Switch the database to UTF-16 encoding
-	execute_non_query(instance, L"pragma encoding='UTF-16'");
+	series = gcnew Series(database, seriesid);
 
-	// Enable foreign key constraints
-	execute_non_query(instance, L"pragma foreign_keys=ON");
+	// code
+	series->Code = column_string(statement, 1);
 
-	// Get the database schema version
-	int dbversion = execute_scalar_int(instance, L"pragma user_version");
+	// name
+	series->Name = column_string(statement, 2, strings);
 
-	// SCHEMA VERSION 0 -> VERSION 1
-	//
-	// Original database schema
-	if(dbversion == 0) {
+	// boosterpack
+	series->BoosterPack = sqlite3_column_int(statement, 3) != 0;
 
-		// table: card
-		//
-		// cardid(pk) | name(u) | type | passcode(u) | text
-		execute_non_query(instance, L"create table card(cardid blob not null, name text unique not null, type text not null, "
-			"passcode text unique not null, text text not null, primary key(cardid), "
-			"check(type in ('Monster', 'Spell', 'Trap')))");
+	// releaseday
+	series->ReleaseDate = column_day(statement, 4);
 
-		// table: monster
-		//
-		// cardid(fk) | attribute | level | type | attack | defense | normal | effect | fusion | ritual | toon | union | spirit | gemini 
-		execute_non_query(instance, L"create table monster(cardid blob not null, attribute text not null, level integer not null, "
-			"type text not null, attack integer not null, defense integer not null, normal integer not null, effect integer not null, "
-			"fusion integer not null, ritual integer not null, toon integer not null, [union] integer not null, spirit integer not null, "
-			"gemini integer not null, foreign key(cardid) references card(cardid), "
-			"check(attribute in ('DARK', 'EARTH', 'FIRE', 'LIGHT', 'WATER', 'WIND')), "
-			"check(level between 1 and 12), check(attack between -1 and 5000), check(defense between -1 and 5000), "
-			"check(type in ('Aqua', 'Beast', 'Beast-Warrior', 'Dinosaur', 'Dragon', 'Fairy', 'Fiend', 'Fish', 'Insect', 'Machine', "
-			"  'Plant', 'Pyro', 'Reptile', 'Rock', 'Sea Serpent', 'Spellcaster', 'Thunder', 'Warrior', 'Winged Beast', 'Zombie')), "
-			"check(normal = 0 or (effect + fusion + ritual + toon + [union] + spirit + gemini = 0)), "
-			"check(fusion = 0 or (toon + [union] + spirit + gemini = 0)), "
-			"check(ritual = 0 or (toon + [union] + spirit + gemini = 0)), "
-			"check(toon = 0 or effect = 1), check([union] = 0 or effect = 1), check(spirit = 0 or effect = 1), "
-			"check(gemini = 0 or effect = 1))");
-		execute_non_query(instance, L"create index monster_attribute on monster(attribute)");
-		execute_non_query(instance, L"create index monster_level on monster(level)");
-		execute_non_query(instance, L"create index monster_type on monster(type)");
-		execute_non_query(instance, L"create index monster_attackdefense on monster(attack, defense)");
-		execute_non_query(instance, L"create index monster_flag on monster(normal, effect, fusion, ritual, toon, [union], spirit, gemini)");
+	return identitymap->Add(seriesid, series);
+}
 
-		// table: spell
-		//
-		// cardid(fk) | normal | continuous | equip | field | quickplay | ritual
-		execute_non_query(instance, L"create table spell(cardid blob not null, normal integer not null, continuous integer not null, "
-			"equip integer not null, field integer not null, quickplay integer not null, ritual integer not null, "
-			"foreign key(cardid) references card(cardid), "
-			"check(normal + continuous + equip + field + quickplay + ritual = 1))");
-		execute_non_query(instance, L"create index spell_flag on spell(normal, continuous, equip, field, quickplay, ritual)");
+//---------------------------------------------------------------------------
+// Database Static Constructor (private)
+//
+// Arguments:
+//
+//	NONE
+	
+static Database::Database()
+{
+	// Automatically register the built-in database extension library functions
+	s_result = sqlite3_auto_extension(reinterpret_cast<void(*)()>(sqlite3_extension_init));
+}
 
-		// table: trap
-		//
-		// cardid(fk) | normal | continuous | counter
-		execute_non_query(instance, L"create table trap(cardid blob not null, normal integer not null, continuous integer not null, "
-			"counter integer not null, foreign key(cardid) references card(cardid), "
-			"check(normal + continuous + counter = 1))");
-		execute_non_query(instance, L"create index trap_flag on trap(normal, continuous, counter)");
+//---------------------------------------------------------------------------
+// Database Constructor (private)
+//
+// Arguments:
+//
+//	handle		- SQLiteSafeHandle instance
+//	path		- Database file path for read-only connections
+//	readers		- Maximum number of read-only connections
+//	immutable	- Flag indicating the database was opened as immutable
 
-		// table: artwork
-		//
-		// artworkid(pk) | cardid(fk) | format | height | width | image
-		execute_non_query(instance, L"create table artwork(artworkid blob not null, cardid blob not null, format text not null,"
-			"height integer not null, width integer not null, image blob not null, primary key(artworkid), "
-			"foreign key(cardid) references card(cardid))");
+Database::Database(SQLiteSafeHandle^ handle, String^ path, int readers, bool immutable) : 
+	m_handle(handle), m_immutable(immutable)
+{
+	if(CLRISNULL(handle)) throw gcnew ArgumentNullException("handle");
 
-		// table: defaultartwork
-		//
-		// cardid(pk,fk) | artworkid(pk,fk)
-		execute_non_query(instance, L"create table defaultartwork(cardid blob not null, artworkid blob null, "
-			"primary key(cardid, artworkid), foreign key(cardid) references card(cardid), foreign key(artworkid) references artwork(artworkid))");
+	// Ensure that the static initialization completed successfully
+	if(s_result != SQLITE_OK)
+		throw gcnew Exception("Static initialization failed", gcnew SQLiteException(s_result));
 
-		// table: series
-		//
-		// seriesid(pk) | code(u) | name(u) | releasedate
-		execute_non_query(instance, L"create table series(seriesid blob not null, code text unique not null, name text unique not null, "
-			"releasedate text null, primary key(seriesid))");
-		execute_non_query(instance, L"create index series_releasedate on series(releasedate)");
+	m_pool = gcnew ConnectionPool(handle, path, readers, immutable);
 
-		// table: print
-		//
-		// printid(pk) | cardid(fk) | seriesid(fk) | artworkid(fk) | code | language | number | rarity | releasedate
-		execute_non_query(instance, L"create table print(printid blob not null, cardid blob not null, seriesid blob not null, "
-			"artworkid blob null, code text not null, language text null, number text not null, rarity text not null, releasedate not null, "
-			"primary key(printid), foreign key(cardid) references card(cardid), foreign key(seriesid) references series(seriesid), "
-			"foreign key(artworkid) references artwork(artworkid))");
-		execute_non_query(instance, L"create unique index print_code on print(code, language, number)");
-		execute_non_query(instance, L"create index print_rarity on print(rarity)");
-		execute_non_query(instance, L"create index print_releasedate on print(releasedate)");
+	m_cards = gcnew IdentityMap<CardId^, Card^>();
+	m_prints = gcnew IdentityMap<PrintId^, Print^>();
+	m_series = gcnew IdentityMap<SeriesId^, Series^>();
+	m_strings = gcnew StringPool(DEFAULT_STRING_POOL_CAPACITY);
+}
 
-		// table: restrictionlist
-		//
-		// restrictionlistid(pk) | effective
-		execute_non_query(instance, L"create table restrictionlist(restrictionlistid blob not null, effective text unique not null, "
-			"primary key(restrictionlistid))");
+//---------------------------------------------------------------------------
+// Database Destructor (private)
 
-		// table: restriction
-		//
-		// restrictionlistid(pk,fk) | cardid(pk,fk) | restriction
-		execute_non_query(instance, L"create table restriction(restrictionlistid blob not null, cardid blob not null, restriction integer not null, "
-			"primary key(restrictionlistid, cardid), foreign key(restrictionlistid) references restrictionlist(restrictionlistid), "
-			"foreign key(cardid) references card(cardid))");
+Database::~Database()
+{
+	if(m_disposed) return;
 
-		// table: ruling
-		//
-		// cardid(fk) | sequence | ruling
-		execute_non_query(instance, L"create table ruling(cardid blob not null, sequence integer not null, ruling text not null, "
-			"foreign key(cardid) references card(cardid))");
+	delete m_pool;						// Close the read-only connections
+	delete m_handle;					// Release the safe handle
+	delete m_strings;					// Release the intern pool
+	m_disposed = true;					// Object is now in a disposed state
+}
 
-		execute_non_query(instance, L"pragma user_version = 1");
-		dbversion = 1;
-	}
+//---------------------------------------------------------------------------
+// Database::CardCursor Constructor
+//
+// Arguments:
+//
+//	database	- Parent Database instance
+//	sql			- Query against the cardsummary table
+//	parameter	- Optional parameter to bind to the query
 
-	// SCHEMA VERSION 1 -> VERSION 2
-	//
-	// Corrects an incorrect PRIMARY KEY constraint on the defaultartwork table
-	if(dbversion == 1) {
+Database::CardCursor::CardCursor(Database^ database, String^ sql, Object^ parameter) : 
+	DatabaseCursor(database->m_pool, sql, database->m_batchsize), m_database(database), m_parameter(parameter)
+{
+}
 
-		// table: defaultartwork_v1
-		//
-		// cardid(pk,fk) | artworkid(pk,fk)
-		execute_non_query(instance, L"alter table defaultartwork rename to defaultartwork_v1");
+//---------------------------------------------------------------------------
+// Database::CardCursor::OnBind (protected)
+//
+// Binds the query parameters to a newly acquired statement
+//
+// Arguments:
+//
+//	statement	- Statement to bind the parameters to
 
-		// table: defaultartwork
-		//
-		// cardid(pk,fk) | artworkid(fk)
-		execute_non_query(instance, L"create table defaultartwork(cardid blob not null, artworkid blob not null, "
-			"primary key(cardid), foreign key(cardid) references card(cardid), foreign key(artworkid) references artwork(artworkid))");
+void Database::CardCursor::OnBind(sqlite3_stmt* statement)
+{
+	int paramindex = 1;
+	if(CLRISNOTNULL(m_parameter)) bind_parameter(statement, paramindex, m_parameter);
+}
+
+//---------------------------------------------------------------------------
+// Database::CardCursor::OnOpen (protected)
+//
+// Invoked before the statement is acquired for a new enumerator
+//
+// Arguments:
+//
+//	NONE
+
+void Database::CardCursor::OnOpen(void)
+{
+	CHECK_DISPOSED(m_database->m_disposed);
+}
+
+//---------------------------------------------------------------------------
+// Database::CardCursor::OnRead (protected)
+//
+// Converts the current result set row into an object instance
+//
+// Arguments:
+//
+//	statement	- Statement positioned on the row to convert
+//	version		- Change generation of the cursor snapshot
+
+Card^ Database::CardCursor::OnRead(sqlite3_stmt* statement, int64_t version)
+{
+	IdentityMap<CardId^, Card^>^ identitymap = m_database->m_cards;
+
+	// The cursor holds its snapshot open across every batch while other threads advance the
+	// identity map; rows from a snapshot that isn't the map's version bypass the map entirely
+	if(!m_database->m_immutable && ((version < 0) || !identitymap->Validate(version))) identitymap = nullptr;
+
+	return row_cards(m_database, identitymap, statement);
+}
+
+//---------------------------------------------------------------------------
+// Database::PrintCursor Constructor
+//
+// Arguments:
+//
+//	database	- Parent Database instance
+//	sql			- Query against the print table
+
+Database::PrintCursor::PrintCursor(Database^ database, String^ sql) : 
+	DatabaseCursor(database->m_pool, sql, database->m_batchsize), m_database(database)
+{
+}
+
+//---------------------------------------------------------------------------
+// Database::PrintCursor::OnOpen (protected)
+//
+// Invoked before the statement is acquired for a new enumerator
+//
+// Arguments:
+//
+//	NONE
+
+void Database::PrintCursor::OnOpen(void)
+{
+	CHECK_DISPOSED(m_database->m_disposed);
+}
+
+//---------------------------------------------------------------------------
+// Database::PrintCursor::OnRead (protected)
+//
+// Converts the current result set row into an object instance
+//
+// Arguments:
+//
+//	statement	- Statement positioned on the row to convert
+//	version		- Change generation of the cursor snapshot
+
+Print^ Database::PrintCursor::OnRead(sqlite3_stmt* statement, int64_t version)
+{
+	IdentityMap<PrintId^, Print^>^ identitymap = m_database->m_prints;
+
+	// The cursor holds its snapshot open across every batch while other threads advance the
+	// identity map; rows from a snapshot that isn't the map's version bypass the map entirely
+	if(!m_database->m_immutable && ((version < 0) || !identitymap->Validate(version))) identitymap = nullptr;
+
+	return row_prints(m_database, identitymap, m_database->m_strings, statement);
+}
+
+//---------------------------------------------------------------------------
+// Database::RulingCursor Constructor
+//
+// Arguments:
+//
+//	database	- Parent Database instance
+//	sql			- Query against the ruling table
+
+Database::RulingCursor::RulingCursor(Database^ database, String^ sql) : 
+	DatabaseCursor(database->m_pool, sql, database->m_batchsize)
+{
+}
+
+//---------------------------------------------------------------------------
+// Database::RulingCursor::OnRead (protected)
+//
+// Converts the current result set row into an object instance
+//
+// Arguments:
+//
+//	statement	- Statement positioned on the row to convert
+//	version		- Change generation of the cursor snapshot
+
+Ruling^ Database::RulingCursor::OnRead(sqlite3_stmt* statement, int64_t version)
+{
+	(void)version;
+
+	Ruling^ ruling = gcnew Ruling();
+
+	// sequence
+	ruling->Sequence = sqlite3_column_int(statement, 0);
+
+	// text
+	ruling->Text = column_string(statement, 1);
+
+	return ruling;
+}
+
+//---------------------------------------------------------------------------
+// Database::BeginBatch
+//
+// Begins a unit of work that groups the updates made on this thread into a
+// single transaction until it is committed or disposed of
+//
+// Arguments:
+//
+//	NONE
+
+DatabaseBatch^ Database::BeginBatch(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
+
+	return gcnew DatabaseBatch(m_pool);
+}
+
+//---------------------------------------------------------------------------
+// Database::CursorBatchSize::get
+//
+// Gets the number of rows read at a time by enumerable query results
+
+int Database::CursorBatchSize::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return m_batchsize;
+}
+
+//---------------------------------------------------------------------------
+// Database::CursorBatchSize::set
+//
+// Sets the number of rows read at a time by enumerable query results
+
+void Database::CursorBatchSize::set(int value)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if(value <= 0) throw gcnew ArgumentOutOfRangeException("value");
+	m_batchsize = value;
+}
+
+//---------------------------------------------------------------------------
+// Database::EnumerateArtwork
+//
+// Enumerates Artwork from the database
+//
+// Arguments:
+//
+//	callback	- Action<> to invoke for each Artwork instance
+
+void Database::EnumerateArtwork(Action<Artwork^>^ callback)
+{
+	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
+
+	if(CLRISNULL(callback)) throw gcnew ArgumentNullException("callback");
+
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Read);
+
+	// artworkid | cardid | format | width | height
+	auto sql = L"select artworkid, cardid, format, width, height from artwork";
+
+	// Acquire the prepared query from the statement cache
+	sqlite3_stmt* statement = instance.Statements->Acquire(instance, sql);
+	int result = SQLITE_OK;
+
+	try {
+
+		// Execute the query and iterate over all returned rows
+		result = sqlite3_step(statement);
+		while(result == SQLITE_ROW) {
+
+			Artwork^ artwork = row_artwork(this, m_strings, statement);
+
+			// Invoke the callback and just eat any exceptions that occur
+			try { callback->Invoke(artwork); }
+			catch(Exception^) { /* DO NOTHING */ }
+
+			result = sqlite3_step(statement);			// Move to the next result set row
+		}
+
+		// If the final result of the query was not SQLITE_DONE, something bad happened
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	}
+
+	finally { instance.Statements->Release(statement); }
+}
+
+//---------------------------------------------------------------------------
+// Database::EnumerateCards
+//
+// Enumerates Cards from the database
+//
+// Arguments:
+//
+//	callback	- Action<> to invoke for each Card instance
+
+void Database::EnumerateCards(Action<Card^>^ callback)
+{
+	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
+
+	if(CLRISNULL(callback)) throw gcnew ArgumentNullException("callback");
+
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Read);
+
+	// Discard any cached objects if the database has changed
+	ValidateIdentityMaps();
+
+	// cardsummary table
+	auto sql = L"select * from cardsummary order by name asc";
+
+	sqlite3_stmt* statement = instance.Statements->Acquire(instance, sql);
+	int result = SQLITE_OK;
+
+	try {
+
+		// Execute the query and iterate over all returned rows
+		result = sqlite3_step(statement);
+		while(result == SQLITE_ROW) {
+
+			try { callback->Invoke(row_cards(this, m_cards, statement)); }
+			catch(Exception^) { /* DO NOTHING */ }
+
+			result = sqlite3_step(statement);			// Move to the next result set row
+		}
+
+		// If the final result of the query was not SQLITE_DONE, something bad happened
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	}
+
+	finally { instance.Statements->Release(statement); }
+}
+
+//---------------------------------------------------------------------------
+// Database::EnumerateCards
+//
+// Enumerates Cards from the database
+//
+// Arguments:
+//
+//	callback	- Action<> to invoke for each Card instance
+//	releasedate	- Maximum release date for the card
+
+void Database::EnumerateCards(DateTime releasedate, Action<Card^>^ callback)
+{
+	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
+
+	if(CLRISNULL(callback)) throw gcnew ArgumentNullException("callback");
+
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Read);
+
+	// Discard any cached objects if the database has changed
+	ValidateIdentityMaps();
+
+	// cardsummary table
+	auto sql = L"select * from cardsummary where releaseday <= ?1 order by name asc";
+
+	sqlite3_stmt* statement = instance.Statements->Acquire(instance, sql);
+	int result = SQLITE_OK;
+
+	try {
+
+		// Bind the query parameter(s)
+		result = sqlite3_bind_int(statement, 1, ReleaseIndex::ToDay(releasedate));
+		if(result != SQLITE_OK) throw gcnew SQLiteException(result);
+
+		// Execute the query and iterate over all returned rows
+		result = sqlite3_step(statement);
+		while(result == SQLITE_ROW) {
+
+			// Invoke the callback and just eat any exceptions that occur
+			try { callback->Invoke(row_cards(this, m_cards, statement)); }
+			catch(Exception^) { /* DO NOTHING */ }
+
+			result = sqlite3_step(statement);			// Move to the next result set row
+		}
+
+		// If the final result of the query was not SQLITE_DONE, something bad happened
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	}
+
+	finally { instance.Statements->Release(statement); }
+}
+
+//---------------------------------------------------------------------------
+// Database::EnumerateCards
+//
+// Enumerates Cards from the database
+//
+// Arguments:
+//
+//	NONE
+
+IEnumerable<Card^>^ Database::EnumerateCards(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	// cardsummary table
+	return gcnew CardCursor(this, "select * from cardsummary order by name asc", nullptr);
+}
+
+//---------------------------------------------------------------------------
+// Database::EnumerateCards
+//
+// Enumerates Cards from the database
+//
+// Arguments:
+//
+//	releasedate		- Maximum release date of the cards to enumerate
+
+IEnumerable<Card^>^ Database::EnumerateCards(DateTime releasedate)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	// cardsummary table
+	return gcnew CardCursor(this, "select * from cardsummary where releaseday <= ?1 order by name asc", 
+		ReleaseIndex::ToDay(releasedate));
+}
+
+//---------------------------------------------------------------------------
+// Database::EnumerateCards
+//
+// Enumerates Cards from the database; a dedicated reader thread fills a bounded
+// queue that is drained by a set of parallel consumers
+//
+// Arguments:
+//
+//	callback	- Callback to invoke for each Card; invoked concurrently
+//	capacity	- Maximum number of Cards queued ahead of the consumers
+//	consumers	- Number of parallel consumers
+
+void Database::EnumerateCards(Action<Card^>^ callback, int capacity, int consumers)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if(CLRISNULL(callback)) throw gcnew ArgumentNullException("callback");
+
+	ParallelEnumerator<Card^>^ enumerator = gcnew ParallelEnumerator<Card^>(EnumerateCards(), callback, capacity, consumers);
+	enumerator->Run();
+}
+
+//---------------------------------------------------------------------------
+// Database::EnumerateCardsAsOf
+//
+// Enumerates the Cards released as of a date and their restriction at that date
+//
+// Arguments:
+//
+//	date		- Date at which to evaluate the cards
+//	callback	- Callback function to invoke for each card
+
+void Database::EnumerateCardsAsOf(DateTime date, Action<Card^, Restriction>^ callback)
+{
+	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
+
+	if(CLRISNULL(callback)) throw gcnew ArgumentNullException("callback");
+
+	ReleaseIndex^ index = nullptr;
+
+	// The lease is only required to validate and (re)load the index
+	{
+		ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Read);
+
+		// Discard any cached objects if the database has changed
+		int64_t version = ValidateIdentityMaps();
+
+		index = GetReleaseIndex(instance, version);
+	}
+
+	index->Enumerate(date, callback);
+}
+
+//---------------------------------------------------------------------------
+// Database::EnumerateCardsWithRulings
+//
+// Enumerates Cards from the database that have Rulings
+//
+// Arguments:
+//
+//	callback	- Action<> to invoke for each Card instance
+
+void Database::EnumerateCardsWithRulings(Action<Card^>^ callback)
+{
+	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
+
+	if(CLRISNULL(callback)) throw gcnew ArgumentNullException("callback");
+
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Read);
+
+	// Discard any cached objects if the database has changed
+	ValidateIdentityMaps();
+
+	// cardsummary table
+	auto sql = L"select * from cardsummary where cardid in (select distinct cardid from ruling) order by name asc";
+
+	sqlite3_stmt* statement = instance.Statements->Acquire(instance, sql);
+	int result = SQLITE_OK;
+
+	try {
+
+		// Execute the query and iterate over all returned rows
+		result = sqlite3_step(statement);
+		while(result == SQLITE_ROW) {
+
+			try { callback->Invoke(row_cards(this, m_cards, statement)); }
+			catch(Exception^) { /* DO NOTHING */ }
+
+			result = sqlite3_step(statement);			// Move to the next result set row
+		}
+
+		// If the final result of the query was not SQLITE_DONE, something bad happened
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	}
+
+	finally { instance.Statements->Release(statement); }
+}
+
+//---------------------------------------------------------------------------
+// Database::EnumerateCardsWithRulings
+//
+// Enumerates Cards from the database that have Rulings
+//
+// Arguments:
+//
+//	NONE
+
+IEnumerable<Card^>^ Database::EnumerateCardsWithRulings(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	// cardsummary table
+	return gcnew CardCursor(this, "select * from cardsummary where cardid in (select distinct cardid from ruling) order by name asc", nullptr);
+}
+
+//---------------------------------------------------------------------------
+// Database::EnumeratePrints
+//
+// Enumerates Prints from the database
+//
+// Arguments:
+//
+//	callback	- Action<> to invoke for each Print instance
+
+void Database::EnumeratePrints(Action<Print^>^ callback)
+{
+	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
+
+	if(CLRISNULL(callback)) throw gcnew ArgumentNullException("callback");
+
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Read);
+
+	// Discard any cached objects if the database has changed
+	ValidateIdentityMaps();
+
+	// printid | cardid | seriesid | artworkid | code | language | number | rarity | limitededition | releaseday
+	auto sql = L"select print.printid, print.cardid, print.seriesid, print.artworkid, print.code, print.language, "
+		"print.number, print.rarity, print.limitededition, print.releaseday from print "
+		"order by print.releaseday asc";
+
+	sqlite3_stmt* statement = instance.Statements->Acquire(instance, sql);
+	int result = SQLITE_OK;
+
+	try {
+
+		// Execute the query and iterate over all returned rows
+		result = sqlite3_step(statement);
+		while(result == SQLITE_ROW) {
+
+			Print^ print = row_prints(this, m_prints, m_strings, statement);
+
+			// Invoke the callback and just eat any exceptions that occur
+			try { callback->Invoke(print); }
+			catch(Exception^) { /* DO NOTHING */ }
+
+			result = sqlite3_step(statement);			// Move to the next result set row
+		}
+
+		// If the final result of the query was not SQLITE_DONE, something bad happened
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	}
+
+	finally { instance.Statements->Release(statement); }
+}
+
+//---------------------------------------------------------------------------
+// Database::EnumeratePrints
+//
+// Enumerates Prints from the database
+//
+// Arguments:
+//
+//	NONE
+
+IEnumerable<Print^>^ Database::EnumeratePrints(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	// printid | cardid | seriesid | artworkid | code | language | number | rarity | limitededition | releaseday
+	return gcnew PrintCursor(this, "select print.printid, print.cardid, print.seriesid, print.artworkid, print.code, print.language, "
+		"print.number, print.rarity, print.limitededition, print.releaseday from print "
+		"order by print.releaseday asc");
+}
+
+//---------------------------------------------------------------------------
+// Database::EnumeratePrints
+//
+// Enumerates Prints from the database; a dedicated reader thread fills a bounded
+// queue that is drained by a set of parallel consumers
+//
+// Arguments:
+//
+//	callback	- Callback to invoke for each Print; invoked concurrently
+//	capacity	- Maximum number of Prints queued ahead of the consumers
+//	consumers	- Number of parallel consumers
+
+void Database::EnumeratePrints(Action<Print^>^ callback, int capacity, int consumers)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if(CLRISNULL(callback)) throw gcnew ArgumentNullException("callback");
+
+	ParallelEnumerator<Print^>^ enumerator = gcnew ParallelEnumerator<Print^>(EnumeratePrints(), callback, capacity, consumers);
+	enumerator->Run();
+}
+
+//---------------------------------------------------------------------------
+// Database::EnumerateRestrictionLists
+//
+// Enumerates RestrictionLists from the database
+//
+// Arguments:
+//
+//	callback	- Action<> to invoke for each Print instance
+
+void Database::EnumerateRestrictionLists(Action<RestrictionList^>^ callback)
+{
+	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
+
+	if(CLRISNULL(callback)) throw gcnew ArgumentNullException("callback");
+
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Read);
+
+	// restrictionlistid | effectiveday
+	auto sql = L"select restrictionlist.restrictionlistid, restrictionlist.effectiveday from restrictionlist "
+		"order by restrictionlist.effectiveday desc";
+
+	sqlite3_stmt* statement = instance.Statements->Acquire(instance, sql);
+	int result = SQLITE_OK;
+
+	try {
+
+		// Execute the query and iterate over all returned rows
+		result = sqlite3_step(statement);
+		while(result == SQLITE_ROW) {
+
+			// restrictionlistid
+			RestrictionList^ restrictionlist = gcnew RestrictionList(this, gcnew RestrictionListId(column_uuid(statement, 0)));
+
+			// effectiveday
+			restrictionlist->EffectiveDate = column_day(statement, 1).GetValueOrDefault(DateTime::MaxValue);
+
+			// Invoke the callback and just eat any exceptions that occur
+			try { callback->Invoke(restrictionlist); }
+			catch(Exception^) { /* DO NOTHING */ }
+
+			result = sqlite3_step(statement);			// Move to the next result set row
+		}
+
+		// If the final result of the query was not SQLITE_DONE, something bad happened
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	}
+
+	finally { instance.Statements->Release(statement); }
+}
+
+//---------------------------------------------------------------------------
+// Database::EnumerateRulings
+//
+// Enumerates Rulings from the database
+//
+// Arguments:
+//
+//	callback	- Action<> to invoke for each Ruling instance
+
+void Database::EnumerateRulings(Action<Ruling^>^ callback)
+{
+	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
+
+	if(CLRISNULL(callback)) throw gcnew ArgumentNullException("callback");
+
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Read);
+
+	// sequence | ruling
+	auto sql = L"select ruling.sequence, ruling.ruling from ruling order by ruling.cardid, ruling.sequence asc";
+
+	sqlite3_stmt* statement = instance.Statements->Acquire(instance, sql);
+	int result = SQLITE_OK;
+
+	try {
+
+		// Execute the query and iterate over all returned rows
+		result = sqlite3_step(statement);
+		while(result == SQLITE_ROW) {
+
+			Ruling^ ruling = gcnew Ruling();
+
+			// sequence
+			ruling->Sequence = sqlite3_column_int(statement, 0);
+
+			// text
+			ruling->Text = column_string(statement, 1);
+
+			// Invoke the callback and just eat any exceptions that occur
+			try { callback->Invoke(ruling); }
+			catch(Exception^) { /* DO NOTHING */ }
+
+			result = sqlite3_step(statement);			// Move to the next result set row
+		}
+
+		// If the final result of the query was not SQLITE_DONE, something bad happened
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	}
+
+	finally { instance.Statements->Release(statement); }
+}
+
+//---------------------------------------------------------------------------
+// Database::EnumerateRulings
+//
+// Enumerates Rulings from the database
+//
+// Arguments:
+//
+//	NONE
+
+IEnumerable<Ruling^>^ Database::EnumerateRulings(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	// sequence | ruling
+	return gcnew RulingCursor(this, "select ruling.sequence, ruling.ruling from ruling order by ruling.cardid, ruling.sequence asc");
+}
+
+//---------------------------------------------------------------------------
+// Database::GetArtwork
+//
+// Gets the Artwork associated with a collection of Cards
+//
+// Arguments:
+//
+//	cards		- Collection of Card instances
+
+Dictionary<Card^, List<Artwork^>^>^ Database::GetArtwork(IEnumerable<Card^>^ cards)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if(CLRISNULL(cards)) throw gcnew ArgumentNullException("cards");
+
+	// Map each card identifier back to the Card instance that provided it
+	Dictionary<CardId^, Card^>^ cardids = gcnew Dictionary<CardId^, Card^>();
+	for each(Card^ card in cards) if(CLRISNOTNULL(card)) cardids[card->CardID] = card;
+
+	Dictionary<Card^, List<Artwork^>^>^ artwork = gcnew Dictionary<Card^, List<Artwork^>^>();
+	for each(KeyValuePair<CardId^, List<Artwork^>^> item in SelectArtwork(cardids->Keys))
+		artwork->Add(cardids[item.Key], item.Value);
+
+	return artwork;
+}
+
+//---------------------------------------------------------------------------
+// Database::GetRulings
+//
+// Gets the Rulings associated with a collection of Cards
+//
+// Arguments:
+//
+//	cards		- Collection of Card instances
+
+Dictionary<Card^, List<Ruling^>^>^ Database::GetRulings(IEnumerable<Card^>^ cards)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if(CLRISNULL(cards)) throw gcnew ArgumentNullException("cards");
+
+	// Map each card identifier back to the Card instance that provided it
+	Dictionary<CardId^, Card^>^ cardids = gcnew Dictionary<CardId^, Card^>();
+	for each(Card^ card in cards) if(CLRISNOTNULL(card)) cardids[card->CardID] = card;
+
+	Dictionary<Card^, List<Ruling^>^>^ rulings = gcnew Dictionary<Card^, List<Ruling^>^>();
+	for each(KeyValuePair<CardId^, List<Ruling^>^> item in SelectRulings(cardids->Keys))
+		rulings->Add(cardids[item.Key], item.Value);
+
+	return rulings;
+}
+
+//---------------------------------------------------------------------------
+// Database::GetReleaseIndex (private)
+//
+// Gets the as-of-date index for a database version, loading it as necessary
+//
+// Arguments:
+//
+//	instance	- Leased database connection
+//	version		- Current database version from ValidateIdentityMaps
+
+ReleaseIndex^ Database::GetReleaseIndex(ConnectionPool::Lease% instance, int64_t version)
+{
+	// Reuse the existing index if the database has not changed since it was loaded;
+	// concurrent loads are harmless, the last index loaded replaces the others
+	ReleaseIndex^ index = m_releaseindex;
+	if(CLRISNOTNULL(index) && (index->Version == version)) return index;
+
+	List<Card^>^ cards = gcnew List<Card^>();
+	List<int>^ releasedays = gcnew List<int>();
+	List<int>^ effectivedays = gcnew List<int>();
+	List<Dictionary<CardId^, Restriction>^>^ restrictions = gcnew List<Dictionary<CardId^, Restriction>^>();
+
+	// cardsummary table
+	auto sql = L"select * from cardsummary where releaseday is not null order by releaseday asc, name asc";
+
+	sqlite3_stmt* statement = instance.Statements->Acquire(instance, sql);
+	int result = SQLITE_OK;
+
+	try {
+
+		// Execute the query and iterate over all returned rows
+		result = sqlite3_step(statement);
+		while(result == SQLITE_ROW) {
+
+			cards->Add(row_cards(this, m_cards, statement));
+			releasedays->Add(sqlite3_column_int(statement, 29));
+
+			result = sqlite3_step(statement);			// Move to the next result set row
+		}
+
+		// If the final result of the query was not SQLITE_DONE, something bad happened
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	}
+
+	finally { instance.Statements->Release(statement); }
+
+	// restrictionlist / restriction tables
+	//
+	// effectiveday | cardid | restriction
+	sql = L"select restrictionlist.effectiveday, restriction.cardid, restriction.restriction from restrictionlist "
+		"left outer join restriction on restrictionlist.restrictionlistid = restriction.restrictionlistid "
+		"order by restrictionlist.effectiveday asc";
+
+	statement = instance.Statements->Acquire(instance, sql);
+
+	try {
+
+		int effectiveday = -1;
+		Dictionary<CardId^, Restriction>^ restriction = nullptr;
+
+		// Execute the query and iterate over all returned rows
+		result = sqlite3_step(statement);
+		while(result == SQLITE_ROW) {
+
+			// Each distinct effective date starts a new restriction list interval
+			int rowday = sqlite3_column_int(statement, 0);
+			if(rowday != effectiveday) {
+
+				effectiveday = rowday;
+				restriction = gcnew Dictionary<CardId^, Restriction>();
+
+				effectivedays->Add(effectiveday);
+				restrictions->Add(restriction);
+			}
+
+			// A restriction list without any restricted cards has a single row with null card columns
+			if(sqlite3_column_type(statement, 1) != SQLITE_NULL)
+				restriction->Add(gcnew CardId(column_uuid(statement, 1)), static_cast<Restriction>(sqlite3_column_int(statement, 2)));
+
+			result = sqlite3_step(statement);			// Move to the next result set row
+		}
+
+		// If the final result of the query was not SQLITE_DONE, something bad happened
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	}
+
+	finally { instance.Statements->Release(statement); }
+
+	index = gcnew ReleaseIndex(version, cards, releasedays, effectivedays, restrictions);
+	m_releaseindex = index;
+
+	return index;
+}
+
+//---------------------------------------------------------------------------
+// Database::InitializeInstance (private, static)
+//
+// Initializes the database instance for use
+//
+// Arguments:
+//
+//	handle		- SQLiteSafeHandle instance
+
+void Database::InitializeInstance(SQLiteSafeHandle^ handle)
+{
+	if(CLRISNULL(handle)) throw gcnew ArgumentNullException("handle");
+	
+	SQLiteSafeHandle::Reference instance(handle);
+
+	// Set the instance to report extended error codes
+	sqlite3_extended_result_codes(instance, TRUE);
+
+	// Set a busy timeout handler for this connection
+	sqlite3_busy_timeout(instance, 5000);
+
+	// Switch the database to write-ahead logging
+	execute_non_query(instance, L"pragma journal_mode=wal");
+
+	// Switch the database to UTF-8 encoding; this only applies to new databases
+	execute_non_query(instance, L"pragma encoding='UTF-8'");
+
+	// Enable foreign key constraints
+	execute_non_query(instance, L"pragma foreign_keys=ON");
+
+	// Get the database schema version
+	int dbversion = execute_scalar_int(instance, L"pragma user_version");
+
+	// SCHEMA VERSION 0 -> VERSION 1
+	//
+	// Original database schema
+	if(dbversion == 0) {
+
+		// table: card
+		//
+		// cardid(pk) | name(u) | type | passcode(u) | text
+		execute_non_query(instance, L"create table card(cardid blob not null, name text unique not null, type text not null, "
+			"passcode text unique not null, text text not null, primary key(cardid), "
+			"check(type in ('Monster', 'Spell', 'Trap')))");
+
+		// table: monster
+		//
+		// cardid(fk) | attribute | level | type | attack | defense | normal | effect | fusion | ritual | toon | union | spirit | gemini 
+		execute_non_query(instance, L"create table monster(cardid blob not null, attribute text not null, level integer not null, "
+			"type text not null, attack integer not null, defense integer not null, normal integer not null, effect integer not null, "
+			"fusion integer not null, ritual integer not null, toon integer not null, [union] integer not null, spirit integer not null, "
+			"gemini integer not null, foreign key(cardid) references card(cardid), "
+			"check(attribute in ('DARK', 'EARTH', 'FIRE', 'LIGHT', 'WATER', 'WIND')), "
+			"check(level between 1 and 12), check(attack between -1 and 5000), check(defense between -1 and 5000), "
+			"check(type in ('Aqua', 'Beast', 'Beast-Warrior', 'Dinosaur', 'Dragon', 'Fairy', 'Fiend', 'Fish', 'Insect', 'Machine', "
+			"  'Plant', 'Pyro', 'Reptile', 'Rock', 'Sea Serpent', 'Spellcaster', 'Thunder', 'Warrior', 'Winged Beast', 'Zombie')), "
+			"check(normal = 0 or (effect + fusion + ritual + toon + [union] + spirit + gemini = 0)), "
+			"check(fusion = 0 or (toon + [union] + spirit + gemini = 0)), "
+			"check(ritual = 0 or (toon + [union] + spirit + gemini = 0)), "
+			"check(toon = 0 or effect = 1), check([union] = 0 or effect = 1), check(spirit = 0 or effect = 1), "
+			"check(gemini = 0 or effect = 1))");
+		execute_non_query(instance, L"create index monster_attribute on monster(attribute)");
+		execute_non_query(instance, L"create index monster_level on monster(level)");
+		execute_non_query(instance, L"create index monster_type on monster(type)");
+		execute_non_query(instance, L"create index monster_attackdefense on monster(attack, defense)");
+		execute_non_query(instance, L"create index monster_flag on monster(normal, effect, fusion, ritual, toon, [union], spirit, gemini)");
+
+		// table: spell
+		//
+		// cardid(fk) | normal | continuous | equip | field | quickplay | ritual
+		execute_non_query(instance, L"create table spell(cardid blob not null, normal integer not null, continuous integer not null, "
+			"equip integer not null, field integer not null, quickplay integer not null, ritual integer not null, "
+			"foreign key(cardid) references card(cardid), "
+			"check(normal + continuous + equip + field + quickplay + ritual = 1))");
+		execute_non_query(instance, L"create index spell_flag on spell(normal, continuous, equip, field, quickplay, ritual)");
+
+		// table: trap
+		//
+		// cardid(fk) | normal | continuous | counter
+		execute_non_query(instance, L"create table trap(cardid blob not null, normal integer not null, continuous integer not null, "
+			"counter integer not null, foreign key(cardid) references card(cardid), "
+			"check(normal + continuous + counter = 1))");
+		execute_non_query(instance, L"create index trap_flag on trap(normal, continuous, counter)");
+
+		// table: artwork
+		//
+		// artworkid(pk) | cardid(fk) | format | height | width | image
+		execute_non_query(instance, L"create table artwork(artworkid blob not null, cardid blob not null, format text not null,"
+			"height integer not null, width integer not null, image blob not null, primary key(artworkid), "
+			"foreign key(cardid) references card(cardid))");
+
+		// table: defaultartwork
+		//
+		// cardid(pk,fk) | artworkid(pk,fk)
+		execute_non_query(instance, L"create table defaultartwork(cardid blob not null, artworkid blob null, "
+			"primary key(cardid, artworkid), foreign key(cardid) references card(cardid), foreign key(artworkid) references artwork(artworkid))");
+
+		// table: series
+		//
+		// seriesid(pk) | code(u) | name(u) | releasedate
+		execute_non_query(instance, L"create table series(seriesid blob not null, code text unique not null, name text unique not null, "
+			"releasedate text null, primary key(seriesid))");
+		execute_non_query(instance, L"create index series_releasedate on series(releasedate)");
+
+		// table: print
+		//
+		// printid(pk) | cardid(fk) | seriesid(fk) | artworkid(fk) | code | language | number | rarity | releasedate
+		execute_non_query(instance, L"create table print(printid blob not null, cardid blob not null, seriesid blob not null, "
+			"artworkid blob null, code text not null, language text null, number text not null, rarity text not null, releasedate not null, "
+			"primary key(printid), foreign key(cardid) references card(cardid), foreign key(seriesid) references series(seriesid), "
+			"foreign key(artworkid) references artwork(artworkid))");
+		execute_non_query(instance, L"create unique index print_code on print(code, language, number)");
+		execute_non_query(instance, L"create index print_rarity on print(rarity)");
+		execute_non_query(instance, L"create index print_releasedate on print(releasedate)");
+
+		// table: restrictionlist
+		//
+		// restrictionlistid(pk) | effective
+		execute_non_query(instance, L"create table restrictionlist(restrictionlistid blob not null, effective text unique not null, "
+			"primary key(restrictionlistid))");
+
+		// table: restriction
+		//
+		// restrictionlistid(pk,fk) | cardid(pk,fk) | restriction
+		execute_non_query(instance, L"create table restriction(restrictionlistid blob not null, cardid blob not null, restriction integer not null, "
+			"primary key(restrictionlistid, cardid), foreign key(restrictionlistid) references restrictionlist(restrictionlistid), "
+			"foreign key(cardid) references card(cardid))");
+
+		// table: ruling
+		//
+		// cardid(fk) | sequence | ruling
+		execute_non_query(instance, L"create table ruling(cardid blob not null, sequence integer not null, ruling text not null, "
+			"foreign key(cardid) references card(cardid))");
+
+		execute_non_query(instance, L"pragma user_version = 1");
+		dbversion = 1;
+	}
+
+	// SCHEMA VERSION 1 -> VERSION 2
+	//
+	// Corrects an incorrect PRIMARY KEY constraint on the defaultartwork table
+	if(dbversion == 1) {
+
+		// table: defaultartwork_v1
+		//
+		// cardid(pk,fk) | artworkid(pk,fk)
+		execute_non_query(instance, L"alter table defaultartwork rename to defaultartwork_v1");
+
+		// table: defaultartwork
+		//
+		// cardid(pk,fk) | artworkid(fk)
+		execute_non_query(instance, L"create table defaultartwork(cardid blob not null, artworkid blob not null, "
+			"primary key(cardid), foreign key(cardid) references card(cardid), foreign key(artworkid) references artwork(artworkid))");
 
 		// Remove any NULL artworkid values from the old table, move the data into the new table, and drop the old table
 		execute_non_query(instance, L"delete from defaultartwork_v1 where artworkid is null");
 		execute_non_query(instance, L"insert into defaultartwork select v1.cardid, v1.artworkid from defaultartwork_v1 as v1");
 		execute_non_query(instance, L"drop table defaultartwork_v1");
 
-		execute_non_query(instance, L"pragma user_version = 2");
-		dbversion = 2;
-	}
+		execute_non_query(instance, L"pragma user_version = 2");
+		dbversion = 2;
+	}
+
+	// SCHEMA VERSION 2 -> VERSION 3
+	//
+	// Adds missing CHECK constraint on print.rarity
+	// Adds limitededition column to print table
+	// Adds boosterpack column to series table
+	if(dbversion == 2) {
+
+		// Disable foreign keys during the update
+		execute_non_query(instance, L"pragma foreign_keys=OFF");
+
+		// table: series_v2
+		//
+		// seriesid(pk) | code(u) | name(u) | releasedate
+		execute_non_query(instance, L"alter table series rename to series_v2");
+		execute_non_query(instance, L"drop index if exists series_releasedate");
+
+		// table: series
+		//
+		// seriesid(pk) | code(u) | name(u) | boosterpack | releasedate
+		execute_non_query(instance, L"create table series(seriesid blob not null, code text unique not null, name text unique not null, "
+			"boosterpack integer not null, releasedate text null, primary key(seriesid))");
+		execute_non_query(instance, L"create index series_releasedate on series(releasedate)");
+
+		// Move the data from series_v2 into series
+		execute_non_query(instance, L"insert into series select v2.seriesid, v2.code, v2.name, 0, v2.releasedate from series_v2 as v2");
+		execute_non_query(instance, L"update series set boosterpack = 1 where code in ('LOB', 'MRD', 'SRL', 'PSV', 'LON', 'LOD', 'PGD', "
+			"'MFC', 'DCR', 'IOC', 'AST', 'SOD', 'RDS', 'FET', 'TLM', 'CRV', 'EEN', 'SOI', 'EOJ', 'POTD', 'CDIP', 'STON', 'FOTB', 'TAEV', "
+			"'GLAS', 'PTDN', 'LOTD')");
+		
+		// Drop the series_v2 table
+		execute_non_query(instance, L"drop table series_v2");
+
+		// table: print_v2
+		//
+		// printid(pk) | cardid(fk) | seriesid(fk) | artworkid(fk) | code | language | number | rarity | releasedate
+		execute_non_query(instance, L"alter table print rename to print_v2");
+		execute_non_query(instance, L"drop index if exists print_code");
+		execute_non_query(instance, L"drop index if exists print_rarity");
+		execute_non_query(instance, L"drop index if exists print_releasedate");
+
+		// table: print
+		//
+		// printid(pk) | cardid(fk) | seriesid(fk) | artworkid(fk) | code | language | number | rarity | limitededition | releasedate
+		execute_non_query(instance, L"create table print(printid blob not null, cardid blob not null, seriesid blob not null, "
+			"artworkid blob null, code text not null, language text null, number text not null, rarity text not null, limitededition integer not null, "
+			"releasedate text not null, primary key(printid), foreign key(cardid) references card(cardid), foreign key(seriesid) references series(seriesid), "
+			"foreign key(artworkid) references artwork(artworkid) "
+			"check(rarity in ('Common', 'Gold Rare', 'Parallel Rare', 'Prismatic Secret Rare', 'Rare', 'Secret Rare', 'Super Rare', 'Ultra Parallel Rare', "
+			"'Ultra Rare')))");
+		execute_non_query(instance, L"create unique index print_code on print(code, language, number)");
+		execute_non_query(instance, L"create index print_rarity on print(rarity)");
+		execute_non_query(instance, L"create index print_releasedate on print(releasedate)");
+
+		// Move the data from print_v2 into print
+		execute_non_query(instance, L"insert into print select v2.printid, v2.cardid, v2.seriesid, v2.artworkid, v2.code, v2.language, v2.number, "
+			"v2.rarity, 0, v2.releasedate from print_v2 as v2");
+
+		// Drop the print_v2 table
+		execute_non_query(instance, L"drop table print_v2");
+
+		// Enable foreign keys after the update
+		execute_non_query(instance, L"pragma foreign_keys=ON");
+
+		execute_non_query(instance, L"pragma user_version = 3");
+		dbversion = 3;
+	}
+
+	// SCHEMA VERSION 3 -> VERSION 4
+	//
+	// Add primary keys to the monstercard, spellcard, and trapcard tables
+	// Alter restriction.restriction column into text ('Forbidden', 'Limited', 'Semi-Limited')
+	// Add primary key to the ruling table
+	// Add indexes on print.cardid and print.seriesid columns
+	if(dbversion == 3) {
+
+		// Disable foreign keys during the update
+		execute_non_query(instance, L"pragma foreign_keys=OFF");
+
+		// table: monster_v3
+		//
+		// cardid(fk) | attribute | level | type | attack | defense | normal | effect | fusion | ritual | toon | union | spirit | gemini 
+		execute_non_query(instance, L"alter table monster rename to monster_v3");
+		execute_non_query(instance, L"drop index if exists monster_attribute");
+		execute_non_query(instance, L"drop index if exists monster_level");
+		execute_non_query(instance, L"drop index if exists monster_type");
+		execute_non_query(instance, L"drop index if exists monster_attackdefense");
+		execute_non_query(instance, L"drop index if exists monster_flag");
+
+		// table: monster
+		//
+		// cardid(pk,fk) | attribute | level | type | attack | defense | normal | effect | fusion | ritual | toon | union | spirit | gemini 
+		execute_non_query(instance, L"create table monster(cardid blob not null, attribute text not null, level integer not null, "
+			"type text not null, attack integer not null, defense integer not null, normal integer not null, effect integer not null, "
+			"fusion integer not null, ritual integer not null, toon integer not null, [union] integer not null, spirit integer not null, "
+			"gemini integer not null, primary key(cardid), foreign key(cardid) references card(cardid), "
+			"check(attribute in ('DARK', 'EARTH', 'FIRE', 'LIGHT', 'WATER', 'WIND')), "
+			"check(level between 1 and 12), check(attack between -1 and 5000), check(defense between -1 and 5000), "
+			"check(type in ('Aqua', 'Beast', 'Beast-Warrior', 'Dinosaur', 'Dragon', 'Fairy', 'Fiend', 'Fish', 'Insect', 'Machine', "
+			"  'Plant', 'Pyro', 'Reptile', 'Rock', 'Sea Serpent', 'Spellcaster', 'Thunder', 'Warrior', 'Winged Beast', 'Zombie')), "
+			"check(normal = 0 or (effect + fusion + ritual + toon + [union] + spirit + gemini = 0)), "
+			"check(fusion = 0 or (toon + [union] + spirit + gemini = 0)), "
+			"check(ritual = 0 or (toon + [union] + spirit + gemini = 0)), "
+			"check(toon = 0 or effect = 1), check([union] = 0 or effect = 1), check(spirit = 0 or effect = 1), "
+			"check(gemini = 0 or effect = 1))");
+		execute_non_query(instance, L"create index monster_attribute on monster(attribute)");
+		execute_non_query(instance, L"create index monster_level on monster(level)");
+		execute_non_query(instance, L"create index monster_type on monster(type)");
+		execute_non_query(instance, L"create index monster_attackdefense on monster(attack, defense)");
+		execute_non_query(instance, L"create index monster_flag on monster(normal, effect, fusion, ritual, toon, [union], spirit, gemini)");
+
+		// Move the data from monster_v3 into monster
+		execute_non_query(instance, L"insert into monster select v3.cardid, v3.attribute, v3.level, v3.type, v3.attack, v3.defense, v3.normal, "
+			"v3.effect, v3.fusion, v3.ritual, v3.toon, v3.[union], v3.spirit, v3.gemini from monster_v3 as v3");
+			
+		// Drop the monster_v3 table
+		execute_non_query(instance, L"drop table monster_v3");
+
+		// table: spell_v3
+		//
+		// cardid(fk) | normal | continuous | equip | field | quickplay | ritual
+		execute_non_query(instance, L"alter table spell rename to spell_v3");
+		execute_non_query(instance, L"drop index if exists spell_flag");
+
+		// table: spell
+		//
+		// cardid(pk,fk) | normal | continuous | equip | field | quickplay | ritual
+		execute_non_query(instance, L"create table spell(cardid blob not null, normal integer not null, continuous integer not null, "
+			"equip integer not null, field integer not null, quickplay integer not null, ritual integer not null, "
+			"primary key(cardid), foreign key(cardid) references card(cardid), "
+			"check(normal + continuous + equip + field + quickplay + ritual = 1))");
+		execute_non_query(instance, L"create index spell_flag on spell(normal, continuous, equip, field, quickplay, ritual)");
+
+		// Move the data from spell_v3 into spell
+		execute_non_query(instance, L"insert into spell select v3.cardid, v3.normal, v3.continuous, v3.equip, v3.field, v3.quickplay, "
+			"v3.ritual from spell_v3 as v3");
+
+		// Drop the spell_v3 table
+		execute_non_query(instance, L"drop table spell_v3");
+
+		// table: trap_v3
+		//
+		// cardid(fk) | normal | continuous | counter
+		execute_non_query(instance, L"alter table trap rename to trap_v3");
+		execute_non_query(instance, L"drop index if exists trap_flag");
+
+		// table: trap
+		//
+		// cardid(pk, fk) | normal | continuous | counter
+		execute_non_query(instance, L"create table trap(cardid blob not null, normal integer not null, continuous integer not null, "
+			"counter integer not null, primary key(cardid), foreign key(cardid) references card(cardid), "
+			"check(normal + continuous + counter = 1))");
+		execute_non_query(instance, L"create index trap_flag on trap(normal, continuous, counter)");
+
+		// Move the data from trap_v3 into trap
+		execute_non_query(instance, L"insert into trap select v3.cardid, v3.normal, v3.continuous, v3.counter from trap_v3 as v3");
+
+		// Drop the trap_v3 table
+		execute_non_query(instance, L"drop table trap_v3");
+
+		// table: restriction_v3
+		//
+		// restrictionlistid(pk,fk) | cardid(pk,fk) | restriction
+		execute_non_query(instance, L"alter table restriction rename to restriction_v3");
+
+		// table: restriction
+		//
+		// restrictionlistid(pk,fk) | cardid(pk,fk) | restriction
+		execute_non_query(instance, L"create table restriction(restrictionlistid blob not null, cardid blob not null, restriction text not null, "
+			"primary key(restrictionlistid, cardid), foreign key(restrictionlistid) references restrictionlist(restrictionlistid), "
+			"foreign key(cardid) references card(cardid), check(restriction in ('Forbidden', 'Limited', 'Semi-Limited')))");
+
+		// Move the data from restriction_v3 into restriction
+		execute_non_query(instance, L"insert into restriction select v3.restrictionlistid, v3.cardid, "
+			"case v3.restriction when 0 then 'Forbidden' when 1 then 'Limited' when 2 then 'Semi-Limited' else 'Unknown' end as restriction "
+			"from restriction_v3 as v3");
+
+		// Drop the restriction_v3 table
+		execute_non_query(instance, L"drop table restriction_v3");
+
+		// table: ruling_v3
+		//
+		// cardid(fk) | sequence | ruling
+		execute_non_query(instance, L"alter table ruling rename to ruling_v3");
+
+		// table: ruling
+		//
+		// cardid(pk,fk) | sequence(pk) | ruling
+		execute_non_query(instance, L"create table ruling(cardid blob not null, sequence integer not null, ruling text not null, "
+			"primary key(cardid, sequence), foreign key(cardid) references card(cardid))");
+
+		// Move the data from ruling_v3 into ruling
+		execute_non_query(instance, L"insert into ruling select v3.cardid, v3.sequence, v3.ruling from ruling_v3 as v3");
+
+		// Drop the ruling_v3 table
+		execute_non_query(instance, L"drop table ruling_v3");
+
+		// index: print_cardid
+		execute_non_query(instance, L"create index print_cardid on print(cardid)");
+
+		// index: print_seriesid
+		execute_non_query(instance, L"create index print_seriesid on print(seriesid)");
+
+		// Enable foreign keys after the update
+		execute_non_query(instance, L"pragma foreign_keys=ON");
+
+		execute_non_query(instance, L"pragma user_version = 4");
+		dbversion = 4;
+	}
+
+	// SCHEMA VERSION 4 -> VERSION 5
+	//
+	// Drop unused indexes
+	// Add index on artwork.cardid column
+	// Add unique index on series.code column
+	if(dbversion == 4) {
+
+		// Drop unused indexes
+		execute_non_query(instance, L"drop index if exists monster_attribute");
+		execute_non_query(instance, L"drop index if exists monster_level");
+		execute_non_query(instance, L"drop index if exists monster_type");
+		execute_non_query(instance, L"drop index if exists monster_attackdefense");
+		execute_non_query(instance, L"drop index if exists monster_flag");
+		execute_non_query(instance, L"drop index if exists spell_flag");
+		execute_non_query(instance, L"drop index if exists trap_flag");
+		execute_non_query(instance, L"drop index if exists print_rarity");
+
+		// index: artwork.cardid
+		execute_non_query(instance, L"create index artwork_cardid on artwork(cardid)");
+
+		// unique index: series.code
+		execute_non_query(instance, L"create unique index series_code on series(code)");
+
+		execute_non_query(instance, L"pragma user_version = 5");
+		execute_non_query(instance, L"vacuum");
+		dbversion = 5;
+	}
+
+	// SCHEMA VERSION 5 -> VERSION 6
+	//
+	// Add cardsummary_source view and materialized cardsummary table
+	// Add triggers to maintain the cardsummary table
+	if(dbversion == 5) {
+
+		// view: cardsummary_source
+		//
+		// Denormalizes the card, monster, spell, trap and defaultartwork tables into a flat view
+		// and also provides the minimum release date for each card for filtering; this is the
+		// source used to build and maintain the materialized cardsummary table
+		execute_non_query(instance, L"create view cardsummary_source(cardid, type, name, passcode, text, releasedate, "
+			"artworkid, monsterattribute, monsterlevel, monstertype, monsterattack, monsterdefense, monsternormal, "
+			"monstereffect, monsterfusion, monsterritual, monstertoon, monsterunion, monsterspirit, monstergemini, "
+			"spellnormal, spellcontinuous, spellequip, spellfield, spellquickplay, spellritual, "
+			"trapnormal, trapcontinuous, trapcounter) as "
+			"select card.cardid, cardtype(card.type), card.name, card.passcode, card.text, "
+			"(select min(print.releasedate) from print where print.cardid = card.cardid), defaultartwork.artworkid, "
+			"cardattribute(monster.attribute), monster.level, monstertype(monster.type), monster.attack, "
+			"monster.defense, monster.normal, monster.effect, monster.fusion, monster.ritual, "
+			"monster.toon, monster.[union], monster.spirit, monster.gemini, "
+			"spell.normal, spell.continuous, spell.equip, spell.field, spell.quickplay, spell.ritual, "
+			"trap.normal, trap.continuous, trap.counter from card "
+			"left outer join defaultartwork on card.cardid = defaultartwork.cardid "
+			"left outer join monster on card.cardid = monster.cardid "
+			"left outer join spell on card.cardid = spell.cardid "
+			"left outer join trap on card.cardid = trap.cardid");
+
+		// table: cardsummary
+		//
+		// { 00-06 } cardid(pk) | type | name | passcode | text | releasedate | artworkid
+		// { 07-12 } monsterattribute | monsterlevel | monstertype | monsterattack | monsterdefense | monsternormal 
+		// { 13-19 } monstereffect | monsterfusion | monsterritual | monstertoon | monsterunion | monsterspirit | monstergemini
+		// { 20-25 } spellnormal | spellcontinuous | spellequip | spellfield | spellquickplay | spellritual 
+		// { 26-28 } trapnormal | trapcontinuous | trapcounter
+		execute_non_query(instance, L"create table cardsummary(cardid blob not null, type integer not null, name text not null, "
+			"passcode text null, text text null, releasedate text null, artworkid blob null, monsterattribute integer null, "
+			"monsterlevel integer null, monstertype integer null, monsterattack integer null, monsterdefense integer null, "
+			"monsternormal integer null, monstereffect integer null, monsterfusion integer null, monsterritual integer null, "
+			"monstertoon integer null, monsterunion integer null, monsterspirit integer null, monstergemini integer null, "
+			"spellnormal integer null, spellcontinuous integer null, spellequip integer null, spellfield integer null, "
+			"spellquickplay integer null, spellritual integer null, trapnormal integer null, trapcontinuous integer null, "
+			"trapcounter integer null, primary key(cardid))");
+		execute_non_query(instance, L"create index cardsummary_name on cardsummary(name)");
+		execute_non_query(instance, L"create index cardsummary_releasedate on cardsummary(releasedate)");
+
+		// Build the cardsummary table from the existing data
+		execute_non_query(instance, L"insert into cardsummary select * from cardsummary_source");
+
+		// triggers: card
+		execute_non_query(instance, L"create trigger cardsummary_card_insert after insert on card begin "
+			"insert into cardsummary select * from cardsummary_source where cardid = new.cardid; end");
+		execute_non_query(instance, L"create trigger cardsummary_card_update after update on card begin "
+			"delete from cardsummary where cardid = old.cardid; "
+			"insert or replace into cardsummary select * from cardsummary_source where cardid = new.cardid; end");
+		execute_non_query(instance, L"create trigger cardsummary_card_delete after delete on card begin "
+			"delete from cardsummary where cardid = old.cardid; end");
+
+		// triggers: monster
+		execute_non_query(instance, L"create trigger cardsummary_monster_insert after insert on monster begin "
+			"insert or replace into cardsummary select * from cardsummary_source where cardid = new.cardid; end");
+		execute_non_query(instance, L"create trigger cardsummary_monster_update after update on monster begin "
+			"insert or replace into cardsummary select * from cardsummary_source where cardid in (old.cardid, new.cardid); end");
+		execute_non_query(instance, L"create trigger cardsummary_monster_delete after delete on monster begin "
+			"insert or replace into cardsummary select * from cardsummary_source where cardid = old.cardid; end");
+
+		// triggers: spell
+		execute_non_query(instance, L"create trigger cardsummary_spell_insert after insert on spell begin "
+			"insert or replace into cardsummary select * from cardsummary_source where cardid = new.cardid; end");
+		execute_non_query(instance, L"create trigger cardsummary_spell_update after update on spell begin "
+			"insert or replace into cardsummary select * from cardsummary_source where cardid in (old.cardid, new.cardid); end");
+		execute_non_query(instance, L"create trigger cardsummary_spell_delete after delete on spell begin "
+			"insert or replace into cardsummary select * from cardsummary_source where cardid = old.cardid; end");
+
+		// triggers: trap
+		execute_non_query(instance, L"create trigger cardsummary_trap_insert after insert on trap begin "
+			"insert or replace into cardsummary select * from cardsummary_source where cardid = new.cardid; end");
+		execute_non_query(instance, L"create trigger cardsummary_trap_update after update on trap begin "
+			"insert or replace into cardsummary select * from cardsummary_source where cardid in (old.cardid, new.cardid); end");
+		execute_non_query(instance, L"create trigger cardsummary_trap_delete after delete on trap begin "
+			"insert or replace into cardsummary select * from cardsummary_source where cardid = old.cardid; end");
+
+		// triggers: defaultartwork
+		execute_non_query(instance, L"create trigger cardsummary_defaultartwork_insert after insert on defaultartwork begin "
+			"update cardsummary set artworkid = new.artworkid where cardid = new.cardid; end");
+		execute_non_query(instance, L"create trigger cardsummary_defaultartwork_update after update on defaultartwork begin "
+			"update cardsummary set artworkid = null where cardid = old.cardid; "
+			"update cardsummary set artworkid = new.artworkid where cardid = new.cardid; end");
+		execute_non_query(instance, L"create trigger cardsummary_defaultartwork_delete after delete on defaultartwork begin "
+			"update cardsummary set artworkid = null where cardid = old.cardid; end");
+
+		// triggers: print
+		execute_non_query(instance, L"create trigger cardsummary_print_insert after insert on print begin "
+			"update cardsummary set releasedate = (select min(releasedate) from print where cardid = new.cardid) "
+			"where cardid = new.cardid; end");
+		execute_non_query(instance, L"create trigger cardsummary_print_update after update of cardid, releasedate on print begin "
+			"update cardsummary set releasedate = (select min(releasedate) from print where cardid = old.cardid) "
+			"where cardid = old.cardid; "
+			"update cardsummary set releasedate = (select min(releasedate) from print where cardid = new.cardid) "
+			"where cardid = new.cardid; end");
+		execute_non_query(instance, L"create trigger cardsummary_print_delete after delete on print begin "
+			"update cardsummary set releasedate = (select min(releasedate) from print where cardid = old.cardid) "
+			"where cardid = old.cardid; end");
+
+		execute_non_query(instance, L"pragma user_version = 6");
+		dbversion = 6;
+	}
+
+	// SCHEMA VERSION 6 -> VERSION 7
+	//
+	// UTF-8 storage encoding
+	if(dbversion == 6) {
+
+		// The encoding of an existing database can't be changed in place; writable UTF-16 databases
+		// are rebuilt as UTF-8 by Open() and OpenInMemory() before the instance is initialized
+		if(execute_scalar_int(instance, L"select encoding = 'UTF-8' from pragma_encoding") != 1)
+			throw gcnew Exception("Database must be rebuilt with UTF-8 encoding before it can be upgraded");
+
+		execute_non_query(instance, L"pragma user_version = 7");
+		dbversion = 7;
+	}
+
+	// SCHEMA VERSION 7 -> VERSION 8
+	//
+	// Alter card.type, monster.attribute, monster.type, print.rarity and restriction.restriction into integers
+	// Recreate the cardsummary_source view and triggers without the text conversion functions
+	if(dbversion == 7) {
+
+		// Disable foreign keys during the update; legacy ALTER TABLE behavior prevents the
+		// references to the renamed tables in other tables and triggers from being rewritten
+		execute_non_query(instance, L"pragma foreign_keys=OFF");
+		execute_non_query(instance, L"pragma legacy_alter_table=ON");
+
+		// Drop the cardsummary_source view, it is recreated after the tables have been updated
+		execute_non_query(instance, L"drop view if exists cardsummary_source");
+
+		// table: card_v7
+		//
+		// cardid(pk) | name(u) | type | passcode(u) | text
+		execute_non_query(instance, L"alter table card rename to card_v7");
+
+		// table: card
+		//
+		// cardid(pk) | name(u) | type | passcode(u) | text
+		execute_non_query(instance, L"create table card(cardid blob not null, name text unique not null, type integer not null, "
+			"passcode text unique not null, text text not null, primary key(cardid), check(type between 1 and 3))");
+
+		// Move the data from card_v7 into card
+		execute_non_query(instance, L"insert into card select v7.cardid, v7.name, cardtype(v7.type), v7.passcode, v7.text from card_v7 as v7");
+
+		// Drop the card_v7 table
+		execute_non_query(instance, L"drop table card_v7");
+
+		// table: monster_v7
+		//
+		// cardid(pk,fk) | attribute | level | type | attack | defense | normal | effect | fusion | ritual | toon | union | spirit | gemini 
+		execute_non_query(instance, L"alter table monster rename to monster_v7");
+
+		// table: monster
+		//
+		// cardid(pk,fk) | attribute | level | type | attack | defense | normal | effect | fusion | ritual | toon | union | spirit | gemini 
+		execute_non_query(instance, L"create table monster(cardid blob not null, attribute integer not null, level integer not null, "
+			"type integer not null, attack integer not null, defense integer not null, normal integer not null, effect integer not null, "
+			"fusion integer not null, ritual integer not null, toon integer not null, [union] integer not null, spirit integer not null, "
+			"gemini integer not null, primary key(cardid), foreign key(cardid) references card(cardid), "
+			"check(attribute in (1, 2, 3, 4, 7, 8)), check(level between 1 and 12), check(attack between -1 and 5000), "
+			"check(defense between -1 and 5000), check(type between 1 and 20), "
+			"check(normal = 0 or (effect + fusion + ritual + toon + [union] + spirit + gemini = 0)), "
+			"check(fusion = 0 or (toon + [union] + spirit + gemini = 0)), "
+			"check(ritual = 0 or (toon + [union] + spirit + gemini = 0)), "
+			"check(toon = 0 or effect = 1), check([union] = 0 or effect = 1), check(spirit = 0 or effect = 1), "
+			"check(gemini = 0 or effect = 1))");
+
+		// Move the data from monster_v7 into monster
+		execute_non_query(instance, L"insert into monster select v7.cardid, cardattribute(v7.attribute), v7.level, monstertype(v7.type), "
+			"v7.attack, v7.defense, v7.normal, v7.effect, v7.fusion, v7.ritual, v7.toon, v7.[union], v7.spirit, v7.gemini from monster_v7 as v7");
+
+		// Drop the monster_v7 table
+		execute_non_query(instance, L"drop table monster_v7");
+
+		// table: print_v7
+		//
+		// printid(pk) | cardid(fk) | seriesid(fk) | artworkid(fk) | code | language | number | rarity | limitededition | releasedate
+		execute_non_query(instance, L"alter table print rename to print_v7");
+		execute_non_query(instance, L"drop index if exists print_cardid");
+		execute_non_query(instance, L"drop index if exists print_code");
+		execute_non_query(instance, L"drop index if exists print_releasedate");
+		execute_non_query(instance, L"drop index if exists print_seriesid");
+
+		// table: print
+		//
+		// printid(pk) | cardid(fk) | seriesid(fk) | artworkid(fk) | code | language | number | rarity | limitededition | releasedate
+		execute_non_query(instance, L"create table print(printid blob not null, cardid blob not null, seriesid blob not null, "
+			"artworkid blob null, code text not null, language text null, number text not null, rarity integer not null, limitededition integer not null, "
+			"releasedate text not null, primary key(printid), foreign key(cardid) references card(cardid), foreign key(seriesid) references series(seriesid), "
+			"foreign key(artworkid) references artwork(artworkid), check(rarity between 1 and 9))");
+		execute_non_query(instance, L"create index print_cardid on print(cardid)");
+		execute_non_query(instance, L"create unique index print_code on print(code, language, number)");
+		execute_non_query(instance, L"create index print_releasedate on print(releasedate)");
+		execute_non_query(instance, L"create index print_seriesid on print(seriesid)");
+
+		// Move the data from print_v7 into print
+		execute_non_query(instance, L"insert into print select v7.printid, v7.cardid, v7.seriesid, v7.artworkid, v7.code, v7.language, v7.number, "
+			"printrarity(v7.rarity), v7.limitededition, v7.releasedate from print_v7 as v7");
+
+		// Drop the print_v7 table
+		execute_non_query(instance, L"drop table print_v7");
+
+		// table: restriction_v7
+		//
+		// restrictionlistid(pk,fk) | cardid(pk,fk) | restriction
+		execute_non_query(instance, L"alter table restriction rename to restriction_v7");
+
+		// table: restriction
+		//
+		// restrictionlistid(pk,fk) | cardid(pk,fk) | restriction
+		execute_non_query(instance, L"create table restriction(restrictionlistid blob not null, cardid blob not null, restriction integer not null, "
+			"primary key(restrictionlistid, cardid), foreign key(restrictionlistid) references restrictionlist(restrictionlistid), "
+			"foreign key(cardid) references card(cardid), check(restriction between 0 and 2))");
+
+		// Move the data from restriction_v7 into restriction
+		execute_non_query(instance, L"insert into restriction select v7.restrictionlistid, v7.cardid, restriction(v7.restriction) "
+			"from restriction_v7 as v7");
+
+		// Drop the restriction_v7 table
+		execute_non_query(instance, L"drop table restriction_v7");
+
+		// view: cardsummary_source
+		//
+		// Denormalizes the card, monster, spell, trap and defaultartwork tables into a flat view
+		// and also provides the minimum release date for each card for filtering; this is the
+		// source used to build and maintain the materialized cardsummary table
+		execute_non_query(instance, L"create view cardsummary_source(cardid, type, name, passcode, text, releasedate, "
+			"artworkid, monsterattribute, monsterlevel, monstertype, monsterattack, monsterdefense, monsternormal, "
+			"monstereffect, monsterfusion, monsterritual, monstertoon, monsterunion, monsterspirit, monstergemini, "
+			"spellnormal, spellcontinuous, spellequip, spellfield, spellquickplay, spellritual, "
+			"trapnormal, trapcontinuous, trapcounter) as "
+			"select card.cardid, card.type, card.name, card.passcode, card.text, "
+			"(select min(print.releasedate) from print where print.cardid = card.cardid), defaultartwork.artworkid, "
+			"monster.attribute, monster.level, monster.type, monster.attack, "
+			"monster.defense, monster.normal, monster.effect, monster.fusion, monster.ritual, "
+			"monster.toon, monster.[union], monster.spirit, monster.gemini, "
+			"spell.normal, spell.continuous, spell.equip, spell.field, spell.quickplay, spell.ritual, "
+			"trap.normal, trap.continuous, trap.counter from card "
+			"left outer join defaultartwork on card.cardid = defaultartwork.cardid "
+			"left outer join monster on card.cardid = monster.cardid "
+			"left outer join spell on card.cardid = spell.cardid "
+			"left outer join trap on card.cardid = trap.cardid");
+
+		// triggers: card (dropped with the card_v7 table)
+		execute_non_query(instance, L"create trigger cardsummary_card_insert after insert on card begin "
+			"insert into cardsummary select * from cardsummary_source where cardid = new.cardid; end");
+		execute_non_query(instance, L"create trigger cardsummary_card_update after update on card begin "
+			"delete from cardsummary where cardid = old.cardid; "
+			"insert or replace into cardsummary select * from cardsummary_source where cardid = new.cardid; end");
+		execute_non_query(instance, L"create trigger cardsummary_card_delete after delete on card begin "
+			"delete from cardsummary where cardid = old.cardid; end");
+
+		// triggers: monster (dropped with the monster_v7 table)
+		execute_non_query(instance, L"create trigger cardsummary_monster_insert after insert on monster begin "
+			"insert or replace into cardsummary select * from cardsummary_source where cardid = new.cardid; end");
+		execute_non_query(instance, L"create trigger cardsummary_monster_update after update on monster begin "
+			"insert or replace into cardsummary select * from cardsummary_source where cardid in (old.cardid, new.cardid); end");
+		execute_non_query(instance, L"create trigger cardsummary_monster_delete after delete on monster begin "
+			"insert or replace into cardsummary select * from cardsummary_source where cardid = old.cardid; end");
+
+		// triggers: print (dropped with the print_v7 table)
+		execute_non_query(instance, L"create trigger cardsummary_print_insert after insert on print begin "
+			"update cardsummary set releasedate = (select min(releasedate) from print where cardid = new.cardid) "
+			"where cardid = new.cardid; end");
+		execute_non_query(instance, L"create trigger cardsummary_print_update after update of cardid, releasedate on print begin "
+			"update cardsummary set releasedate = (select min(releasedate) from print where cardid = old.cardid) "
+			"where cardid = old.cardid; "
+			"update cardsummary set releasedate = (select min(releasedate) from print where cardid = new.cardid) "
+			"where cardid = new.cardid; end");
+		execute_non_query(instance, L"create trigger cardsummary_print_delete after delete on print begin "
+			"update cardsummary set releasedate = (select min(releasedate) from print where cardid = old.cardid) "
+			"where cardid = old.cardid; end");
+
+		// Restore ALTER TABLE behavior and enable foreign keys after the update
+		execute_non_query(instance, L"pragma legacy_alter_table=OFF");
+		execute_non_query(instance, L"pragma foreign_keys=ON");
+
+		execute_non_query(instance, L"pragma user_version = 8");
+		dbversion = 8;
+	}
+
+	// SCHEMA VERSION 8 -> VERSION 9
+	//
+	// Rebuild the small, frequently accessed tables as WITHOUT ROWID tables clustered on their keys
+	// Cluster the print table on (cardid, printid) and drop the redundant print_cardid index
+	// Recreate the cardsummary triggers that are dropped along with the original tables
+	if(dbversion == 8) {
+
+		// Disable foreign keys during the update; legacy ALTER TABLE behavior prevents the
+		// references to the renamed tables in other tables and triggers from being rewritten
+		execute_non_query(instance, L"pragma foreign_keys=OFF");
+		execute_non_query(instance, L"pragma legacy_alter_table=ON");
+
+		// table: monster_v8
+		//
+		// cardid(pk,fk) | attribute | level | type | attack | defense | normal | effect | fusion | ritual | toon | union | spirit | gemini 
+		execute_non_query(instance, L"alter table monster rename to monster_v8");
+
+		// table: monster
+		//
+		// cardid(pk,fk) | attribute | level | type | attack | defense | normal | effect | fusion | ritual | toon | union | spirit | gemini 
+		execute_non_query(instance, L"create table monster(cardid blob not null, attribute integer not null, level integer not null, "
+			"type integer not null, attack integer not null, defense integer not null, normal integer not null, effect integer not null, "
+			"fusion integer not null, ritual integer not null, toon integer not null, [union] integer not null, spirit integer not null, "
+			"gemini integer not null, primary key(cardid), foreign key(cardid) references card(cardid), "
+			"check(attribute in (1, 2, 3, 4, 7, 8)), check(level between 1 and 12), check(attack between -1 and 5000), "
+			"check(defense between -1 and 5000), check(type between 1 and 20), "
+			"check(normal = 0 or (effect + fusion + ritual + toon + [union] + spirit + gemini = 0)), "
+			"check(fusion = 0 or (toon + [union] + spirit + gemini = 0)), "
+			"check(ritual = 0 or (toon + [union] + spirit + gemini = 0)), "
+			"check(toon = 0 or effect = 1), check([union] = 0 or effect = 1), check(spirit = 0 or effect = 1), "
+			"check(gemini = 0 or effect = 1)) without rowid");
+
+		// Move the data from monster_v8 into monster
+		execute_non_query(instance, L"insert into monster select v8.cardid, v8.attribute, v8.level, v8.type, v8.attack, v8.defense, v8.normal, "
+			"v8.effect, v8.fusion, v8.ritual, v8.toon, v8.[union], v8.spirit, v8.gemini from monster_v8 as v8");
+
+		// Drop the monster_v8 table
+		execute_non_query(instance, L"drop table monster_v8");
+
+		// table: spell_v8
+		//
+		// cardid(pk,fk) | normal | continuous | equip | field | quickplay | ritual
+		execute_non_query(instance, L"alter table spell rename to spell_v8");
+
+		// table: spell
+		//
+		// cardid(pk,fk) | normal | continuous | equip | field | quickplay | ritual
+		execute_non_query(instance, L"create table spell(cardid blob not null, normal integer not null, continuous integer not null, "
+			"equip integer not null, field integer not null, quickplay integer not null, ritual integer not null, "
+			"primary key(cardid), foreign key(cardid) references card(cardid), "
+			"check(normal + continuous + equip + field + quickplay + ritual = 1)) without rowid");
+
+		// Move the data from spell_v8 into spell
+		execute_non_query(instance, L"insert into spell select v8.cardid, v8.normal, v8.continuous, v8.equip, v8.field, v8.quickplay, "
+			"v8.ritual from spell_v8 as v8");
+
+		// Drop the spell_v8 table
+		execute_non_query(instance, L"drop table spell_v8");
+
+		// table: trap_v8
+		//
+		// cardid(pk,fk) | normal | continuous | counter
+		execute_non_query(instance, L"alter table trap rename to trap_v8");
+
+		// table: trap
+		//
+		// cardid(pk,fk) | normal | continuous | counter
+		execute_non_query(instance, L"create table trap(cardid blob not null, normal integer not null, continuous integer not null, "
+			"counter integer not null, primary key(cardid), foreign key(cardid) references card(cardid), "
+			"check(normal + continuous + counter = 1)) without rowid");
+
+		// Move the data from trap_v8 into trap
+		execute_non_query(instance, L"insert into trap select v8.cardid, v8.normal, v8.continuous, v8.counter from trap_v8 as v8");
+
+		// Drop the trap_v8 table
+		execute_non_query(instance, L"drop table trap_v8");
+
+		// table: defaultartwork_v8
+		//
+		// cardid(pk,fk) | artworkid(fk)
+		execute_non_query(instance, L"alter table defaultartwork rename to defaultartwork_v8");
+
+		// table: defaultartwork
+		//
+		// cardid(pk,fk) | artworkid(fk)
+		execute_non_query(instance, L"create table defaultartwork(cardid blob not null, artworkid blob not null, "
+			"primary key(cardid), foreign key(cardid) references card(cardid), foreign key(artworkid) references artwork(artworkid)) "
+			"without rowid");
+
+		// Move the data from defaultartwork_v8 into defaultartwork
+		execute_non_query(instance, L"insert into defaultartwork select v8.cardid, v8.artworkid from defaultartwork_v8 as v8");
+
+		// Drop the defaultartwork_v8 table
+		execute_non_query(instance, L"drop table defaultartwork_v8");
+
+		// table: series_v8
+		//
+		// seriesid(pk) | code(u) | name(u) | boosterpack | releasedate
+		execute_non_query(instance, L"alter table series rename to series_v8");
+		execute_non_query(instance, L"drop index if exists series_code");
+		execute_non_query(instance, L"drop index if exists series_releasedate");
+
+		// table: series
+		//
+		// seriesid(pk) | code(u) | name(u) | boosterpack | releasedate
+		execute_non_query(instance, L"create table series(seriesid blob not null, code text unique not null, name text unique not null, "
+			"boosterpack integer not null, releasedate text null, primary key(seriesid)) without rowid");
+		execute_non_query(instance, L"create unique index series_code on series(code)");
+		execute_non_query(instance, L"create index series_releasedate on series(releasedate)");
+
+		// Move the data from series_v8 into series
+		execute_non_query(instance, L"insert into series select v8.seriesid, v8.code, v8.name, v8.boosterpack, v8.releasedate from series_v8 as v8");
+
+		// Drop the series_v8 table
+		execute_non_query(instance, L"drop table series_v8");
+
+		// table: print_v8
+		//
+		// printid(pk) | cardid(fk) | seriesid(fk) | artworkid(fk) | code | language | number | rarity | limitededition | releasedate
+		execute_non_query(instance, L"alter table print rename to print_v8");
+		execute_non_query(instance, L"drop index if exists print_cardid");
+		execute_non_query(instance, L"drop index if exists print_code");
+		execute_non_query(instance, L"drop index if exists print_releasedate");
+		execute_non_query(instance, L"drop index if exists print_seriesid");
+
+		// table: print
+		//
+		// printid(u) | cardid(pk,fk) | seriesid(fk) | artworkid(fk) | code | language | number | rarity | limitededition | releasedate
+		//
+		// Prints are always selected by cardid; clustering on (cardid, printid) allows the prints for
+		// a card to be read with a single range scan rather than through a separate index
+		execute_non_query(instance, L"create table print(printid blob not null, cardid blob not null, seriesid blob not null, "
+			"artworkid blob null, code text not null, language text null, number text not null, rarity integer not null, limitededition integer not null, "
+			"releasedate text not null, primary key(cardid, printid), unique(printid), foreign key(cardid) references card(cardid), "
+			"foreign key(seriesid) references series(seriesid), foreign key(artworkid) references artwork(artworkid), "
+			"check(rarity between 1 and 9)) without rowid");
+		execute_non_query(instance, L"create unique index print_code on print(code, language, number)");
+		execute_non_query(instance, L"create index print_releasedate on print(releasedate)");
+		execute_non_query(instance, L"create index print_seriesid on print(seriesid)");
+
+		// Move the data from print_v8 into print
+		execute_non_query(instance, L"insert into print select v8.printid, v8.cardid, v8.seriesid, v8.artworkid, v8.code, v8.language, v8.number, "
+			"v8.rarity, v8.limitededition, v8.releasedate from print_v8 as v8");
+
+		// Drop the print_v8 table
+		execute_non_query(instance, L"drop table print_v8");
+
+		// table: restriction_v8
+		//
+		// restrictionlistid(pk,fk) | cardid(pk,fk) | restriction
+		execute_non_query(instance, L"alter table restriction rename to restriction_v8");
+
+		// table: restriction
+		//
+		// restrictionlistid(pk,fk) | cardid(pk,fk) | restriction
+		execute_non_query(instance, L"create table restriction(restrictionlistid blob not null, cardid blob not null, restriction integer not null, "
+			"primary key(restrictionlistid, cardid), foreign key(restrictionlistid) references restrictionlist(restrictionlistid), "
+			"foreign key(cardid) references card(cardid), check(restriction between 0 and 2)) without rowid");
+
+		// Move the data from restriction_v8 into restriction
+		execute_non_query(instance, L"insert into restriction select v8.restrictionlistid, v8.cardid, v8.restriction from restriction_v8 as v8");
+
+		// Drop the restriction_v8 table
+		execute_non_query(instance, L"drop table restriction_v8");
+
+		// table: cardsummary_v8
+		//
+		// { 00-06 } cardid(pk) | type | name | passcode | text | releasedate | artworkid
+		// { 07-12 } monsterattribute | monsterlevel | monstertype | monsterattack | monsterdefense | monsternormal 
+		// { 13-19 } monstereffect | monsterfusion | monsterritual | monstertoon | monsterunion | monsterspirit | monstergemini
+		// { 20-25 } spellnormal | spellcontinuous | spellequip | spellfield | spellquickplay | spellritual 
+		// { 26-28 } trapnormal | trapcontinuous | trapcounter
+		execute_non_query(instance, L"alter table cardsummary rename to cardsummary_v8");
+		execute_non_query(instance, L"drop index if exists cardsummary_name");
+		execute_non_query(instance, L"drop index if exists cardsummary_releasedate");
+
+		// table: cardsummary
+		//
+		// { 00-06 } cardid(pk) | type | name | passcode | text | releasedate | artworkid
+		// { 07-12 } monsterattribute | monsterlevel | monstertype | monsterattack | monsterdefense | monsternormal 
+		// { 13-19 } monstereffect | monsterfusion | monsterritual | monstertoon | monsterunion | monsterspirit | monstergemini
+		// { 20-25 } spellnormal | spellcontinuous | spellequip | spellfield | spellquickplay | spellritual 
+		// { 26-28 } trapnormal | trapcontinuous | trapcounter
+		execute_non_query(instance, L"create table cardsummary(cardid blob not null, type integer not null, name text not null, "
+			"passcode text null, text text null, releasedate text null, artworkid blob null, monsterattribute integer null, "
+			"monsterlevel integer null, monstertype integer null, monsterattack integer null, monsterdefense integer null, "
+			"monsternormal integer null, monstereffect integer null, monsterfusion integer null, monsterritual integer null, "
+			"monstertoon integer null, monsterunion integer null, monsterspirit integer null, monstergemini integer null, "
+			"spellnormal integer null, spellcontinuous integer null, spellequip integer null, spellfield integer null, "
+			"spellquickplay integer null, spellritual integer null, trapnormal integer null, trapcontinuous integer null, "
+			"trapcounter integer null, primary key(cardid)) without rowid");
+		execute_non_query(instance, L"create index cardsummary_name on cardsummary(name)");
+		execute_non_query(instance, L"create index cardsummary_releasedate on cardsummary(releasedate)");
+
+		// Move the data from cardsummary_v8 into cardsummary
+		execute_non_query(instance, L"insert into cardsummary select * from cardsummary_v8");
+
+		// Drop the cardsummary_v8 table
+		execute_non_query(instance, L"drop table cardsummary_v8");
+
+		// triggers: monster (dropped with the monster_v8 table)
+		execute_non_query(instance, L"create trigger cardsummary_monster_insert after insert on monster begin "
+			"insert or replace into cardsummary select * from cardsummary_source where cardid = new.cardid; end");
+		execute_non_query(instance, L"create trigger cardsummary_monster_update after update on monster begin "
+			"insert or replace into cardsummary select * from cardsummary_source where cardid in (old.cardid, new.cardid); end");
+		execute_non_query(instance, L"create trigger cardsummary_monster_delete after delete on monster begin "
+			"insert or replace into cardsummary select * from cardsummary_source where cardid = old.cardid; end");
+
+		// triggers: spell (dropped with the spell_v8 table)
+		execute_non_query(instance, L"create trigger cardsummary_spell_insert after insert on spell begin "
+			"insert or replace into cardsummary select * from cardsummary_source where cardid = new.cardid; end");
+		execute_non_query(instance, L"create trigger cardsummary_spell_update after update on spell begin "
+			"insert or replace into cardsummary select * from cardsummary_source where cardid in (old.cardid, new.cardid); end");
+		execute_non_query(instance, L"create trigger cardsummary_spell_delete after delete on spell begin "
+			"insert or replace into cardsummary select * from cardsummary_source where cardid = old.cardid; end");
+
+		// triggers: trap (dropped with the trap_v8 table)
+		execute_non_query(instance, L"create trigger cardsummary_trap_insert after insert on trap begin "
+			"insert or replace into cardsummary select * from cardsummary_source where cardid = new.cardid; end");
+		execute_non_query(instance, L"create trigger cardsummary_trap_update after update on trap begin "
+			"insert or replace into cardsummary select * from cardsummary_source where cardid in (old.cardid, new.cardid); end");
+		execute_non_query(instance, L"create trigger cardsummary_trap_delete after delete on trap begin "
+			"insert or replace into cardsummary select * from cardsummary_source where cardid = old.cardid; end");
+
+		// triggers: defaultartwork (dropped with the defaultartwork_v8 table)
+		execute_non_query(instance, L"create trigger cardsummary_defaultartwork_insert after insert on defaultartwork begin "
+			"update cardsummary set artworkid = new.artworkid where cardid = new.cardid; end");
+		execute_non_query(instance, L"create trigger cardsummary_defaultartwork_update after update on defaultartwork begin "
+			"update cardsummary set artworkid = null where cardid = old.cardid; "
+			"update cardsummary set artworkid = new.artworkid where cardid = new.cardid; end");
+		execute_non_query(instance, L"create trigger cardsummary_defaultartwork_delete after delete on defaultartwork begin "
+			"update cardsummary set artworkid = null where cardid = old.cardid; end");
+
+		// triggers: print (dropped with the print_v8 table)
+		execute_non_query(instance, L"create trigger cardsummary_print_insert after insert on print begin "
+			"update cardsummary set releasedate = (select min(releasedate) from print where cardid = new.cardid) "
+			"where cardid = new.cardid; end");
+		execute_non_query(instance, L"create trigger cardsummary_print_update after update of cardid, releasedate on print begin "
+			"update cardsummary set releasedate = (select min(releasedate) from print where cardid = old.cardid) "
+			"where cardid = old.cardid; "
+			"update cardsummary set releasedate = (select min(releasedate) from print where cardid = new.cardid) "
+			"where cardid = new.cardid; end");
+		execute_non_query(instance, L"create trigger cardsummary_print_delete after delete on print begin "
+			"update cardsummary set releasedate = (select min(releasedate) from print where cardid = old.cardid) "
+			"where cardid = old.cardid; end");
+
+		// Restore ALTER TABLE behavior and enable foreign keys after the update
+		execute_non_query(instance, L"pragma legacy_alter_table=OFF");
+		execute_non_query(instance, L"pragma foreign_keys=ON");
+
+		execute_non_query(instance, L"pragma user_version = 9");
+		dbversion = 9;
+	}
+
+	// SCHEMA VERSION 9 -> VERSION 10
+	//
+	// Add the cardsearch FTS5 full-text index over card names, card text and rulings
+	if(dbversion == 9) {
+
+		// table: cardsearch
+		//
+		// cardid | name | text | rulings
+		//
+		// The cardid is stored as an unindexed column rather than relying on rowid, which
+		// is not stable for the card table across a VACUUM operation
+		execute_non_query(instance, L"create virtual table cardsearch using fts5(cardid unindexed, name, text, rulings, "
+			"prefix = '2 3', tokenize = 'unicode61 remove_diacritics 2')");
+
+		// Populate the cardsearch table from the existing card and ruling data
+		execute_non_query(instance, L"insert into cardsearch select card.cardid, card.name, card.text, "
+			"(select group_concat(ruling.ruling, char(10)) from ruling where ruling.cardid = card.cardid) from card");
+
+		execute_non_query(instance, L"pragma user_version = 10");
+		dbversion = 10;
+	}
+
+	// SCHEMA VERSION 10 -> VERSION 11
+	//
+	// Add the cardsummary indexes used by QueryCards to filter on the monster columns; the
+	// indexes are partial since the monster columns are null for spell and trap cards
+	if(dbversion == 10) {
+
+		execute_non_query(instance, L"create index cardsummary_type on cardsummary(type)");
+		execute_non_query(instance, L"create index cardsummary_monsterattribute on cardsummary(monsterattribute) "
+			"where monsterattribute is not null");
+		execute_non_query(instance, L"create index cardsummary_monstertype on cardsummary(monstertype) "
+			"where monstertype is not null");
+		execute_non_query(instance, L"create index cardsummary_monsterlevel on cardsummary(monsterlevel) "
+			"where monsterlevel is not null");
+		execute_non_query(instance, L"create index cardsummary_monsterattackdefense on cardsummary(monsterattack, monsterdefense) "
+			"where monsterattack is not null");
+
+		execute_non_query(instance, L"pragma user_version = 11");
+		dbversion = 11;
+	}
+
+	// SCHEMA VERSION 11 -> VERSION 12
+	//
+	// Add virtual integer day number columns alongside the ISO-8601 date columns so that rows can
+	// be decoded and filtered without parsing text; the day numbers count the days since 0001-01-01,
+	// the same epoch as DateTime, and julianday('0001-01-01') is 1721425.5
+	if(dbversion == 11) {
+
+		// table: cardsummary
+		//
+		// { 29 } releaseday
+		execute_non_query(instance, L"drop index if exists cardsummary_releasedate");
+		execute_non_query(instance, L"alter table cardsummary add column releaseday integer "
+			"generated always as (cast(julianday(releasedate) - 1721425.5 as integer)) virtual");
+		execute_non_query(instance, L"create index cardsummary_releaseday on cardsummary(releaseday)");
+
+		// table: print
+		//
+		// { 10 } releaseday
+		execute_non_query(instance, L"drop index if exists print_releasedate");
+		execute_non_query(instance, L"alter table print add column releaseday integer "
+			"generated always as (cast(julianday(releasedate) - 1721425.5 as integer)) virtual");
+		execute_non_query(instance, L"create index print_releaseday on print(releaseday)");
+
+		// table: series
+		//
+		// { 05 } releaseday
+		execute_non_query(instance, L"drop index if exists series_releasedate");
+		execute_non_query(instance, L"alter table series add column releaseday integer "
+			"generated always as (cast(julianday(releasedate) - 1721425.5 as integer)) virtual");
+		execute_non_query(instance, L"create index series_releaseday on series(releaseday)");
+
+		// table: restrictionlist
+		//
+		// { 02 } effectiveday
+		execute_non_query(instance, L"alter table restrictionlist add column effectiveday integer "
+			"generated always as (cast(julianday(effective) - 1721425.5 as integer)) virtual");
+		execute_non_query(instance, L"create index restrictionlist_effectiveday on restrictionlist(effectiveday)");
+
+		execute_non_query(instance, L"pragma user_version = 12");
+		dbversion = 12;
+	}
+
+	// SCHEMA VERSION 12 -> VERSION 13
+	//
+	// Map each cardid to the rowid of its cardsearch row; the cardid column of the full-text
+	// index is unindexed and locating a row by cardid scans the entire index.  The rowids of
+	// an FTS5 table are stored explicitly and are not changed by a VACUUM operation
+	if(dbversion == 12) {
+
+		// table: cardsearchkey
+		//
+		// cardid(pk) | searchid
+		execute_non_query(instance, L"create table cardsearchkey(cardid blob not null, searchid integer not null, "
+			"primary key(cardid)) without rowid");
+		execute_non_query(instance, L"insert into cardsearchkey select cardid, rowid from cardsearch");
+
+		execute_non_query(instance, L"pragma user_version = 13");
+		dbversion = 13;
+	}
+
+	CLRASSERT(dbversion == SCHEMA_VERSION);
+}
+
+//---------------------------------------------------------------------------
+// Database::InsertArtwork (internal)
+//
+// Inserts a new artwork image into the database
+//
+// Arguments:
+//
+//	cardid		- CardID for the artwork
+//	format		- Image format
+//	width		- Image width
+//	height		- Image height
+//	image		- Image data
+
+ArtworkId^ Database::InsertArtwork(CardId^ cardid, String^ format, int width, int height, array<Byte>^ image)
+{
+	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
+
+	if(CLRISNULL(cardid)) throw gcnew ArgumentNullException("format");
+	if(CLRISNULL(format)) throw gcnew ArgumentNullException("format");
+	if(CLRISNULL(image)) throw gcnew ArgumentNullException("image");
+
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Write);
+
+	auto sql = L"insert into artwork values(?1, ?2, ?3, ?4, ?5, ?6)";
+
+	// Create a new ArtworkId and convert it into a native key
+	ArtworkId^ artworkid = gcnew ArtworkId(Guid::NewGuid());
+	uuidkey_t _artworkid = artworkid->ToKey();
+
+	// Convert the cardid into a native key
+	uuidkey_t _cardid = cardid->ToKey();
+
+	// Pin the format string
+	pin_ptr<wchar_t const> pinformat = PtrToStringChars(format);
+
+	// Pin the image data
+	pin_ptr<Byte> pinimage = &image[0];
+
+	// Acquire the prepared query from the statement cache
+	sqlite3_stmt* statement = instance.Statements->Acquire(instance, sql);
+	int result = SQLITE_OK;
+
+	try {
+
+		// Bind the query parameter(s)
+		result = sqlite3_bind_blob(statement, 1, &_artworkid, sizeof(uuidkey_t), SQLITE_STATIC);
+		if(result == SQLITE_OK) result = sqlite3_bind_blob(statement, 2, &_cardid, sizeof(uuidkey_t), SQLITE_STATIC);
+		if(result == SQLITE_OK) result = sqlite3_bind_text16(statement, 3, pinformat, -1, SQLITE_STATIC);
+		if(result == SQLITE_OK) result = sqlite3_bind_int(statement, 4, height);
+		if(result == SQLITE_OK) result = sqlite3_bind_int(statement, 5, width);
+		if(result == SQLITE_OK) result = sqlite3_bind_blob(statement, 6, pinimage, image->Length, SQLITE_STATIC);
+		if(result != SQLITE_OK) throw gcnew SQLiteException(result);
+
+		// Execute the query; no rows are expected to be returned
+		result = sqlite3_step(statement);
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	}
+
+	finally { instance.Statements->Release(statement); }
+
+	return artworkid;
+}
+
+//---------------------------------------------------------------------------
+// Database::LoadCardBitmapIndex
+//
+// Loads the card attribute sets from the database into a bitmap index
+//
+// Arguments:
+//
+//	NONE
+
+CardBitmapIndex^ Database::LoadCardBitmapIndex(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
+
+	// monster, spell and trap attributes are taken from the cards themselves
+	CardBitmapIndex^ index = gcnew CardBitmapIndex(EnumerateCards());
+
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Read);
+
+	// restriction table
+	auto sql = L"select restrictionlistid, cardid, restriction from restriction";
+
+	sqlite3_stmt* statement = instance.Statements->Acquire(instance, sql);
+	int result = SQLITE_OK;
+
+	try {
+
+		// Execute the query and iterate over all returned rows
+		result = sqlite3_step(statement);
+		while(result == SQLITE_ROW) {
+
+			index->AddRestriction(gcnew RestrictionListId(column_uuid(statement, 0)), gcnew CardId(column_uuid(statement, 1)),
+				static_cast<Restriction>(sqlite3_column_int(statement, 2)));
+
+			result = sqlite3_step(statement);			// Move to the next result set row
+		}
+
+		// If the final result of the query was not SQLITE_DONE, something bad happened
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	}
+
+	finally { instance.Statements->Release(statement); }
+
+	// ruling table
+	sql = L"select distinct cardid from ruling";
+	statement = instance.Statements->Acquire(instance, sql);
+
+	try {
+
+		// Execute the query and iterate over all returned rows
+		result = sqlite3_step(statement);
+		while(result == SQLITE_ROW) {
+
+			index->AddRuling(gcnew CardId(column_uuid(statement, 0)));
+			result = sqlite3_step(statement);			// Move to the next result set row
+		}
+
+		// If the final result of the query was not SQLITE_DONE, something bad happened
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	}
+
+	finally { instance.Statements->Release(statement); }
+
+	return index;
+}
+
+//---------------------------------------------------------------------------
+// Database::LoadCardCatalog
+//
+// Loads the Cards from the database into a columnar in-memory catalog
+//
+// Arguments:
+//
+//	NONE
+
+CardCatalog^ Database::LoadCardCatalog(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	return gcnew CardCatalog(EnumerateCards());
+}
+
+//---------------------------------------------------------------------------
+// Database::Open (static)
+//
+// Opens an existing database file
+//
+// Arguments:
+//
+//	path		- Path on which to open the database file
+//	readonly	- Read-only access flag
 
-	// SCHEMA VERSION 2 -> VERSION 3
-	//
-	// Adds missing CHECK constraint on print.rarity
-	// Adds limitededition column to print table
-	// Adds boosterpack column to series table
-	if(dbversion == 2) {
+Database^ Database::Open(String^ path)
+{
+	// Default to read-only access
+	return Open(path, true);
+}
 
-		// Disable foreign keys during the update
-		execute_non_query(instance, L"pragma foreign_keys=OFF");
+//---------------------------------------------------------------------------
+// Database::Open (static)
+//
+// Opens an existing database file
+//
+// Arguments:
+//
+//	path		- Path on which to open the database file
+//	readonly	- Read-only access flag
 
-		// table: series_v2
-		//
-		// seriesid(pk) | code(u) | name(u) | releasedate
-		execute_non_query(instance, L"alter table series rename to series_v2");
-		execute_non_query(instance, L"drop index if exists series_releasedate");
+Database^ Database::Open(String^ path, bool readonly)
+{
+	return Open(path, readonly, DEFAULT_READ_CONNECTIONS);
+}
 
-		// table: series
-		//
-		// seriesid(pk) | code(u) | name(u) | boosterpack | releasedate
-		execute_non_query(instance, L"create table series(seriesid blob not null, code text unique not null, name text unique not null, "
-			"boosterpack integer not null, releasedate text null, primary key(seriesid))");
-		execute_non_query(instance, L"create index series_releasedate on series(releasedate)");
+//---------------------------------------------------------------------------
+// Database::Open (static)
+//
+// Opens an existing database file
+//
+// Arguments:
+//
+//	path		- Path on which to open the database file
+//	readonly	- Read-only access flag
+//	readers		- Maximum number of pooled read-only connections
 
-		// Move the data from series_v2 into series
-		execute_non_query(instance, L"insert into series select v2.seriesid, v2.code, v2.name, 0, v2.releasedate from series_v2 as v2");
-		execute_non_query(instance, L"update series set boosterpack = 1 where code in ('LOB', 'MRD', 'SRL', 'PSV', 'LON', 'LOD', 'PGD', "
-			"'MFC', 'DCR', 'IOC', 'AST', 'SOD', 'RDS', 'FET', 'TLM', 'CRV', 'EEN', 'SOI', 'EOJ', 'POTD', 'CDIP', 'STON', 'FOTB', 'TAEV', "
-			"'GLAS', 'PTDN', 'LOTD')");
-		
-		// Drop the series_v2 table
-		execute_non_query(instance, L"drop table series_v2");
+Database^ Database::Open(String^ path, bool readonly, int readers)
+{
+	sqlite3* instance = nullptr;
 
-		// table: print_v2
-		//
-		// printid(pk) | cardid(fk) | seriesid(fk) | artworkid(fk) | code | language | number | rarity | releasedate
-		execute_non_query(instance, L"alter table print rename to print_v2");
-		execute_non_query(instance, L"drop index if exists print_code");
-		execute_non_query(instance, L"drop index if exists print_rarity");
-		execute_non_query(instance, L"drop index if exists print_releasedate");
+	if(CLRISNULL(path)) throw gcnew ArgumentNullException("path");
+	if(readers < 0) throw gcnew ArgumentOutOfRangeException("readers");
 
-		// table: print
-		//
-		// printid(pk) | cardid(fk) | seriesid(fk) | artworkid(fk) | code | language | number | rarity | limitededition | releasedate
-		execute_non_query(instance, L"create table print(printid blob not null, cardid blob not null, seriesid blob not null, "
-			"artworkid blob null, code text not null, language text null, number text not null, rarity text not null, limitededition integer not null, "
-			"releasedate text not null, primary key(printid), foreign key(cardid) references card(cardid), foreign key(seriesid) references series(seriesid), "
-			"foreign key(artworkid) references artwork(artworkid) "
-			"check(rarity in ('Common', 'Gold Rare', 'Parallel Rare', 'Prismatic Secret Rare', 'Rare', 'Secret Rare', 'Super Rare', 'Ultra Parallel Rare', "
-			"'Ultra Rare')))");
-		execute_non_query(instance, L"create unique index print_code on print(code, language, number)");
-		execute_non_query(instance, L"create index print_rarity on print(rarity)");
-		execute_non_query(instance, L"create index print_releasedate on print(releasedate)");
+	// Create a marshaling context to convert the String^ into an ANSI C-style string
+	msclr::auto_handle<msclr::interop::marshal_context> context(gcnew msclr::interop::marshal_context());
 
-		// Move the data from print_v2 into print
-		execute_non_query(instance, L"insert into print select v2.printid, v2.cardid, v2.seriesid, v2.artworkid, v2.code, v2.language, v2.number, "
-			"v2.rarity, 0, v2.releasedate from print_v2 as v2");
+	// Attempt to open the database on the specified path
+	int result = sqlite3_open_v2(context->marshal_as<char const*>(Path::GetFullPath(path)), &instance,
+		(readonly) ? SQLITE_OPEN_READONLY : SQLITE_OPEN_READWRITE, nullptr);
+	if(result != SQLITE_OK) {
 
-		// Drop the print_v2 table
-		execute_non_query(instance, L"drop table print_v2");
+		if(instance != nullptr) sqlite3_close(instance);
+		throw gcnew SQLiteException(result);
+	}
 
-		// Enable foreign keys after the update
-		execute_non_query(instance, L"pragma foreign_keys=ON");
+	// Create the safe handle wrapper around the sqlite3*
+	SQLiteSafeHandle^ handle = gcnew SQLiteSafeHandle(std::move(instance));
+	CLRASSERT(instance == nullptr);
 
-		execute_non_query(instance, L"pragma user_version = 3");
-		dbversion = 3;
+	// The text encoding of a database cannot be changed in place; a writable UTF-16
+	// database is rebuilt into a new UTF-8 file that replaces the original file
+	if(!readonly) {
+
+		String^ fullpath = Path::GetFullPath(path);
+		String^ rebuildpath = String::Concat(fullpath, ".rebuild");
+		bool rebuild = false;
+
+		try {
+
+			SQLiteSafeHandle::Reference reference(handle);
+			rebuild = (execute_scalar_int(reference, L"select encoding = 'UTF-8' from pragma_encoding") != 1);
+			if(rebuild) rebuild_utf8(reference, rebuildpath);
+		}
+
+		catch(Exception^) { delete handle; throw; }
+
+		if(rebuild) {
+
+			delete handle;
+			File::Replace(rebuildpath, fullpath, nullptr);
+
+			return Open(path, readonly, readers);
+		}
 	}
 
-	// SCHEMA VERSION 3 -> VERSION 4
-	//
-	// Add primary keys to the monstercard, spellcard, and trapcard tables
-	// Alter restriction.restriction column into text ('Forbidden', 'Limited', 'Semi-Limited')
-	// Add primary key to the ruling table
-	// Add indexes on print.cardid and print.seriesid columns
-	if(dbversion == 3) {
+	// Initialize the database instance
+	InitializeInstance(handle);
 
-		// Disable foreign keys during the update
-		execute_non_query(instance, L"pragma foreign_keys=OFF");
+	// Delete the safe handle on a construction failure
+	try { return gcnew Database(handle, path, readers, false); }
+	catch(Exception^) { delete handle; throw; }
+}
 
-		// table: monster_v3
-		//
-		// cardid(fk) | attribute | level | type | attack | defense | normal | effect | fusion | ritual | toon | union | spirit | gemini 
-		execute_non_query(instance, L"alter table monster rename to monster_v3");
-		execute_non_query(instance, L"drop index if exists monster_attribute");
-		execute_non_query(instance, L"drop index if exists monster_level");
-		execute_non_query(instance, L"drop index if exists monster_type");
-		execute_non_query(instance, L"drop index if exists monster_attackdefense");
-		execute_non_query(instance, L"drop index if exists monster_flag");
+//---------------------------------------------------------------------------
+// Database::OpenArtworkImage (internal)
+//
+// Opens a read-only stream against an artwork image in the database
+//
+// Arguments:
+//
+//	artworkid	- Artwork identifier
 
-		// table: monster
-		//
-		// cardid(pk,fk) | attribute | level | type | attack | defense | normal | effect | fusion | ritual | toon | union | spirit | gemini 
-		execute_non_query(instance, L"create table monster(cardid blob not null, attribute text not null, level integer not null, "
-			"type text not null, attack integer not null, defense integer not null, normal integer not null, effect integer not null, "
-			"fusion integer not null, ritual integer not null, toon integer not null, [union] integer not null, spirit integer not null, "
-			"gemini integer not null, primary key(cardid), foreign key(cardid) references card(cardid), "
-			"check(attribute in ('DARK', 'EARTH', 'FIRE', 'LIGHT', 'WATER', 'WIND')), "
-			"check(level between 1 and 12), check(attack between -1 and 5000), check(defense between -1 and 5000), "
-			"check(type in ('Aqua', 'Beast', 'Beast-Warrior', 'Dinosaur', 'Dragon', 'Fairy', 'Fiend', 'Fish', 'Insect', 'Machine', "
-			"  'Plant', 'Pyro', 'Reptile', 'Rock', 'Sea Serpent', 'Spellcaster', 'Thunder', 'Warrior', 'Winged Beast', 'Zombie')), "
-			"check(normal = 0 or (effect + fusion + ritual + toon + [union] + spirit + gemini = 0)), "
-			"check(fusion = 0 or (toon + [union] + spirit + gemini = 0)), "
-			"check(ritual = 0 or (toon + [union] + spirit + gemini = 0)), "
-			"check(toon = 0 or effect = 1), check([union] = 0 or effect = 1), check(spirit = 0 or effect = 1), "
-			"check(gemini = 0 or effect = 1))");
-		execute_non_query(instance, L"create index monster_attribute on monster(attribute)");
-		execute_non_query(instance, L"create index monster_level on monster(level)");
-		execute_non_query(instance, L"create index monster_type on monster(type)");
-		execute_non_query(instance, L"create index monster_attackdefense on monster(attack, defense)");
-		execute_non_query(instance, L"create index monster_flag on monster(normal, effect, fusion, ritual, toon, [union], spirit, gemini)");
+Stream^ Database::OpenArtworkImage(ArtworkId^ artworkid)
+{
+	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
 
-		// Move the data from monster_v3 into monster
-		execute_non_query(instance, L"insert into monster select v3.cardid, v3.attribute, v3.level, v3.type, v3.attack, v3.defense, v3.normal, "
-			"v3.effect, v3.fusion, v3.ritual, v3.toon, v3.[union], v3.spirit, v3.gemini from monster_v3 as v3");
-			
-		// Drop the monster_v3 table
-		execute_non_query(instance, L"drop table monster_v3");
+	if(CLRISNULL(artworkid)) throw gcnew ArgumentNullException("artworkid");
 
-		// table: spell_v3
-		//
-		// cardid(fk) | normal | continuous | equip | field | quickplay | ritual
-		execute_non_query(instance, L"alter table spell rename to spell_v3");
-		execute_non_query(instance, L"drop index if exists spell_flag");
+	// The artwork ROWID is looked up on the stream's own connection and read transaction
+	return gcnew ArtworkStream(m_pool, artworkid);
+}
 
-		// table: spell
-		//
-		// cardid(pk,fk) | normal | continuous | equip | field | quickplay | ritual
-		execute_non_query(instance, L"create table spell(cardid blob not null, normal integer not null, continuous integer not null, "
-			"equip integer not null, field integer not null, quickplay integer not null, ritual integer not null, "
-			"primary key(cardid), foreign key(cardid) references card(cardid), "
-			"check(normal + continuous + equip + field + quickplay + ritual = 1))");
-		execute_non_query(instance, L"create index spell_flag on spell(normal, continuous, equip, field, quickplay, ritual)");
+//---------------------------------------------------------------------------
+// Database::OpenImmutable (static)
+//
+// Opens an existing database file that will not be modified
+//
+// Arguments:
+//
+//	path		- Path on which to open the database file
 
-		// Move the data from spell_v3 into spell
-		execute_non_query(instance, L"insert into spell select v3.cardid, v3.normal, v3.continuous, v3.equip, v3.field, v3.quickplay, "
-			"v3.ritual from spell_v3 as v3");
+Database^ Database::OpenImmutable(String^ path)
+{
+	if(CLRISNULL(path)) throw gcnew ArgumentNullException("path");
 
-		// Drop the spell_v3 table
-		execute_non_query(instance, L"drop table spell_v3");
+	// Open the database file as immutable; no locks are taken and the write-ahead
+	// log is never consulted, the file must not be modified while it is open
+	SQLiteSafeHandle^ handle = ConnectionPool::OpenReadOnly(path, true);
 
-		// table: trap_v3
-		//
-		// cardid(fk) | normal | continuous | counter
-		execute_non_query(instance, L"alter table trap rename to trap_v3");
-		execute_non_query(instance, L"drop index if exists trap_flag");
+	try {
 
-		// table: trap
-		//
-		// cardid(pk, fk) | normal | continuous | counter
-		execute_non_query(instance, L"create table trap(cardid blob not null, normal integer not null, continuous integer not null, "
-			"counter integer not null, primary key(cardid), foreign key(cardid) references card(cardid), "
-			"check(normal + continuous + counter = 1))");
-		execute_non_query(instance, L"create index trap_flag on trap(normal, continuous, counter)");
+		// The database cannot be initialized or migrated, only the schema version is checked
+		SQLiteSafeHandle::Reference instance(handle);
+		int dbversion = execute_scalar_int(instance, L"pragma user_version");
+		if(dbversion != SCHEMA_VERSION) 
+			throw gcnew Exception(String::Format("Database schema version {0} cannot be opened as immutable", dbversion));
+	}
 
-		// Move the data from trap_v3 into trap
-		execute_non_query(instance, L"insert into trap select v3.cardid, v3.normal, v3.continuous, v3.counter from trap_v3 as v3");
+	catch(Exception^) { delete handle; throw; }
 
-		// Drop the trap_v3 table
-		execute_non_query(instance, L"drop table trap_v3");
+	// Delete the safe handle on a construction failure
+	try { return gcnew Database(handle, path, DEFAULT_READ_CONNECTIONS, true); }
+	catch(Exception^) { delete handle; throw; }
+}
 
-		// table: restriction_v3
-		//
-		// restrictionlistid(pk,fk) | cardid(pk,fk) | restriction
-		execute_non_query(instance, L"alter table restriction rename to restriction_v3");
+//---------------------------------------------------------------------------
+// Database::OpenInMemory (static)
+//
+// Opens a new database instance from a private in-memory copy of a database file;
+// changes made to the database are discarded when the instance is closed
+//
+// Arguments:
+//
+//	path		- Path on which to open the database file
 
-		// table: restriction
-		//
-		// restrictionlistid(pk,fk) | cardid(pk,fk) | restriction
-		execute_non_query(instance, L"create table restriction(restrictionlistid blob not null, cardid blob not null, restriction text not null, "
-			"primary key(restrictionlistid, cardid), foreign key(restrictionlistid) references restrictionlist(restrictionlistid), "
-			"foreign key(cardid) references card(cardid), check(restriction in ('Forbidden', 'Limited', 'Semi-Limited')))");
+Database^ Database::OpenInMemory(String^ path)
+{
+	sqlite3* instance = nullptr;
 
-		// Move the data from restriction_v3 into restriction
-		execute_non_query(instance, L"insert into restriction select v3.restrictionlistid, v3.cardid, "
-			"case v3.restriction when 0 then 'Forbidden' when 1 then 'Limited' when 2 then 'Semi-Limited' else 'Unknown' end as restriction "
-			"from restriction_v3 as v3");
+	if(CLRISNULL(path)) throw gcnew ArgumentNullException("path");
 
-		// Drop the restriction_v3 table
-		execute_non_query(instance, L"drop table restriction_v3");
+	// The in-memory database is named and opened through the memdb VFS so that the connection
+	// pool can open read-only connections against it; the contents are released when the
+	// last connection to the database, which is always the writer, has been closed
+	String^ uri = String::Format("file:/ronin-{0:N}?vfs=memdb", Guid::NewGuid());
+
+	// Create a marshaling context to convert the String^ into an ANSI C-style string
+	msclr::auto_handle<msclr::interop::marshal_context> context(gcnew msclr::interop::marshal_context());
+
+	// Create the in-memory database that will receive the contents of the file
+	int result = sqlite3_open_v2(context->marshal_as<char const*>(uri), &instance, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_URI, nullptr);
+	if(result != SQLITE_OK) {
 
-		// table: ruling_v3
-		//
-		// cardid(fk) | sequence | ruling
-		execute_non_query(instance, L"alter table ruling rename to ruling_v3");
+		if(instance != nullptr) sqlite3_close(instance);
+		throw gcnew SQLiteException(result);
+	}
 
-		// table: ruling
-		//
-		// cardid(pk,fk) | sequence(pk) | ruling
-		execute_non_query(instance, L"create table ruling(cardid blob not null, sequence integer not null, ruling text not null, "
-			"primary key(cardid, sequence), foreign key(cardid) references card(cardid))");
+	// Create the safe handle wrapper around the sqlite3*
+	SQLiteSafeHandle^ handle = gcnew SQLiteSafeHandle(std::move(instance));
+	CLRASSERT(instance == nullptr);
 
-		// Move the data from ruling_v3 into ruling
-		execute_non_query(instance, L"insert into ruling select v3.cardid, v3.sequence, v3.ruling from ruling_v3 as v3");
+	try {
 
-		// Drop the ruling_v3 table
-		execute_non_query(instance, L"drop table ruling_v3");
+		// Open the database file as read-only rather than immutable so that the
+		// contents of any write-ahead log are included in the copy
+		SQLiteSafeHandle^ filehandle = ConnectionPool::OpenReadOnly(path, false);
 
-		// index: print_cardid
-		execute_non_query(instance, L"create index print_cardid on print(cardid)");
+		try {
 
-		// index: print_seriesid
-		execute_non_query(instance, L"create index print_seriesid on print(seriesid)");
+			SQLiteSafeHandle::Reference source(filehandle);
+			SQLiteSafeHandle::Reference target(handle);
 
-		// Enable foreign keys after the update
-		execute_non_query(instance, L"pragma foreign_keys=ON");
+			// The memdb VFS limits the size of a database to 1GiB by default; remove the limit
+			sqlite3_int64 sizelimit = Int64::MaxValue;
+			sqlite3_file_control(target, "main", SQLITE_FCNTL_SIZE_LIMIT, &sizelimit);
 
-		execute_non_query(instance, L"pragma user_version = 4");
-		dbversion = 4;
-	}
+			// A backup copies the pages verbatim, including the text encoding; a UTF-16 database
+			// is rebuilt into the in-memory database as UTF-8 so that it can be migrated
+			if(execute_scalar_int(source, L"select encoding = 'UTF-8' from pragma_encoding") != 1) rebuild_utf8(source, target);
 
-	// SCHEMA VERSION 4 -> VERSION 5
-	//
-	// Drop unused indexes
-	// Add index on artwork.cardid column
-	// Add unique index on series.code column
-	if(dbversion == 4) {
+			else {
 
-		// Drop unused indexes
-		execute_non_query(instance, L"drop index if exists monster_attribute");
-		execute_non_query(instance, L"drop index if exists monster_level");
-		execute_non_query(instance, L"drop index if exists monster_type");
-		execute_non_query(instance, L"drop index if exists monster_attackdefense");
-		execute_non_query(instance, L"drop index if exists monster_flag");
-		execute_non_query(instance, L"drop index if exists spell_flag");
-		execute_non_query(instance, L"drop index if exists trap_flag");
-		execute_non_query(instance, L"drop index if exists print_rarity");
+				// Copy the entire database file into the in-memory database in a single step
+				sqlite3_backup* backup = sqlite3_backup_init(target, "main", source, "main");
+				if(backup == nullptr) throw gcnew SQLiteException(sqlite3_errcode(target), sqlite3_errmsg(target));
 
-		// index: artwork.cardid
-		execute_non_query(instance, L"create index artwork_cardid on artwork(cardid)");
+				result = sqlite3_backup_step(backup, -1);
+				sqlite3_backup_finish(backup);
+				if(result != SQLITE_DONE) throw gcnew SQLiteException(result);
+			}
+		}
 
-		// unique index: series.code
-		execute_non_query(instance, L"create unique index series_code on series(code)");
+		finally { delete filehandle; }
 
-		execute_non_query(instance, L"pragma user_version = 5");
-		execute_non_query(instance, L"vacuum");
-		dbversion = 5;
+		// Initialize the in-memory database instance
+		InitializeInstance(handle);
 	}
 
-	CLRASSERT(dbversion == 5);
+	catch(Exception^) { delete handle; throw; }
 
-	// view: cards
-	//
-	// Denormalizes the card, monstercard, spellcard and trapcard tables into a flat view
-	// and also provides the minimum release date for each card for filtering
-	//
-	// { 00-06 } cardid | type | name | passcode | text | releasedate | artworkid
-	// { 07-12 } monsterattribute | monsterlevel | monstertype | monsterattack | monsterdefense | monsternormal 
-	// { 13-19 } monstereffect | monsterfusion | monsterritual | monstertoon | monsterunion | monsterspirit | monstergemini
-	// { 20-25 } spellnormal | spellcontinuous | spellequip | spellfield | spellquickplay | spellritual 
-	// { 26-28 } trapnormal | trapcontinuous | trapcounter
-	execute_non_query(instance, L"create temp view cards(cardid, type, name, passcode, text, releasedate, "
-		"artworkid, monsterattribute, monsterlevel, monstertype, monsterattack, monsterdefense, monsternormal, "
-		"monstereffect, monsterfusion, monsterritual, monstertoon, monsterunion, monsterspirit, monstergemini, "
-		"spellnormal, spellcontinuous, spellequip, spellfield, spellquickplay, spellritual, "
-		"trapnormal, trapcontinuous, trapcounter) as "
-		"with minrelease(cardid, releasedate) as (select cardid, min(releasedate) from print group by cardid) "
-		"select card.cardid, cardtype(card.type), card.name, card.passcode, card.text, "
-		"(select releasedate from minrelease where cardid = card.cardid), defaultartwork.artworkid, "
-		"cardattribute(monster.attribute), monster.level, monstertype(monster.type), monster.attack, "
-		"monster.defense, monster.normal, monster.effect, monster.fusion, monster.ritual, "
-		"monster.toon, monster.[union], monster.spirit, monster.gemini, "
-		"spell.normal, spell.continuous, spell.equip, spell.field, spell.quickplay, spell.ritual, "
-		"trap.normal, trap.continuous, trap.counter from card "
-		"left outer join defaultartwork on card.cardid = defaultartwork.cardid "
-		"left outer join monster on card.cardid = monster.cardid "
-		"left outer join spell on card.cardid = spell.cardid "
-		"left outer join trap on card.cardid = trap.cardid");
+	// The read-only connections are opened against the same named in-memory database
+	try { return gcnew Database(handle, uri, DEFAULT_READ_CONNECTIONS, false); }
+	catch(Exception^) { delete handle; throw; }
 }
 
 //---------------------------------------------------------------------------
-// Database::InsertArtwork (internal)
+// Database::QueryCards
 //
-// Inserts a new artwork image into the database
+// Selects the Cards that match a CardFilter from the database
 //
 // Arguments:
 //
-//	cardid		- CardID for the artwork
-//	format		- Image format
-//	width		- Image width
-//	height		- Image height
-//	image		- Image data
+//	filter		- CardFilter describing the Cards to select
 
-ArtworkId^ Database::InsertArtwork(CardId^ cardid, String^ format, int width, int height, array<Byte>^ image)
+List<Card^>^ Database::QueryCards(CardFilter^ filter)
 {
 	CHECK_DISPOSED(m_disposed);
 	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
 
-	if(CLRISNULL(cardid)) throw gcnew ArgumentNullException("format");
-	if(CLRISNULL(format)) throw gcnew ArgumentNullException("format");
-	if(CLRISNULL(image)) throw gcnew ArgumentNullException("image");
-
-	SQLiteSafeHandle::Reference instance(m_handle);
-	sqlite3_stmt* statement;
+	if(CLRISNULL(filter)) throw gcnew ArgumentNullException("filter");
 
-	auto sql = L"insert into artwork values(?1, ?2, ?3, ?4, ?5, ?6)";
+	// Compile the filter into a parameterized query against the cardsummary table
+	List<Object^>^ parameters = gcnew List<Object^>();
+	String^ query = compile_cardfilter(filter, parameters);
 
-	// Create a new ArtworkId and pin it
-	ArtworkId^ artworkid = gcnew ArtworkId(Guid::NewGuid());
-	array<Byte>^ _artworkid = artworkid->ToByteArray();
-	pin_ptr<Byte> pinartworkid = &_artworkid[0];
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Read);
 
-	// Convert the cardid into a byte array and pin it
-	array<Byte>^ _cardid = cardid->ToByteArray();
-	pin_ptr<Byte> pincardid = &_cardid[0];
+	// Discard any cached objects if the database has changed
+	ValidateIdentityMaps();
 
-	// Pin the format string
-	pin_ptr<wchar_t const> pinformat = PtrToStringChars(format);
+	List<Card^>^ cards = gcnew List<Card^>();
 
-	// Pin the image data
-	pin_ptr<Byte> pinimage = &image[0];
+	// Each distinct combination of filter criteria produces different SQL text; the statement is
+	// prepared for this query only rather than being held by the statement cache of every connection
+	pin_ptr<wchar_t const> sql = PtrToStringChars(query);
 
-	// Prepare the query
+	sqlite3_stmt* statement = nullptr;
 	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
 	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
 
 	try {
 
 		// Bind the query parameter(s)
-		result = sqlite3_bind_blob(statement, 1, pinartworkid, _artworkid->Length, SQLITE_STATIC);
-		if(result == SQLITE_OK) result = sqlite3_bind_blob(statement, 2, pincardid, _cardid->Length, SQLITE_STATIC);
-		if(result == SQLITE_OK) result = sqlite3_bind_text16(statement, 3, pinformat, -1, SQLITE_STATIC);
-		if(result == SQLITE_OK) result = sqlite3_bind_int(statement, 4, height);
-		if(result == SQLITE_OK) result = sqlite3_bind_int(statement, 5, width);
-		if(result == SQLITE_OK) result = sqlite3_bind_blob(statement, 6, pinimage, image->Length, SQLITE_STATIC);
-		if(result != SQLITE_OK) throw gcnew SQLiteException(result);
+		int paramindex = 1;
+		for each(Object^ parameter in parameters) bind_parameter(statement, paramindex, parameter);
 
-		// Execute the query; no rows are expected to be returned
+		// Execute the query and iterate over all returned rows
 		result = sqlite3_step(statement);
+		while(result == SQLITE_ROW) {
+
+			cards->Add(row_cards(this, m_cards, statement));		// Add the Card instance
+			result = sqlite3_step(statement);			// Move to the next result set row
+		}
+
+		// If the final result of the query was not SQLITE_DONE, something bad happened
 		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
 	}
 
 	finally { sqlite3_finalize(statement); }
 
-	return artworkid;
+	return cards;
 }
 
 //---------------------------------------------------------------------------
-// Database::Open (static)
+// Database::SearchCards
 //
-// Opens an existing database file
+// Performs a ranked full-text search of card names, text and rulings
 //
 // Arguments:
 //
-//	path		- Path on which to open the database file
-//	readonly	- Read-only access flag
+//	query		- Search text
+//	limit		- Maximum number of results to return
 
-Database^ Database::Open(String^ path)
+List<CardSearchResult^>^ Database::SearchCards(String^ query, int limit)
 {
-	// Default to read-only access
-	return Open(path, true);
+	return SearchCards(query, limit, "[", "]");
 }
 
 //---------------------------------------------------------------------------
-// Database::Open (static)
+// Database::SearchCards
 //
-// Opens an existing database file
+// Performs a ranked full-text search of card names, text and rulings
 //
 // Arguments:
 //
-//	path		- Path on which to open the database file
-//	readonly	- Read-only access flag
+//	query			- Search text
+//	limit			- Maximum number of results to return
+//	highlightbegin	- Text to insert before each matched term in the snippet
+//	highlightend	- Text to insert after each matched term in the snippet
 
-Database^ Database::Open(String^ path, bool readonly)
+List<CardSearchResult^>^ Database::SearchCards(String^ query, int limit, String^ highlightbegin, String^ highlightend)
 {
-	sqlite3* instance = nullptr;
+	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
 
-	if(CLRISNULL(path)) throw gcnew ArgumentNullException("path");
+	if(CLRISNULL(query)) throw gcnew ArgumentNullException("query");
+	if(limit < 0) throw gcnew ArgumentOutOfRangeException("limit");
+	if(CLRISNULL(highlightbegin)) throw gcnew ArgumentNullException("highlightbegin");
+	if(CLRISNULL(highlightend)) throw gcnew ArgumentNullException("highlightend");
 
-	// Create a marshaling context to convert the String^ into an ANSI C-style string
-	msclr::auto_handle<msclr::interop::marshal_context> context(gcnew msclr::interop::marshal_context());
+	List<CardSearchResult^>^ results = gcnew List<CardSearchResult^>();
 
-	// Attempt to open the database on the specified path
-	int result = sqlite3_open_v2(context->marshal_as<char const*>(Path::GetFullPath(path)), &instance,
-		(readonly) ? SQLITE_OPEN_READONLY : SQLITE_OPEN_READWRITE, nullptr);
-	if(result != SQLITE_OK) {
+	// Convert the search text into an FTS5 query expression; nothing to search for if it's empty
+	String^ expression = fts_query(query);
+	if((expression->Length == 0) || (limit == 0)) return results;
 
-		if(instance != nullptr) sqlite3_close(instance);
-		throw gcnew SQLiteException(result);
-	}
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Read);
 
-	// Create the safe handle wrapper around the sqlite3*
-	SQLiteSafeHandle^ handle = gcnew SQLiteSafeHandle(std::move(instance));
-	CLRASSERT(instance == nullptr);
+	// Discard any cached objects if the database has changed
+	ValidateIdentityMaps();
 
-	// Initialize the database instance
-	InitializeInstance(handle);
+	// Name matches are weighted above card text matches, which are weighted above ruling matches
+	//
+	// { 00-29 } cardsummary.* | { 30 } snippet | { 31 } score
+	auto sql = L"select cardsummary.*, snippet(cardsearch, -1, ?2, ?3, '...', 24), "
+		"bm25(cardsearch, 0.0, 10.0, 1.0, 0.5) as score from cardsearch "
+		"inner join cardsummary on cardsummary.cardid = cardsearch.cardid "
+		"where cardsearch match ?1 order by score limit ?4";
 
-	// Delete the safe handle on a construction failure
-	try { return gcnew Database(handle); }
-	catch(Exception^) { delete handle; throw; }
+	// Pin the query and highlight strings
+	pin_ptr<wchar_t const> pinexpression = PtrToStringChars(expression);
+	pin_ptr<wchar_t const> pinhighlightbegin = PtrToStringChars(highlightbegin);
+	pin_ptr<wchar_t const> pinhighlightend = PtrToStringChars(highlightend);
+
+	sqlite3_stmt* statement = instance.Statements->Acquire(instance, sql);
+	int result = SQLITE_OK;
+
+	try {
+
+		// Bind the query parameter(s)
+		result = sqlite3_bind_text16(statement, 1, pinexpression, -1, SQLITE_STATIC);
+		if(result == SQLITE_OK) result = sqlite3_bind_text16(statement, 2, pinhighlightbegin, -1, SQLITE_STATIC);
+		if(result == SQLITE_OK) result = sqlite3_bind_text16(statement, 3, pinhighlightend, -1, SQLITE_STATIC);
+		if(result == SQLITE_OK) result = sqlite3_bind_int(statement, 4, limit);
+		if(result != SQLITE_OK) throw gcnew SQLiteException(result);
+
+		// Execute the query and iterate over all returned rows
+		result = sqlite3_step(statement);
+		while(result == SQLITE_ROW) {
+
+			// Columns 0-29 are consumed by row_cards
+			Card^ card = row_cards(this, m_cards, statement);
+
+			// snippet | rank
+			String^ snippet = column_string(statement, 30);
+			double rank = sqlite3_column_double(statement, 31);
+
+			results->Add(gcnew CardSearchResult(card, snippet, rank));
+			result = sqlite3_step(statement);			// Move to the next result set row
+		}
+
+		// If the final result of the query was not SQLITE_DONE, something bad happened
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	}
+
+	finally { instance.Statements->Release(statement); }
+
+	return results;
 }
 
 //---------------------------------------------------------------------------
@@ -1374,62 +3713,83 @@ Artwork^ Database::SelectArtwork(ArtworkId^ artworkid)
 
 	if(CLRISNULL(artworkid)) throw gcnew ArgumentNullException("artworkid");
 
-	SQLiteSafeHandle::Reference instance(m_handle);
-	sqlite3_stmt* statement;
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Read);
 
 	// artworkid | cardid | format | width | height | image
 	auto sql = L"select artworkid, cardid, format, width, height, image from artwork where artworkid = ?1";
 
-	// Convert the artworkid into a byte array and pin it
-	array<Byte>^ _artworkid = artworkid->ToByteArray();
-	pin_ptr<Byte> pinartworkid = &_artworkid[0];
+	// Convert the artworkid into a native key
+	uuidkey_t _artworkid = artworkid->ToKey();
 
-	// Prepare the query
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	// Acquire the prepared query from the statement cache
+	sqlite3_stmt* statement = instance.Statements->Acquire(instance, sql);
+	int result = SQLITE_OK;
 
 	try {
 
 		// Bind the query parameter(s)
-		result = sqlite3_bind_blob(statement, 1, pinartworkid, _artworkid->Length, SQLITE_STATIC);
+		result = sqlite3_bind_blob(statement, 1, &_artworkid, sizeof(uuidkey_t), SQLITE_STATIC);
 		if(result != SQLITE_OK) throw gcnew SQLiteException(result);
 
 		// Execute the query; there should be at most one row returned
-		if(sqlite3_step(statement) == SQLITE_ROW) {
+		if(sqlite3_step(statement) == SQLITE_ROW) return row_artwork(this, m_strings, statement);
+		else return nullptr;
+	}
+
+	finally { instance.Statements->Release(statement); }
+}
+
+//---------------------------------------------------------------------------
+// Database::SelectArtwork (internal)
+//
+// Selects artwork objects from the database
+//
+// Arguments:
+//
+//	cardid	- Card identifier
 
-			// artworkid | cardid
-			Artwork^ artwork = gcnew Artwork(this, gcnew ArtworkId(column_uuid(statement, 0)), gcnew CardId(column_uuid(statement, 1)));
+List<Artwork^>^ Database::SelectArtwork(CardId^ cardid)
+{
+	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
 
-			// passcode
-			artwork->Format = column_string(statement, 2);
+	if(CLRISNULL(cardid)) throw gcnew ArgumentNullException("cardid");
 
-			// width
-			artwork->Width = sqlite3_column_int(statement, 3);
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Read);
 
-			// height
-			artwork->Height = sqlite3_column_int(statement, 4);
+	List<Artwork^>^ artworks = gcnew List<Artwork^>();
 
-			// image
-			int length = sqlite3_column_bytes(statement, 5);
-			if(length > 0) {
+	// artworkid | cardid | format | width | height
+	auto sql = L"select artworkid, cardid, format, width, height from artwork where cardid = ?1";
 
-				array<Byte>^ image = gcnew array<Byte>(length);
+	// Convert the cardid into a native key
+	uuidkey_t _cardid = cardid->ToKey();
 
-				void const* blob = sqlite3_column_blob(statement, 5);
-				if(blob != nullptr) {
+	// Acquire the prepared query from the statement cache
+	sqlite3_stmt* statement = instance.Statements->Acquire(instance, sql);
+	int result = SQLITE_OK;
 
-					Marshal::Copy(IntPtr(const_cast<void*>(blob)), image, 0, length);
-					artwork->Image = image;
-				}
-			}
+	try {
 
-			return artwork;
+		// Bind the query parameter(s)
+		result = sqlite3_bind_blob(statement, 1, &_cardid, sizeof(uuidkey_t), SQLITE_STATIC);
+		if(result != SQLITE_OK) throw gcnew SQLiteException(result);
+
+		// Execute the query and iterate over all returned rows
+		result = sqlite3_step(statement);
+		while(result == SQLITE_ROW) {
+
+			artworks->Add(row_artwork(this, m_strings, statement));	// Add the Artwork instance
+			result = sqlite3_step(statement);			// Move to the next result set row
 		}
 
-		else return nullptr;
+		// If the final result of the query was not SQLITE_DONE, something bad happened
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
 	}
 
-	finally { sqlite3_finalize(statement); }
+	finally { instance.Statements->Release(statement); }
+
+	return artworks;
 }
 
 //---------------------------------------------------------------------------
@@ -1439,77 +3799,146 @@ Artwork^ Database::SelectArtwork(ArtworkId^ artworkid)
 //
 // Arguments:
 //
-//	cardid	- Card identifier
+//	artworkids	- Collection of artwork identifiers
 
-List<Artwork^>^ Database::SelectArtwork(CardId^ cardid)
+List<Artwork^>^ Database::SelectArtwork(IEnumerable<ArtworkId^>^ artworkids)
 {
 	CHECK_DISPOSED(m_disposed);
 	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
 
-	if(CLRISNULL(cardid)) throw gcnew ArgumentNullException("cardid");
+	if(CLRISNULL(artworkids)) throw gcnew ArgumentNullException("artworkids");
 
-	SQLiteSafeHandle::Reference instance(m_handle);
-	sqlite3_stmt* statement;
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Read);
 
 	List<Artwork^>^ artworks = gcnew List<Artwork^>();
 
-	auto sql = L"select artworkid, cardid, format, width, height, image from artwork where cardid = ?1";
+	// artworkid | cardid | format | width | height
+	auto sql = L"select artworkid, cardid, format, width, height from artwork "
+		"where artworkid in (select value from uuidarray(?1))";
 
-	// Convert the cardid into a byte array and pin it
-	array<Byte>^ _cardid = cardid->ToByteArray();
-	pin_ptr<Byte> pincardid = &_cardid[0];
+	// Acquire the prepared query from the statement cache
+	sqlite3_stmt* statement = instance.Statements->Acquire(instance, sql);
+	int result = SQLITE_OK;
 
-	// Prepare the query
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	try {
+
+		// Bind the query parameter(s)
+		bind_uuidarray(statement, 1, artworkids);
+
+		// Execute the query and iterate over all returned rows
+		result = sqlite3_step(statement);
+		while(result == SQLITE_ROW) {
+
+			artworks->Add(row_artwork(this, m_strings, statement));	// Add the Artwork instance
+			result = sqlite3_step(statement);			// Move to the next result set row
+		}
+
+		// If the final result of the query was not SQLITE_DONE, something bad happened
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	}
+
+	finally { instance.Statements->Release(statement); }
+
+	return artworks;
+}
+
+//---------------------------------------------------------------------------
+// Database::SelectArtwork (internal)
+//
+// Selects artwork objects from the database
+//
+// Arguments:
+//
+//	cardids		- Collection of card identifiers
+
+Dictionary<CardId^, List<Artwork^>^>^ Database::SelectArtwork(IEnumerable<CardId^>^ cardids)
+{
+	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
+
+	if(CLRISNULL(cardids)) throw gcnew ArgumentNullException("cardids");
+
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Read);
+
+	// Every requested card identifier gets an entry, even if there is no artwork
+	Dictionary<CardId^, List<Artwork^>^>^ artworks = gcnew Dictionary<CardId^, List<Artwork^>^>();
+	for each(CardId^ cardid in cardids) if(CLRISNOTNULL(cardid)) artworks[cardid] = gcnew List<Artwork^>();
+
+	// artworkid | cardid | format | width | height
+	auto sql = L"select artworkid, cardid, format, width, height from artwork "
+		"where cardid in (select value from uuidarray(?1))";
+
+	// Acquire the prepared query from the statement cache
+	sqlite3_stmt* statement = instance.Statements->Acquire(instance, sql);
+	int result = SQLITE_OK;
 
 	try {
 
 		// Bind the query parameter(s)
-		result = sqlite3_bind_blob(statement, 1, pincardid, _cardid->Length, SQLITE_STATIC);
-		if(result != SQLITE_OK) throw gcnew SQLiteException(result);
+		bind_uuidarray(statement, 1, artworks->Keys);
 
 		// Execute the query and iterate over all returned rows
 		result = sqlite3_step(statement);
 		while(result == SQLITE_ROW) {
 
-			// artworkid | cardid
-			Artwork^ artwork = gcnew Artwork(this, gcnew ArtworkId(column_uuid(statement, 0)), gcnew CardId(column_uuid(statement, 1)));
+			Artwork^ artwork = row_artwork(this, m_strings, statement);
+
+			artworks[artwork->CardID]->Add(artwork);	// Add the Artwork instance
+			result = sqlite3_step(statement);			// Move to the next result set row
+		}
+
+		// If the final result of the query was not SQLITE_DONE, something bad happened
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	}
+
+	finally { instance.Statements->Release(statement); }
+
+	return artworks;
+}
+
+//---------------------------------------------------------------------------
+// Database::SelectArtworkImage (internal)
+//
+// Selects an artwork image from the database
+//
+// Arguments:
+//
+//	artworkid	- Artwork identifier
 
-			// passcode
-			artwork->Format = column_string(statement, 2);
+array<Byte>^ Database::SelectArtworkImage(ArtworkId^ artworkid)
+{
+	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
 
-			// width
-			artwork->Width = sqlite3_column_int(statement, 3);
+	if(CLRISNULL(artworkid)) throw gcnew ArgumentNullException("artworkid");
 
-			// height
-			artwork->Height = sqlite3_column_int(statement, 4);
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Read);
 
-			// image
-			int length = sqlite3_column_bytes(statement, 5);
-			if(length > 0) {
+	// image
+	auto sql = L"select image from artwork where artworkid = ?1";
 
-				array<Byte>^ image = gcnew array<Byte>(length);
+	// Convert the artworkid into a native key
+	uuidkey_t _artworkid = artworkid->ToKey();
 
-				void const* blob = sqlite3_column_blob(statement, 5);
-				if(blob != nullptr) {
+	// Acquire the prepared query from the statement cache
+	sqlite3_stmt* statement = instance.Statements->Acquire(instance, sql);
+	int result = SQLITE_OK;
 
-					Marshal::Copy(IntPtr(const_cast<void*>(blob)), image, 0, length);
-					artwork->Image = image;
-				}
-			}
+	try {
 
-			artworks->Add(artwork);						// Add the Card instance
-			result = sqlite3_step(statement);			// Move to the next result set row
-		}
+		// Bind the query parameter(s)
+		result = sqlite3_bind_blob(statement, 1, &_artworkid, sizeof(uuidkey_t), SQLITE_STATIC);
+		if(result != SQLITE_OK) throw gcnew SQLiteException(result);
 
-		// If the final result of the query was not SQLITE_DONE, something bad happened
-		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-	}
+		// Execute the query; there should be at most one row returned
+		result = sqlite3_step(statement);
+		if(result == SQLITE_ROW) return column_blob(statement, 0);
+		else if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
 
-	finally { sqlite3_finalize(statement); }
+		return nullptr;
+	}
 
-	return artworks;
+	finally { instance.Statements->Release(statement); }
 }
 
 //---------------------------------------------------------------------------
@@ -1526,31 +3955,36 @@ Card^ Database::SelectCard(CardId^ cardid)
 	CHECK_DISPOSED(m_disposed);
 	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
 
-	SQLiteSafeHandle::Reference instance(m_handle);
-	sqlite3_stmt* statement;
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Read);
 
-	// cards view
-	auto sql = L"select * from cards where cardid = ?1";
+	// Discard any cached objects if the database has changed
+	ValidateIdentityMaps();
 
-	// Convert the cardid into a byte array and pin it
-	array<Byte>^ _cardid = cardid->ToByteArray();
-	pin_ptr<Byte> pincardid = &_cardid[0];
+	// Return the existing Card instance if one is still alive
+	Card^ card = m_cards->Find(cardid);
+	if(CLRISNOTNULL(card)) return card;
 
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	// cardsummary table
+	auto sql = L"select * from cardsummary where cardid = ?1";
+
+	// Convert the cardid into a native key
+	uuidkey_t _cardid = cardid->ToKey();
+
+	sqlite3_stmt* statement = instance.Statements->Acquire(instance, sql);
+	int result = SQLITE_OK;
 
 	try {
 
 		// Bind the query parameter(s)
-		result = sqlite3_bind_blob(statement, 1, pincardid, _cardid->Length, SQLITE_STATIC);
+		result = sqlite3_bind_blob(statement, 1, &_cardid, sizeof(uuidkey_t), SQLITE_STATIC);
 		if(result != SQLITE_OK) throw gcnew SQLiteException(result);
 
 		// Execute the query; there should be at most one row returned
-		if(sqlite3_step(statement) == SQLITE_ROW) return row_cards(this, statement);
+		if(sqlite3_step(statement) == SQLITE_ROW) return row_cards(this, m_cards, statement);
 		else return nullptr;
 	}
 
-	finally { sqlite3_finalize(statement); }
+	finally { instance.Statements->Release(statement); }
 }
 
 //---------------------------------------------------------------------------
@@ -1570,36 +4004,37 @@ List<Card^>^ Database::SelectCards(RestrictionListId^ restrictionlistid, Restric
 
 	if(CLRISNULL(restrictionlistid)) throw gcnew ArgumentNullException("restrictionlistid");
 
-	SQLiteSafeHandle::Reference instance(m_handle);
-	sqlite3_stmt* statement;
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Read);
+
+	// Discard any cached objects if the database has changed
+	ValidateIdentityMaps();
 
 	List<Card^>^ cards = gcnew List<Card^>();
 
-	// cards view
-	auto sql = L"select cards.*, restriction(restriction.restriction) from cards "
-		"inner join restriction on cards.cardid = restriction.cardid "
-		"where restriction.restrictionlistid = ?1 and restriction = restrictionstr(?2) "
+	// cardsummary table
+	auto sql = L"select cardsummary.*, restriction.restriction from cardsummary "
+		"inner join restriction on cardsummary.cardid = restriction.cardid "
+		"where restriction.restrictionlistid = ?1 and restriction.restriction = ?2 "
 		"order by type, name asc";
 
-	// Convert the restrictionlistid into a byte array and pin it
-	array<Byte>^ _restrictionlistid = restrictionlistid->ToByteArray();
-	pin_ptr<Byte> pinrestrictionlistid = &_restrictionlistid[0];
+	// Convert the restrictionlistid into a native key
+	uuidkey_t _restrictionlistid = restrictionlistid->ToKey();
 
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	sqlite3_stmt* statement = instance.Statements->Acquire(instance, sql);
+	int result = SQLITE_OK;
 
 	try {
 
 		// Bind the query parameter(s)
-		result = sqlite3_bind_blob(statement, 1, pinrestrictionlistid, _restrictionlistid->Length, SQLITE_STATIC);
-		if(result == SQLITE_OK) sqlite3_bind_int(statement, 2, static_cast<int>(restriction));
+		result = sqlite3_bind_blob(statement, 1, &_restrictionlistid, sizeof(uuidkey_t), SQLITE_STATIC);
+		if(result == SQLITE_OK) result = sqlite3_bind_int(statement, 2, static_cast<int>(restriction));
 		if(result != SQLITE_OK) throw gcnew SQLiteException(result);
 
 		// Execute the query and iterate over all returned rows
 		result = sqlite3_step(statement);
 		while(result == SQLITE_ROW) {
 
-			cards->Add(row_cards(this, statement));		// Add the Card instance
+			cards->Add(row_cards(this, m_cards, statement));		// Add the Card instance
 			result = sqlite3_step(statement);			// Move to the next result set row
 		}
 
@@ -1607,7 +4042,7 @@ List<Card^>^ Database::SelectCards(RestrictionListId^ restrictionlistid, Restric
 		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
 	}
 
-	finally { sqlite3_finalize(statement); }
+	finally { instance.Statements->Release(statement); }
 
 	return cards;
 }
@@ -1628,39 +4063,40 @@ Dictionary<Card^, Restriction>^ Database::SelectCards(RestrictionListId^ restric
 
 	if(CLRISNULL(restrictionlistid)) throw gcnew ArgumentNullException("restrictionlistid");
 
-	SQLiteSafeHandle::Reference instance(m_handle);
-	sqlite3_stmt* statement;
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Read);
+
+	// Discard any cached objects if the database has changed
+	ValidateIdentityMaps();
 
 	Dictionary<Card^, Restriction>^ cards = gcnew Dictionary<Card^, Restriction>();
 
-	// cards view
-	auto sql = L"select cards.*, restriction(restriction.restriction) from cards "
-		"inner join restriction on cards.cardid = restriction.cardid "
+	// cardsummary table
+	auto sql = L"select cardsummary.*, restriction.restriction from cardsummary "
+		"inner join restriction on cardsummary.cardid = restriction.cardid "
 		"where restriction.restrictionlistid = ?1"
-		"order by restriction(restriction.restriction), type, name asc";
+		"order by restriction.restriction, type, name asc";
 
-	// Convert the restrictionlistid into a byte array and pin it
-	array<Byte>^ _restrictionlistid = restrictionlistid->ToByteArray();
-	pin_ptr<Byte> pinrestrictionlistid = &_restrictionlistid[0];
+	// Convert the restrictionlistid into a native key
+	uuidkey_t _restrictionlistid = restrictionlistid->ToKey();
 
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	sqlite3_stmt* statement = instance.Statements->Acquire(instance, sql);
+	int result = SQLITE_OK;
 
 	try {
 
 		// Bind the query parameter(s)
-		result = sqlite3_bind_blob(statement, 1, pinrestrictionlistid, _restrictionlistid->Length, SQLITE_STATIC);
+		result = sqlite3_bind_blob(statement, 1, &_restrictionlistid, sizeof(uuidkey_t), SQLITE_STATIC);
 		if(result != SQLITE_OK) throw gcnew SQLiteException(result);
 
 		// Execute the query and iterate over all returned rows
 		result = sqlite3_step(statement);
 		while(result == SQLITE_ROW) {
 
-			// Columns 0-28 are consumed by row_cards
-			Card^ card = row_cards(this, statement);
+			// Columns 0-29 are consumed by row_cards
+			Card^ card = row_cards(this, m_cards, statement);
 
 			// restriction
-			Restriction restriction = static_cast<Restriction>(sqlite3_column_int(statement, 29));
+			Restriction restriction = static_cast<Restriction>(sqlite3_column_int(statement, 30));
 
 			cards->Add(card, restriction);				// Add the Card instance
 			result = sqlite3_step(statement);			// Move to the next result set row
@@ -1670,7 +4106,58 @@ Dictionary<Card^, Restriction>^ Database::SelectCards(RestrictionListId^ restric
 		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
 	}
 
-	finally { sqlite3_finalize(statement); }
+	finally { instance.Statements->Release(statement); }
+
+	return cards;
+}
+
+//---------------------------------------------------------------------------
+// Database::SelectCards (internal)
+//
+// Selects Card objects from the database
+//
+// Arguments:
+//
+//	cardids		- Collection of card identifiers
+
+List<Card^>^ Database::SelectCards(IEnumerable<CardId^>^ cardids)
+{
+	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
+
+	if(CLRISNULL(cardids)) throw gcnew ArgumentNullException("cardids");
+
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Read);
+
+	// Discard any cached objects if the database has changed
+	ValidateIdentityMaps();
+
+	List<Card^>^ cards = gcnew List<Card^>();
+
+	// cardsummary table
+	auto sql = L"select * from cardsummary where cardid in (select value from uuidarray(?1)) order by name asc";
+
+	sqlite3_stmt* statement = instance.Statements->Acquire(instance, sql);
+	int result = SQLITE_OK;
+
+	try {
+
+		// Bind the query parameter(s)
+		bind_uuidarray(statement, 1, cardids);
+
+		// Execute the query and iterate over all returned rows
+		result = sqlite3_step(statement);
+		while(result == SQLITE_ROW) {
+
+			cards->Add(row_cards(this, m_cards, statement));		// Add the Card instance
+			result = sqlite3_step(statement);			// Move to the next result set row
+		}
+
+		// If the final result of the query was not SQLITE_DONE, something bad happened
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	}
+
+	finally { instance.Statements->Release(statement); }
 
 	return cards;
 }
@@ -1691,58 +4178,92 @@ List<Print^>^ Database::SelectPrints(CardId^ cardid)
 
 	if(CLRISNULL(cardid)) throw gcnew ArgumentNullException("cardid");
 
-	SQLiteSafeHandle::Reference instance(m_handle);
-	sqlite3_stmt* statement;
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Read);
+
+	// Discard any cached objects if the database has changed
+	ValidateIdentityMaps();
 
 	List<Print^>^ prints = gcnew List<Print^>();
 
-	// printid | cardid | seriesid | artworkid | code | language | number | rarity | limitededition | releasedate
+	// printid | cardid | seriesid | artworkid | code | language | number | rarity | limitededition | releaseday
 	auto sql = L"select print.printid, print.cardid, print.seriesid, print.artworkid, print.code, print.language, "
-		"print.number, printrarity(print.rarity), print.limitededition, print.releasedate from print where print.cardid = ?1 "
-		"order by print.releasedate asc";
+		"print.number, print.rarity, print.limitededition, print.releaseday from print where print.cardid = ?1 "
+		"order by print.releaseday asc";
 
-	// Convert the cardid into a byte array and pin it
-	array<Byte>^ _cardid = cardid->ToByteArray();
-	pin_ptr<Byte> pincardid = &_cardid[0];
+	// Convert the cardid into a native key
+	uuidkey_t _cardid = cardid->ToKey();
 
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	sqlite3_stmt* statement = instance.Statements->Acquire(instance, sql);
+	int result = SQLITE_OK;
 
 	try {
 
 		// Bind the query parameter(s)
-		result = sqlite3_bind_blob(statement, 1, pincardid, _cardid->Length, SQLITE_STATIC);
+		result = sqlite3_bind_blob(statement, 1, &_cardid, sizeof(uuidkey_t), SQLITE_STATIC);
 		if(result != SQLITE_OK) throw gcnew SQLiteException(result);
 
 		// Execute the query and iterate over all returned rows
 		result = sqlite3_step(statement);
 		while(result == SQLITE_ROW) {
 
-			// printid | cardid | seriesid | artworkid
-			Print^ print = gcnew Print(this, gcnew PrintId(column_uuid(statement, 0)),
-				gcnew CardId(column_uuid(statement, 1)), gcnew SeriesId(column_uuid(statement, 2)),
-				gcnew ArtworkId(column_uuid(statement, 3)));
+			prints->Add(row_prints(this, m_prints, m_strings, statement));	// Add the Print instance
+			result = sqlite3_step(statement);			// Move to the next result set row
+		}
+
+		// If the final result of the query was not SQLITE_DONE, something bad happened
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	}
+
+	finally { instance.Statements->Release(statement); }
+
+	return prints;
+}
+
+//---------------------------------------------------------------------------
+// Database::SelectPrints (internal)
+//
+// Selects Print objects from the database
+//
+// Arguments:
+//
+//	cardids		- Collection of card identifiers on which to filter the results
+
+Dictionary<CardId^, List<Print^>^>^ Database::SelectPrints(IEnumerable<CardId^>^ cardids)
+{
+	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
+
+	if(CLRISNULL(cardids)) throw gcnew ArgumentNullException("cardids");
+
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Read);
+
+	// Discard any cached objects if the database has changed
+	ValidateIdentityMaps();
 
-			// code
-			print->Code = column_string(statement, 4);
+	// Every requested card identifier gets an entry, even if there are no prints
+	Dictionary<CardId^, List<Print^>^>^ prints = gcnew Dictionary<CardId^, List<Print^>^>();
+	for each(CardId^ cardid in cardids) if(CLRISNOTNULL(cardid)) prints[cardid] = gcnew List<Print^>();
 
-			// language
-			print->Language = column_string(statement, 5);
+	// printid | cardid | seriesid | artworkid | code | language | number | rarity | limitededition | releaseday
+	auto sql = L"select print.printid, print.cardid, print.seriesid, print.artworkid, print.code, print.language, "
+		"print.number, print.rarity, print.limitededition, print.releaseday from print "
+		"where print.cardid in (select value from uuidarray(?1)) order by print.releaseday asc";
+
+	sqlite3_stmt* statement = instance.Statements->Acquire(instance, sql);
+	int result = SQLITE_OK;
 
-			// number
-			print->Number = column_string(statement, 6);
+	try {
 
-			// rarity
-			print->Rarity = static_cast<PrintRarity>(sqlite3_column_int(statement, 7));
+		// Bind the query parameter(s)
+		bind_uuidarray(statement, 1, prints->Keys);
 
-			// limitededition
-			print->LimitedEdition = sqlite3_column_int(statement, 8) != 0;
+		// Execute the query and iterate over all returned rows
+		result = sqlite3_step(statement);
+		while(result == SQLITE_ROW) {
 
-			// releasedate
-			wchar_t const* releasedateptr = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 9));
-			print->ReleaseDate = (releasedateptr == nullptr) ? DateTime::MinValue : DateTime::Parse(gcnew String(releasedateptr));
+			Print^ print = row_prints(this, m_prints, m_strings, statement);
 
-			prints->Add(print);							// Add the Print instance
+			prints[print->CardID]->Add(print);			// Add the Print instance
 			result = sqlite3_step(statement);			// Move to the next result set row
 		}
 
@@ -1750,7 +4271,7 @@ List<Print^>^ Database::SelectPrints(CardId^ cardid)
 		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
 	}
 
-	finally { sqlite3_finalize(statement); }
+	finally { instance.Statements->Release(statement); }
 
 	return prints;
 }
@@ -1771,25 +4292,23 @@ List<Ruling^>^ Database::SelectRulings(CardId^ cardid)
 
 	if(CLRISNULL(cardid)) throw gcnew ArgumentNullException("cardid");
 
-	SQLiteSafeHandle::Reference instance(m_handle);
-	sqlite3_stmt* statement;
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Read);
 
 	List<Ruling^>^ rulings = gcnew List<Ruling^>();
 
 	// sequence | ruling
 	auto sql = L"select ruling.sequence, ruling.ruling from ruling where ruling.cardid = ?1 order by ruling.sequence asc";
 
-	// Convert the cardid into a byte array and pin it
-	array<Byte>^ _cardid = cardid->ToByteArray();
-	pin_ptr<Byte> pincardid = &_cardid[0];
+	// Convert the cardid into a native key
+	uuidkey_t _cardid = cardid->ToKey();
 
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	sqlite3_stmt* statement = instance.Statements->Acquire(instance, sql);
+	int result = SQLITE_OK;
 
 	try {
 
 		// Bind the query parameter(s)
-		result = sqlite3_bind_blob(statement, 1, pincardid, _cardid->Length, SQLITE_STATIC);
+		result = sqlite3_bind_blob(statement, 1, &_cardid, sizeof(uuidkey_t), SQLITE_STATIC);
 		if(result != SQLITE_OK) throw gcnew SQLiteException(result);
 
 		// Execute the query and iterate over all returned rows
@@ -1812,7 +4331,69 @@ List<Ruling^>^ Database::SelectRulings(CardId^ cardid)
 		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
 	}
 
-	finally { sqlite3_finalize(statement); }
+	finally { instance.Statements->Release(statement); }
+
+	return rulings;
+}
+
+//---------------------------------------------------------------------------
+// Database::SelectRulings (internal)
+//
+// Selects Ruling objects from the database
+//
+// Arguments:
+//
+//	cardids		- Collection of card identifiers on which to filter the results
+
+Dictionary<CardId^, List<Ruling^>^>^ Database::SelectRulings(IEnumerable<CardId^>^ cardids)
+{
+	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
+
+	if(CLRISNULL(cardids)) throw gcnew ArgumentNullException("cardids");
+
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Read);
+
+	// Every requested card identifier gets an entry, even if there are no rulings
+	Dictionary<CardId^, List<Ruling^>^>^ rulings = gcnew Dictionary<CardId^, List<Ruling^>^>();
+	for each(CardId^ cardid in cardids) if(CLRISNOTNULL(cardid)) rulings[cardid] = gcnew List<Ruling^>();
+
+	// cardid | sequence | ruling
+	auto sql = L"select ruling.cardid, ruling.sequence, ruling.ruling from ruling "
+		"where ruling.cardid in (select value from uuidarray(?1)) order by ruling.cardid, ruling.sequence asc";
+
+	sqlite3_stmt* statement = instance.Statements->Acquire(instance, sql);
+	int result = SQLITE_OK;
+
+	try {
+
+		// Bind the query parameter(s)
+		bind_uuidarray(statement, 1, rulings->Keys);
+
+		// Execute the query and iterate over all returned rows
+		result = sqlite3_step(statement);
+		while(result == SQLITE_ROW) {
+
+			// cardid
+			CardId^ cardid = gcnew CardId(column_uuid(statement, 0));
+
+			Ruling^ ruling = gcnew Ruling();
+
+			// sequence
+			ruling->Sequence = sqlite3_column_int(statement, 1);
+
+			// text
+			ruling->Text = column_string(statement, 2);
+
+			rulings[cardid]->Add(ruling);				// Add the Ruling instance
+			result = sqlite3_step(statement);			// Move to the next result set row
+		}
+
+		// If the final result of the query was not SQLITE_DONE, something bad happened
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	}
+
+	finally { instance.Statements->Release(statement); }
 
 	return rulings;
 }
@@ -1831,52 +4412,111 @@ Series^ Database::SelectSeries(SeriesId^ seriesid)
 	CHECK_DISPOSED(m_disposed);
 	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
 
-	SQLiteSafeHandle::Reference instance(m_handle);
-	sqlite3_stmt* statement;
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Read);
+
+	// Discard any cached objects if the database has changed
+	ValidateIdentityMaps();
+
+	// Return the existing Series instance if one is still alive
+	Series^ series = m_series->Find(seriesid);
+	if(CLRISNOTNULL(series)) return series;
 
 	// seriesid | code | name | boosterpack | releasedate
-	auto sql = L"select series.seriesid, series.code, series.name, series.boosterpack, series.releasedate "
+	auto sql = L"select series.seriesid, series.code, series.name, series.boosterpack, series.releaseday "
 		"from series where seriesid = ?1";
 
-	// Convert the seriesid into a byte array and pin it
-	array<Byte>^ _seriesid = seriesid->ToByteArray();
-	pin_ptr<Byte> pincardid = &_seriesid[0];
+	// Convert the seriesid into a native key
+	uuidkey_t _seriesid = seriesid->ToKey();
 
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	sqlite3_stmt* statement = instance.Statements->Acquire(instance, sql);
+	int result = SQLITE_OK;
 
 	try {
 
 		// Bind the query parameter(s)
-		result = sqlite3_bind_blob(statement, 1, pincardid, _seriesid->Length, SQLITE_STATIC);
+		result = sqlite3_bind_blob(statement, 1, &_seriesid, sizeof(uuidkey_t), SQLITE_STATIC);
 		if(result != SQLITE_OK) throw gcnew SQLiteException(result);
 
 		// Execute the query; there should be at most one row returned
-		if(sqlite3_step(statement) == SQLITE_ROW) {
+		if(sqlite3_step(statement) == SQLITE_ROW) return row_series(this, m_series, m_strings, statement);
+		else return nullptr;
+	}
+
+	finally { instance.Statements->Release(statement); }
+}
+
+//---------------------------------------------------------------------------
+// Database::SelectSeries (internal)
+//
+// Selects Series objects from the database
+//
+// Arguments:
+//
+//	seriesids		- Collection of series identifiers
+
+List<Series^>^ Database::SelectSeries(IEnumerable<SeriesId^>^ seriesids)
+{
+	CHECK_DISPOSED(m_disposed);
+	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
+
+	if(CLRISNULL(seriesids)) throw gcnew ArgumentNullException("seriesids");
+
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Read);
+
+	// Discard any cached objects if the database has changed
+	ValidateIdentityMaps();
 
-			// seriesid
-			Series^ series = gcnew Series(this, gcnew SeriesId(column_uuid(statement, 0)));
+	List<Series^>^ series = gcnew List<Series^>();
 
-			// code
-			series->Code = column_string(statement, 1);
+	// seriesid | code | name | boosterpack | releasedate
+	auto sql = L"select series.seriesid, series.code, series.name, series.boosterpack, series.releaseday "
+		"from series where seriesid in (select value from uuidarray(?1))";
+
+	sqlite3_stmt* statement = instance.Statements->Acquire(instance, sql);
+	int result = SQLITE_OK;
 
-			// name
-			series->Name = column_string(statement, 2);
+	try {
 
-			// boosterpack
-			series->BoosterPack = sqlite3_column_int(statement, 3) != 0;
+		// Bind the query parameter(s)
+		bind_uuidarray(statement, 1, seriesids);
 
-			// releasedate
-			wchar_t const* releasedateptr = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 4));
-			series->ReleaseDate = (releasedateptr == nullptr) ? Nullable<DateTime>() : DateTime::Parse(gcnew String(releasedateptr));
+		// Execute the query and iterate over all returned rows
+		result = sqlite3_step(statement);
+		while(result == SQLITE_ROW) {
 
-			return series;
+			series->Add(row_series(this, m_series, m_strings, statement));	// Add the Series instance
+			result = sqlite3_step(statement);			// Move to the next result set row
 		}
 
-		else return nullptr;
+		// If the final result of the query was not SQLITE_DONE, something bad happened
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
 	}
 
-	finally { sqlite3_finalize(statement); }
+	finally { instance.Statements->Release(statement); }
+
+	return series;
+}
+
+//---------------------------------------------------------------------------
+// Database::StatementCacheHits::get
+//
+// Gets the number of prepared statements reused from the statement cache
+
+int64_t Database::StatementCacheHits::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return m_pool->StatementCacheHits;
+}
+
+//---------------------------------------------------------------------------
+// Database::StatementCacheMisses::get
+//
+// Gets the number of prepared statements created by the statement cache
+
+int64_t Database::StatementCacheMisses::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+	return m_pool->StatementCacheMisses;
 }
 
 //---------------------------------------------------------------------------
@@ -1901,14 +4541,12 @@ void Database::UpdateArtwork(ArtworkId^ artworkid, String^ format, int width, in
 	if(CLRISNULL(format)) throw gcnew ArgumentNullException("format");
 	if(CLRISNULL(image)) throw gcnew ArgumentNullException("image");
 
-	SQLiteSafeHandle::Reference instance(m_handle);
-	sqlite3_stmt* statement;
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Write);
 
 	auto sql = L"update artwork set format = ?1, width = ?2, height = ?3, image = ?4 where artworkid = ?5";
 
-	// Convert the artworkid into a byte array and pin it
-	array<Byte>^ _artworkid = artworkid->ToByteArray();
-	pin_ptr<Byte> pinartworkid = &_artworkid[0];
+	// Convert the artworkid into a native key
+	uuidkey_t _artworkid = artworkid->ToKey();
 
 	// Pin the format string
 	pin_ptr<wchar_t const> pinformat = PtrToStringChars(format);
@@ -1916,9 +4554,9 @@ void Database::UpdateArtwork(ArtworkId^ artworkid, String^ format, int width, in
 	// Pin the image data
 	pin_ptr<Byte> pinimage = &image[0];
 
-	// Prepare the query
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	// Acquire the prepared query from the statement cache
+	sqlite3_stmt* statement = instance.Statements->Acquire(instance, sql);
+	int result = SQLITE_OK;
 
 	try {
 
@@ -1927,7 +4565,7 @@ void Database::UpdateArtwork(ArtworkId^ artworkid, String^ format, int width, in
 		if(result == SQLITE_OK) result = sqlite3_bind_int(statement, 2, width);
 		if(result == SQLITE_OK) result = sqlite3_bind_int(statement, 3, height);
 		if(result == SQLITE_OK) result = sqlite3_bind_blob(statement, 4, pinimage, image->Length, SQLITE_STATIC);
-		if(result == SQLITE_OK) result = sqlite3_bind_blob(statement, 5, pinartworkid, _artworkid->Length, SQLITE_STATIC);
+		if(result == SQLITE_OK) result = sqlite3_bind_blob(statement, 5, &_artworkid, sizeof(uuidkey_t), SQLITE_STATIC);
 		if(result != SQLITE_OK) throw gcnew SQLiteException(result);
 
 		// Execute the query; no rows are expected to be returned
@@ -1935,20 +4573,20 @@ void Database::UpdateArtwork(ArtworkId^ artworkid, String^ format, int width, in
 		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
 	}
 
-	finally { sqlite3_finalize(statement); }
+	finally { instance.Statements->Release(statement); }
 }
 
 //---------------------------------------------------------------------------
 // Database::UpdateCardRulings (internal)
 //
-// Updates the rulings for a Card in the database
+// Updates the rulings for a Card in the database and returns the number of ruling rows written
 //
 // Arguments:
 //
 //	cardid		- Unique identifier
 //	rulings		- Enumerable collection of card ruling strings
 
-void Database::UpdateCardRulings(CardId^ cardid, IEnumerable<String^>^ rulings)
+int Database::UpdateCardRulings(CardId^ cardid, IEnumerable<String^>^ rulings)
 {
 	CHECK_DISPOSED(m_disposed);
 	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
@@ -1956,52 +4594,119 @@ void Database::UpdateCardRulings(CardId^ cardid, IEnumerable<String^>^ rulings)
 	if(CLRISNULL(cardid)) throw gcnew ArgumentNullException("cardid");
 	if(CLRISNULL(rulings)) throw gcnew ArgumentNullException("rulings");
 
-	SQLiteSafeHandle::Reference instance(m_handle);
-	sqlite3_stmt* statement;
+	List<String^>^ newrulings = gcnew List<String^>(rulings);
+	if(newrulings->Contains(nullptr)) throw gcnew ArgumentException("Ruling text cannot be null", "rulings");
 
-	auto sql = L"insert into ruling values(?1, ?2, ?3)";
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Write);
 
-	// Convert the cardid into a byte array and pin it
-	array<Byte>^ _cardid = cardid->ToByteArray();
-	pin_ptr<Byte> pincardid = &_cardid[0];
+	List<int>^ oldsequences = gcnew List<int>();
+	List<String^>^ oldrulings = gcnew List<String^>();
+	int written = 0;
 
-	// Prepare the query
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	bool nested = operation_begin(instance);
 
 	try {
 
-		execute_non_query(instance, L"begin immediate transaction");
-		execute_non_query(instance, L"delete from ruling where cardid = ?1", cardid);
+		// sequence | ruling
+		auto sql = L"select sequence, ruling from ruling where cardid = ?1 order by sequence asc";
 
-		int sequence = 1;
-		for each(String^ ruling in rulings)
-		{
-			// Pin the ruling text
-			pin_ptr<wchar_t const> pinruling = PtrToStringChars(ruling);
+		// Convert the cardid into a native key
+		uuidkey_t _cardid = cardid->ToKey();
+
+		sqlite3_stmt* statement = instance.Statements->Acquire(instance, sql);
+		int result = SQLITE_OK;
+
+		try {
 
 			// Bind the query parameter(s)
-			result = sqlite3_bind_blob(statement, 1, pincardid, _cardid->Length, SQLITE_STATIC);
-			if(result == SQLITE_OK) sqlite3_bind_int(statement, 2, sequence);
-			if(result == SQLITE_OK) result = sqlite3_bind_text16(statement, 3, pinruling, -1, SQLITE_STATIC);
+			result = sqlite3_bind_blob(statement, 1, &_cardid, sizeof(uuidkey_t), SQLITE_STATIC);
 			if(result != SQLITE_OK) throw gcnew SQLiteException(result);
 
-			// Execute the query; no rows are expected to be returned
+			// Execute the query and iterate over all returned rows
 			result = sqlite3_step(statement);
+			while(result == SQLITE_ROW) {
+
+				oldsequences->Add(sqlite3_column_int(statement, 0));
+				oldrulings->Add(column_string(statement, 1));
+
+				result = sqlite3_step(statement);			// Move to the next result set row
+			}
+
+			// If the final result of the query was not SQLITE_DONE, something bad happened
 			if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+		}
+
+		finally { instance.Statements->Release(statement); }
 
-			sqlite3_clear_bindings(statement);				// Clear statement bindings
-			sqlite3_reset(statement);						// Reset statement for next iteration
+		array<int>^ sources = gcnew array<int>(newrulings->Count);
+		array<int>^ sequences = gcnew array<int>(newrulings->Count);
 
-			sequence++;										// Increment the sequence number
+		if(plan_rulings(oldsequences, oldrulings, newrulings, RULING_SEQUENCE_GAP, sources, sequences)) {
+
+			// Stored rows that are not reused by any of the new rulings are deleted first
+			array<bool>^ reused = gcnew array<bool>(oldrulings->Count);
+			for each(int source in sources) if(source >= 0) reused[source] = true;
+
+			for(int index = 0; index < oldrulings->Count; index++) {
+
+				int oldsequence = oldsequences[index];
+				if(!reused[index]) written += execute_cached_non_query(instance, L"delete from ruling where cardid = ?1 and sequence = ?2", 
+					cardid, oldsequence);
+			}
+
+			// Edited rulings keep their sequence; the text of the stored row is replaced
+			for(int index = 0; index < newrulings->Count; index++) {
+
+				int source = sources[index];
+				int sequence = sequences[index];
+				String^ ruling = newrulings[index];
+
+				if((source >= 0) && (oldsequences[source] == sequence) && !String::Equals(oldrulings[source], ruling))
+					written += execute_cached_non_query(instance, L"update ruling set ruling = ?3 where cardid = ?1 and sequence = ?2", 
+						cardid, sequence, ruling);
+			}
+
+			// Moved rulings are renumbered in place and inserted rulings are added into the gaps;
+			// the planned sequence numbers never collide with a row that still exists
+			for(int index = 0; index < newrulings->Count; index++) {
+
+				int source = sources[index];
+				int sequence = sequences[index];
+				String^ ruling = newrulings[index];
+
+				if(source < 0) written += execute_cached_non_query(instance, L"insert into ruling values(?1, ?2, ?3)", cardid, sequence, ruling);
+				else {
+
+					int oldsequence = oldsequences[source];
+					if(oldsequence != sequence) written += execute_cached_non_query(instance, 
+						L"update ruling set sequence = ?3 where cardid = ?1 and sequence = ?2", cardid, oldsequence, sequence);
+				}
+			}
 		}
 
-		execute_non_query(instance, L"commit transaction");
+		else {
+
+			// A gap between sequence numbers has been exhausted; renumber all of the rulings
+			written += execute_non_query(instance, L"delete from ruling where cardid = ?1", cardid);
+
+			int sequence = 0;
+			for each(String^ ruling in newrulings) {
+
+				sequence += RULING_SEQUENCE_GAP;
+				written += execute_cached_non_query(instance, L"insert into ruling values(?1, ?2, ?3)", cardid, sequence, ruling);
+			}
+		}
+
+		// Refresh the rulings for the card in the full-text index
+		if(written > 0) execute_non_query(instance, L"update cardsearch set rulings = (select group_concat(ruling, char(10)) "
+			"from ruling where cardid = ?1) where rowid = (select searchid from cardsearchkey where cardid = ?1)", cardid);
+
+		operation_commit(instance, nested);
 	}
 
-	catch(Exception^) { execute_non_query(instance, L"rollback transaction"); throw; }
+	catch(Exception^) { operation_rollback(instance, nested); throw; }
 
-	finally { sqlite3_finalize(statement); }
+	return written;
 }
 
 //---------------------------------------------------------------------------
@@ -2021,35 +4726,46 @@ void Database::UpdateCardText(CardId^ cardid, String^ text)
 	if(CLRISNULL(cardid)) throw gcnew ArgumentNullException("cardid");
 	if(CLRISNULL(text)) throw gcnew ArgumentNullException("text");
 
-	SQLiteSafeHandle::Reference instance(m_handle);
-	sqlite3_stmt* statement;
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Write);
 
 	auto sql = L"update card set text = ?1 where cardid = ?2";
 
-	// Convert the cardid into a byte array and pin it
-	array<Byte>^ _cardid = cardid->ToByteArray();
-	pin_ptr<Byte> pincardid = &_cardid[0];
+	// Convert the cardid into a native key
+	uuidkey_t _cardid = cardid->ToKey();
 
 	// Pin the text string
 	pin_ptr<wchar_t const> pintext = PtrToStringChars(text);
 
-	// Prepare the query
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	// Begin the operation before acquiring the statement; a failed begin has nothing to release
+	bool nested = operation_begin(instance);
+
+	// Acquire the prepared query from the statement cache
+	sqlite3_stmt* statement = nullptr;
+	int result = SQLITE_OK;
 
 	try {
 
+		statement = instance.Statements->Acquire(instance, sql);
+
 		// Bind the query parameter(s)
 		result = sqlite3_bind_text16(statement, 1, pintext, -1, SQLITE_STATIC);
-		if(result == SQLITE_OK) result = sqlite3_bind_blob(statement, 2, pincardid, _cardid->Length, SQLITE_STATIC);
+		if(result == SQLITE_OK) result = sqlite3_bind_blob(statement, 2, &_cardid, sizeof(uuidkey_t), SQLITE_STATIC);
 		if(result != SQLITE_OK) throw gcnew SQLiteException(result);
 
 		// Execute the query; no rows are expected to be returned
 		result = sqlite3_step(statement);
 		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+
+		// Refresh the text for the card in the full-text index
+		execute_non_query(instance, L"update cardsearch set text = ?1 where rowid = "
+			"(select searchid from cardsearchkey where cardid = ?2)", text, cardid);
+
+		operation_commit(instance, nested);
 	}
 
-	finally { sqlite3_finalize(statement); }
+	catch(Exception^) { operation_rollback(instance, nested); throw; }
+
+	finally { if(statement != nullptr) instance.Statements->Release(statement); }
 }
 
 //---------------------------------------------------------------------------
@@ -2070,29 +4786,26 @@ void Database::UpdateDefaultArtwork(CardId^ cardid, ArtworkId^ artworkid)
 	if(CLRISNULL(cardid)) throw gcnew ArgumentNullException("cardid");
 	if(CLRISNULL(artworkid)) throw gcnew ArgumentNullException("artworkid");
 
-	SQLiteSafeHandle::Reference instance(m_handle);
-	sqlite3_stmt* statement;
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Write);
 
 	auto sql = L"insert into defaultartwork values(?1, ?2) "
 		"on conflict(cardid) do update set artworkid = excluded.artworkid";
 
-	// Convert the cardid into a byte array and pin it
-	array<Byte>^ _cardid = cardid->ToByteArray();
-	pin_ptr<Byte> pincardid = &_cardid[0];
+	// Convert the cardid into a native key
+	uuidkey_t _cardid = cardid->ToKey();
 
-	// Convert the artworkid into a byte array and pin it
-	array<Byte>^ _artworkid = artworkid->ToByteArray();
-	pin_ptr<Byte> pinartworkid = &_artworkid[0];
+	// Convert the artworkid into a native key
+	uuidkey_t _artworkid = artworkid->ToKey();
 
-	// Prepare the query
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	// Acquire the prepared query from the statement cache
+	sqlite3_stmt* statement = instance.Statements->Acquire(instance, sql);
+	int result = SQLITE_OK;
 
 	try {
 
 		// Bind the query parameter(s)
-		result = sqlite3_bind_blob(statement, 1, pincardid, _cardid->Length, SQLITE_STATIC);
-		if(result == SQLITE_OK) result = sqlite3_bind_blob(statement, 2, pinartworkid, _artworkid->Length, SQLITE_STATIC);
+		result = sqlite3_bind_blob(statement, 1, &_cardid, sizeof(uuidkey_t), SQLITE_STATIC);
+		if(result == SQLITE_OK) result = sqlite3_bind_blob(statement, 2, &_artworkid, sizeof(uuidkey_t), SQLITE_STATIC);
 		if(result != SQLITE_OK) throw gcnew SQLiteException(result);
 
 		// Execute the query; no rows are expected to be returned
@@ -2100,7 +4813,33 @@ void Database::UpdateDefaultArtwork(CardId^ cardid, ArtworkId^ artworkid)
 		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
 	}
 
-	finally { sqlite3_finalize(statement); }
+	finally { instance.Statements->Release(statement); }
+}
+
+//---------------------------------------------------------------------------
+// Database::ValidateIdentityMaps (private)
+//
+// Discards cached objects if the database has changed and returns the version
+//
+// Arguments:
+//
+//	NONE
+
+int64_t Database::ValidateIdentityMaps(void)
+{
+	// An immutable database cannot change, the cached objects are always valid
+	if(m_immutable) return 0;
+
+	// The version is observed through the connection leased for the read; a nested read
+	// lease on this thread shares it and a thread that holds the writer reads on the writer
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Read);
+	int64_t version = instance.Version;
+
+	m_cards->Validate(version);
+	m_prints->Validate(version);
+	m_series->Validate(version);
+
+	return version;
 }
 
 //---------------------------------------------------------------------------
@@ -2132,7 +4871,7 @@ int64_t Database::Vacuum([OutAttribute] int64_t% oldsize)
 	CHECK_DISPOSED(m_disposed);
 	CLRASSERT(CLRISNOTNULL(m_handle) && (m_handle->IsClosed == false));
 
-	SQLiteSafeHandle::Reference instance(m_handle);
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Write);
 
 	// Get the size of the database prior to vacuuming
 	int pagesize = execute_scalar_int(instance, L"pragma page_size");
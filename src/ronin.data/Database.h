@@ -28,24 +28,34 @@
 
 #include "Artwork.h"
 #include "ArtworkId.h"
+#include "ArtworkStream.h"
+#include "CardBitmapIndex.h"
+#include "CardCatalog.h"
+#include "CardFilter.h"
 #include "Card.h"
 #include "CardId.h"
+#include "CardSearchResult.h"
+#include "ConnectionPool.h"
+#include "DatabaseBatch.h"
+#include "DatabaseCursor.h"
+#include "dbextension.h"
+#include "IdentityMap.h"
+#include "ParallelEnumerator.h"
 #include "Print.h"
 #include "PrintId.h"
+#include "ReleaseIndex.h"
 #include "RestrictionList.h"
 #include "RestrictionListId.h"
 #include "Ruling.h"
 #include "SeriesId.h"
 #include "SQLiteSafeHandle.h"
+#include "StringPool.h"
 
 using namespace System;
 using namespace System::Collections::Generic;
+using namespace System::IO;
 using namespace System::Runtime::InteropServices;
 
-// dbextension.cpp
-//
-extern "C" int sqlite3_extension_init(sqlite3* db, char** errmsg, const sqlite3_api_routines* api);
-
 namespace zuki::ronin::data {
 
 //---------------------------------------------------------------------------
@@ -61,6 +71,11 @@ public:
 	//-----------------------------------------------------------------------
 	// Member Functions
 
+	// BeginBatch
+	//
+	// Begins a unit of work that groups updates into a single transaction
+	DatabaseBatch^ BeginBatch(void);
+
 	// EnumerateArtwork
 	//
 	// Enumerates Artwork from the database
@@ -71,16 +86,27 @@ public:
 	// Enumerates Cards from the database
 	void EnumerateCards(Action<Card^>^ callback);
 	void EnumerateCards(DateTime releasedate, Action<Card^>^ callback);
+	IEnumerable<Card^>^ EnumerateCards(void);
+	IEnumerable<Card^>^ EnumerateCards(DateTime releasedate);
+	void EnumerateCards(Action<Card^>^ callback, int capacity, int consumers);
+
+	// EnumerateCardsAsOf
+	//
+	// Enumerates the Cards released as of a date and their restriction at that date
+	void EnumerateCardsAsOf(DateTime date, Action<Card^, Restriction>^ callback);
 
 	// EnumerateCardsWithRulings
 	//
 	// Enumerates Cards from the database that have Rulings
 	void EnumerateCardsWithRulings(Action<Card^>^ callback);
+	IEnumerable<Card^>^ EnumerateCardsWithRulings(void);
 
 	// EnumeratePrints
 	//
 	// Enumerates Prints from the database
 	void EnumeratePrints(Action<Print^>^ callback);
+	IEnumerable<Print^>^ EnumeratePrints(void);
+	void EnumeratePrints(Action<Print^>^ callback, int capacity, int consumers);
 
 	// EnumerateRestrictionLists
 	//
@@ -91,22 +117,65 @@ public:
 	//
 	// Enumerates Rulings from the database
 	void EnumerateRulings(Action<Ruling^>^ callback);
+	IEnumerable<Ruling^>^ EnumerateRulings(void);
 
 	// Export
 	//
 	// Exports the database into flat files for storage
 	void Export(String^ path);
 
+	// GetArtwork
+	//
+	// Gets the Artwork associated with a collection of Cards
+	Dictionary<Card^, List<Artwork^>^>^ GetArtwork(IEnumerable<Card^>^ cards);
+
+	// GetRulings
+	//
+	// Gets the Rulings associated with a collection of Cards
+	Dictionary<Card^, List<Ruling^>^>^ GetRulings(IEnumerable<Card^>^ cards);
+
 	// Import
 	//
 	// Creates a new database instance via import
 	static Database^ Import(String^ path, String^ outputfile);
 
+	// LoadCardBitmapIndex
+	//
+	// Loads the card attribute sets from the database into a bitmap index
+	CardBitmapIndex^ LoadCardBitmapIndex(void);
+
+	// LoadCardCatalog
+	//
+	// Loads the Cards from the database into a columnar in-memory catalog
+	CardCatalog^ LoadCardCatalog(void);
+
 	// Open
 	//
 	// Opens a new database instance
 	static Database^ Open(String^ path);
 	static Database^ Open(String^ path, bool readonly);
+	static Database^ Open(String^ path, bool readonly, int readers);
+
+	// OpenImmutable
+	//
+	// Opens a new read-only database instance that will not be modified
+	static Database^ OpenImmutable(String^ path);
+
+	// OpenInMemory
+	//
+	// Opens a new database instance from a private in-memory copy of a database file
+	static Database^ OpenInMemory(String^ path);
+
+	// QueryCards
+	//
+	// Selects the Cards that match a CardFilter from the database
+	List<Card^>^ QueryCards(CardFilter^ filter);
+
+	// SearchCards
+	//
+	// Performs a ranked full-text search of card names, text and rulings
+	List<CardSearchResult^>^ SearchCards(String^ query, int limit);
+	List<CardSearchResult^>^ SearchCards(String^ query, int limit, String^ highlightbegin, String^ highlightend);
 
 	// Vacuum
 	//
@@ -114,6 +183,34 @@ public:
 	int64_t Vacuum(void);
 	int64_t Vacuum([OutAttribute] int64_t% oldsize);
 
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// CursorBatchSize
+	//
+	// Gets/sets the number of rows read at a time by enumerable query results
+	property int CursorBatchSize
+	{
+		int get(void);
+		void set(int value);
+	}
+
+	// StatementCacheHits
+	//
+	// Gets the number of prepared statements reused from the statement cache
+	property int64_t StatementCacheHits
+	{
+		int64_t get(void);
+	}
+
+	// StatementCacheMisses
+	//
+	// Gets the number of prepared statements created by the statement cache
+	property int64_t StatementCacheMisses
+	{
+		int64_t get(void);
+	}
+
 internal:
 
 	// InsertArtwork
@@ -121,6 +218,11 @@ internal:
 	// Inserts a new artwork image into the database
 	ArtworkId^ InsertArtwork(CardId^ cardid, String^ format, int width, int height, array<Byte>^ image);
 
+	// OpenArtworkImage
+	//
+	// Opens a read-only stream against an artwork image in the database
+	Stream^ OpenArtworkImage(ArtworkId^ artworkid);
+
 	// SelectArtwork
 	//
 	// Selects a single artwork object from the database
@@ -130,6 +232,13 @@ internal:
 	//
 	// Selects artwork objects from the database
 	List<Artwork^>^ SelectArtwork(CardId^ cardid);
+	List<Artwork^>^ SelectArtwork(IEnumerable<ArtworkId^>^ artworkids);
+	Dictionary<CardId^, List<Artwork^>^>^ SelectArtwork(IEnumerable<CardId^>^ cardids);
+
+	// SelectArtworkImage
+	//
+	// Selects an artwork image from the database
+	array<Byte>^ SelectArtworkImage(ArtworkId^ artworkid);
 
 	// SelectCard
 	//
@@ -141,21 +250,25 @@ internal:
 	// Selects Card objects from the database
 	List<Card^>^ SelectCards(RestrictionListId^ restrictionlistid, Restriction restriction);
 	Dictionary<Card^, Restriction>^ SelectCards(RestrictionListId^ restrictionlistid);
+	List<Card^>^ SelectCards(IEnumerable<CardId^>^ cardids);
 
 	// SelectPrints
 	//
 	// Selects Print objects from the database
 	List<Print^>^ SelectPrints(CardId^ cardid);
+	Dictionary<CardId^, List<Print^>^>^ SelectPrints(IEnumerable<CardId^>^ cardids);
 
 	// SelectRulings
 	//
 	// Selects Ruling objects from the database
 	List<Ruling^>^ SelectRulings(CardId^ cardid);
+	Dictionary<CardId^, List<Ruling^>^>^ SelectRulings(IEnumerable<CardId^>^ cardids);
 
 	// SelectSeries
 	//
-	// Selects a single Series object from the database
+	// Selects Series objects from the database
 	Series^ SelectSeries(SeriesId^ seriesid);
+	List<Series^>^ SelectSeries(IEnumerable<SeriesId^>^ seriesids);
 
 	// UpdateArtwork
 	//
@@ -165,7 +278,7 @@ internal:
 	// UpdateCardRulings
 	//
 	// Updates the rulings for a Card in the database
-	void UpdateCardRulings(CardId^ cardid, IEnumerable<String^>^ rulings);
+	int UpdateCardRulings(CardId^ cardid, IEnumerable<String^>^ rulings);
 
 	// UpdateCardText
 	//
@@ -185,25 +298,182 @@ private:
 
 	// Instance Constructor
 	//
-	Database(SQLiteSafeHandle^ handle);
+	Database(SQLiteSafeHandle^ handle, String^ path, int readers, bool immutable);
 
 	// Destructor
 	//
 	~Database();
 
+	//-----------------------------------------------------------------------
+	// Class CardCursor
+	//
+	// DatabaseCursor implementation for Card objects
+	//-----------------------------------------------------------------------
+
+	ref class CardCursor : public DatabaseCursor<Card^>
+	{
+	public:
+
+		// Instance Constructor
+		//
+		CardCursor(Database^ database, String^ sql, Object^ parameter);
+
+	protected:
+
+		//-------------------------------------------------------------------
+		// Protected Member Functions
+
+		// OnBind (DatabaseCursor)
+		//
+		// Binds the query parameters to a newly acquired statement
+		virtual void OnBind(sqlite3_stmt* statement) override;
+
+		// OnOpen (DatabaseCursor)
+		//
+		// Invoked before the statement is acquired for a new enumerator
+		virtual void OnOpen(void) override;
+
+		// OnRead (DatabaseCursor)
+		//
+		// Converts the current result set row into an object instance
+		virtual Card^ OnRead(sqlite3_stmt* statement, int64_t version) override;
+
+	private:
+
+		//-------------------------------------------------------------------
+		// Member Variables
+
+		initonly Database^		m_database;			// Parent Database instance
+		initonly Object^		m_parameter;		// Optional query parameter
+	};
+
+	//-----------------------------------------------------------------------
+	// Class PrintCursor
+	//
+	// DatabaseCursor implementation for Print objects
+	//-----------------------------------------------------------------------
+
+	ref class PrintCursor : public DatabaseCursor<Print^>
+	{
+	public:
+
+		// Instance Constructor
+		//
+		PrintCursor(Database^ database, String^ sql);
+
+	protected:
+
+		//-------------------------------------------------------------------
+		// Protected Member Functions
+
+		// OnOpen (DatabaseCursor)
+		//
+		// Invoked before the statement is acquired for a new enumerator
+		virtual void OnOpen(void) override;
+
+		// OnRead (DatabaseCursor)
+		//
+		// Converts the current result set row into an object instance
+		virtual Print^ OnRead(sqlite3_stmt* statement, int64_t version) override;
+
+	private:
+
+		//-------------------------------------------------------------------
+		// Member Variables
+
+		initonly Database^		m_database;			// Parent Database instance
+	};
+
+	//-----------------------------------------------------------------------
+	// Class RulingCursor
+	//
+	// DatabaseCursor implementation for Ruling objects
+	//-----------------------------------------------------------------------
+
+	ref class RulingCursor : public DatabaseCursor<Ruling^>
+	{
+	public:
+
+		// Instance Constructor
+		//
+		RulingCursor(Database^ database, String^ sql);
+
+	protected:
+
+		//-------------------------------------------------------------------
+		// Protected Member Functions
+
+		// OnRead (DatabaseCursor)
+		//
+		// Converts the current result set row into an object instance
+		virtual Ruling^ OnRead(sqlite3_stmt* statement, int64_t version) override;
+	};
+
 	//-----------------------------------------------------------------------
 	// Private Member Functions
 
+	// GetReleaseIndex
+	//
+	// Gets the as-of-date index for a database version, loading it as necessary
+	ReleaseIndex^ GetReleaseIndex(ConnectionPool::Lease% instance, int64_t version);
+
 	// InitializeInstance (static)
 	//
 	// Initializes the database instance for use
 	static void InitializeInstance(SQLiteSafeHandle^ handle);
 
+	// ValidateIdentityMaps
+	//
+	// Discards cached objects if the database has changed and returns the version
+	int64_t ValidateIdentityMaps(void);
+
+	//-----------------------------------------------------------------------
+	// Private Constants
+
+	// DEFAULT_CURSOR_BATCH_SIZE
+	//
+	// Default number of rows read at a time by enumerable query results
+	literal int DEFAULT_CURSOR_BATCH_SIZE = 64;
+
+	// DEFAULT_READ_CONNECTIONS
+	//
+	// Default maximum number of pooled read-only connections
+	literal int DEFAULT_READ_CONNECTIONS = 8;
+
+	// DEFAULT_STRING_POOL_CAPACITY
+	//
+	// Maximum number of interned low-cardinality text column values
+	literal int DEFAULT_STRING_POOL_CAPACITY = 4096;
+
+	// IMPORT_QUEUE_DEPTH
+	//
+	// Maximum number of import files parsed ahead of the insert statement
+	literal int IMPORT_QUEUE_DEPTH = 16;
+
+	// RULING_SEQUENCE_GAP
+	//
+	// Distance between the sequence numbers assigned to consecutive rulings
+	literal int RULING_SEQUENCE_GAP = 1024;
+
+	// SCHEMA_VERSION
+	//
+	// Current database schema version
+	literal int SCHEMA_VERSION = 13;
+
 	//-----------------------------------------------------------------------
 	// Member Variables
 
 	bool					m_disposed = false;		// Object disposal flag
 	SQLiteSafeHandle^		m_handle;				// Database safe handle
+	ConnectionPool^			m_pool;					// Connection pool
+	bool					m_immutable;			// Immutable database flag
+	int						m_batchsize = DEFAULT_CURSOR_BATCH_SIZE;	// Cursor batch size
+
+	IdentityMap<CardId^, Card^>^		m_cards;		// Card identity map
+	IdentityMap<PrintId^, Print^>^		m_prints;		// Print identity map
+	IdentityMap<SeriesId^, Series^>^	m_series;		// Series identity map
+	ReleaseIndex^						m_releaseindex;	// As-of-date index
+	StringPool^							m_strings;		// Text column intern pool
 	
 	static int				s_result = SQLITE_OK;	// Result from static init
 };
@@ -0,0 +1,187 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "DatabaseBatch.h"
+
+#include "SQLiteException.h"
+
+#pragma warning(push, 4)
+
+using namespace System::Threading;
+
+namespace zuki::ronin::data {
+
+//---------------------------------------------------------------------------
+// DatabaseBatch Constructor (internal)
+//
+// Arguments:
+//
+//	pool		- ConnectionPool to lease the writer connection from
+
+DatabaseBatch::DatabaseBatch(ConnectionPool^ pool)
+{
+	if(CLRISNULL(pool)) throw gcnew ArgumentNullException("pool");
+
+	m_thread = Thread::CurrentThread->ManagedThreadId;
+
+	// The writer lease is held until the batch is committed or disposed of; any
+	// other lease taken by this thread in the meantime shares the writer
+	m_lease = gcnew ConnectionPool::Lease(pool, ConnectionPool::LeaseMode::Write);
+
+	try {
+
+		// A batch started inside another batch becomes a savepoint of the outer batch
+		m_nested = (sqlite3_get_autocommit(*m_lease) == 0);
+		Execute(m_nested ? L"savepoint batch" : L"begin immediate transaction");
+
+		// The outermost batch owns the writer; if the batch is collected without being
+		// disposed of, the pool rolls back the transaction and releases the writer
+		if(!m_nested) m_lease->Guard(this);
+	}
+
+	catch(Exception^) { delete m_lease; m_lease = nullptr; throw; }
+}
+
+//---------------------------------------------------------------------------
+// DatabaseBatch Destructor
+
+DatabaseBatch::~DatabaseBatch()
+{
+	if(m_disposed) return;
+
+	// The writer connection cannot be used from another thread; the outermost batch
+	// hands the writer back to the pool to be rolled back once the owning thread has
+	// released any other leases, a nested batch is left for the outer batch to undo
+	if(CLRISNOTNULL(m_lease) && (Thread::CurrentThread->ManagedThreadId != m_thread)) {
+
+		try { if(m_nested) delete m_lease; else m_lease->Abandon(); }
+		finally { m_lease = nullptr; m_disposed = true; }
+
+		throw gcnew InvalidOperationException("The batch must be disposed of on the thread that created it");
+	}
+
+	// A batch that was not committed is rolled back
+	if(CLRISNOTNULL(m_lease)) {
+
+		try { Rollback(); }
+		finally { delete m_lease; m_lease = nullptr; }
+	}
+
+	m_disposed = true;
+}
+
+//---------------------------------------------------------------------------
+// DatabaseBatch::Commit
+//
+// Commits the changes made in the batch and releases the writer connection
+//
+// Arguments:
+//
+//	NONE
+
+void DatabaseBatch::Commit(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if(CLRISNULL(m_lease)) throw gcnew InvalidOperationException("The batch has already been committed");
+	VerifyThread();
+
+	try {
+
+		// The writer connection must never be released with the transaction still open
+		try { Execute(m_nested ? L"release batch" : L"commit transaction"); }
+		catch(Exception^) { Rollback(); throw; }
+	}
+
+	finally { delete m_lease; m_lease = nullptr; }
+}
+
+//---------------------------------------------------------------------------
+// DatabaseBatch::Execute (private)
+//
+// Executes a transaction control statement against the writer connection
+//
+// Arguments:
+//
+//	sql			- Statement to be executed
+
+void DatabaseBatch::Execute(wchar_t const* sql)
+{
+	CLRASSERT(CLRISNOTNULL(m_lease));
+
+	sqlite3_stmt* statement = m_lease->Statements->Acquire(*m_lease, sql);
+
+	try {
+
+		int result = sqlite3_step(statement);
+		if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(*m_lease));
+	}
+
+	finally { m_lease->Statements->Release(statement); }
+}
+
+//---------------------------------------------------------------------------
+// DatabaseBatch::Rollback (private)
+//
+// Rolls back the transaction or savepoint of the batch
+//
+// Arguments:
+//
+//	NONE
+
+void DatabaseBatch::Rollback(void)
+{
+	CLRASSERT(CLRISNOTNULL(m_lease));
+
+	// Some errors roll back the transaction automatically, leaving nothing to undo
+	if(sqlite3_get_autocommit(*m_lease) != 0) return;
+
+	if(m_nested) {
+
+		Execute(L"rollback to batch");
+		Execute(L"release batch");
+	}
+
+	else Execute(L"rollback transaction");
+}
+
+//---------------------------------------------------------------------------
+// DatabaseBatch::VerifyThread (private)
+//
+// Verifies that the batch is being accessed by the thread that created it
+//
+// Arguments:
+//
+//	NONE
+
+void DatabaseBatch::VerifyThread(void)
+{
+	if(Thread::CurrentThread->ManagedThreadId != m_thread)
+		throw gcnew InvalidOperationException("The batch can only be accessed by the thread that created it");
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::ronin::data
+
+#pragma warning(pop)
@@ -0,0 +1,103 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __DATABASEBATCH_H_
+#define __DATABASEBATCH_H_
+#pragma once
+
+#include "ConnectionPool.h"
+
+#pragma warning(push, 4)
+
+using namespace System;
+
+namespace zuki::ronin::data {
+
+//---------------------------------------------------------------------------
+// Class DatabaseBatch
+//
+// Unit of work that holds the writer connection and groups the updates made
+// on the calling thread into a single transaction; each update runs inside
+// its own savepoint. The batch is bound to the thread that created it and
+// is rolled back if it is disposed of without being committed; committing or
+// disposing of it on another thread throws.  A batch that is never disposed
+// of is rolled back by the pool once it has been collected
+//---------------------------------------------------------------------------
+
+public ref class DatabaseBatch
+{
+public:
+
+	// Destructor
+	//
+	~DatabaseBatch();
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Commit
+	//
+	// Commits the changes made in the batch and releases the writer connection
+	void Commit(void);
+
+internal:
+
+	// Instance Constructor
+	//
+	DatabaseBatch(ConnectionPool^ pool);
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// Execute
+	//
+	// Executes a transaction control statement against the writer connection
+	void Execute(wchar_t const* sql);
+
+	// Rollback
+	//
+	// Rolls back the transaction or savepoint of the batch
+	void Rollback(void);
+
+	// VerifyThread
+	//
+	// Verifies that the batch is being accessed by the thread that created it
+	void VerifyThread(void);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	bool						m_disposed = false;		// Object disposal flag
+	ConnectionPool::Lease^		m_lease;				// Writer connection lease
+	bool						m_nested;				// Batch is a savepoint
+	int							m_thread;				// Owning thread identifier
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::ronin::data
+
+#pragma warning(pop)
+
+#endif	// __DATABASEBATCH_H_
@@ -0,0 +1,291 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __DATABASECURSOR_H_
+#define __DATABASECURSOR_H_
+#pragma once
+
+#include "ConnectionPool.h"
+#include "SQLiteException.h"
+
+#pragma warning(push, 4)
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+namespace zuki::ronin::data {
+
+//---------------------------------------------------------------------------
+// Class DatabaseCursor (internal)
+//
+// Pull-based enumerable collection over the results of a database query. Each
+// enumerator leases a connection and owns a prepared statement, rows are read
+// from the statement in batches as the caller advances the enumerator, and the
+// statement and connection are released as soon as the results are exhausted
+// or the enumerator is disposed.  An enumerator that is abandoned before the
+// results are exhausted must be disposed (foreach does this implicitly); there
+// is no finalizer, the statement belongs to the connection's statement cache
+// and may already have been finalized along with it.  An undisposed enumerator
+// keeps its statement and read transaction until the database is closed
+//---------------------------------------------------------------------------
+
+template<typename _type>
+ref class DatabaseCursor abstract : public IEnumerable<_type>
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// GetEnumerator (IEnumerable<T>)
+	//
+	// Returns an enumerator that iterates through the collection
+	virtual IEnumerator<_type>^ GetEnumerator(void) sealed
+	{
+		return gcnew Enumerator(this);
+	}
+
+protected:
+
+	// Instance Constructor
+	//
+	DatabaseCursor(ConnectionPool^ pool, String^ sql, int batchsize) : m_pool(pool), m_sql(sql), m_batchsize(batchsize)
+	{
+		if(CLRISNULL(pool)) throw gcnew ArgumentNullException("pool");
+		if(CLRISNULL(sql)) throw gcnew ArgumentNullException("sql");
+		if(batchsize <= 0) throw gcnew ArgumentOutOfRangeException("batchsize");
+	}
+
+	//-----------------------------------------------------------------------
+	// Protected Member Functions
+
+	// OnBind
+	//
+	// Binds the query parameters to a newly acquired statement
+	virtual void OnBind(sqlite3_stmt* statement)
+	{
+		(void)statement;
+	}
+
+	// OnOpen
+	//
+	// Invoked before the statement is acquired for a new enumerator
+	virtual void OnOpen(void)
+	{
+	}
+
+	// OnRead
+	//
+	// Converts the current result set row into an object instance; version is the change
+	// generation of the snapshot the row was read from, or -1 if it cannot be determined
+	virtual _type OnRead(sqlite3_stmt* statement, int64_t version) abstract;
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// GetEnumeratorNonGeneric (IEnumerable)
+	//
+	// Returns an enumerator that iterates through the collection
+	virtual System::Collections::IEnumerator^ GetEnumeratorNonGeneric(void) sealed = System::Collections::IEnumerable::GetEnumerator
+	{
+		return GetEnumerator();
+	}
+
+	//-----------------------------------------------------------------------
+	// Class Enumerator
+	//
+	// Enumerator implementation that owns the leased connection and statement
+	//-----------------------------------------------------------------------
+
+	ref class Enumerator : public IEnumerator<_type>
+	{
+	public:
+
+		// Instance Constructor
+		//
+		Enumerator(DatabaseCursor^ cursor) : m_cursor(cursor), m_rows(gcnew List<_type>(cursor->m_batchsize))
+		{
+		}
+
+		// Destructor
+		//
+		~Enumerator()
+		{
+			if(m_disposed) return;
+
+			Close();
+			m_disposed = true;
+		}
+
+		//-------------------------------------------------------------------
+		// Member Functions
+
+		// MoveNext (IEnumerator)
+		//
+		// Advances the enumerator to the next element of the collection
+		virtual bool MoveNext(void)
+		{
+			CHECK_DISPOSED(m_disposed);
+
+			// Read the next batch of rows from the statement when the current batch is exhausted
+			if((++m_index >= m_rows->Count) && (!m_done)) Fetch();
+
+			return (m_index < m_rows->Count);
+		}
+
+		// Reset (IEnumerator)
+		//
+		// Sets the enumerator to its initial position
+		virtual void Reset(void)
+		{
+			throw gcnew NotSupportedException();
+		}
+
+		//-------------------------------------------------------------------
+		// Properties
+
+		// Current (IEnumerator<T>)
+		//
+		// Gets the element in the collection at the current position of the enumerator
+		property _type Current
+		{
+			virtual _type get(void)
+			{
+				CHECK_DISPOSED(m_disposed);
+
+				if((m_index < 0) || (m_index >= m_rows->Count)) throw gcnew InvalidOperationException();
+				return m_rows[m_index];
+			}
+		}
+
+	private:
+
+		//-------------------------------------------------------------------
+		// Private Member Functions
+
+		// Close
+		//
+		// Releases the statement and the connection lease
+		void Close(void)
+		{
+			// The statement must be returned to the cache before the connection lease is released
+			if(m_statement != nullptr) { m_instance->Statements->Release(m_statement); m_statement = nullptr; }
+			if(CLRISNOTNULL(m_instance)) { delete m_instance; m_instance = nullptr; }
+		}
+
+		// Fetch
+		//
+		// Reads the next batch of rows from the statement
+		void Fetch(void)
+		{
+			bool first = CLRISNULL(m_instance);
+			int64_t generation = 0;
+
+			// Lease a connection and acquire the statement on the first fetch; the lease is detached
+			// from the calling thread as the enumerator may be advanced from any thread
+			if(first) {
+
+				m_instance = gcnew ConnectionPool::Lease(m_cursor->m_pool, ConnectionPool::LeaseMode::Detached);
+
+				try {
+
+					m_cursor->OnOpen();
+
+					pin_ptr<wchar_t const> sql = PtrToStringChars(m_cursor->m_sql);
+					m_statement = m_instance->Statements->Acquire(*m_instance, sql);
+					m_cursor->OnBind(m_statement);
+				}
+
+				catch(Exception^) { Close(); throw; }
+
+				// The generation has to be read before the first step starts the read transaction
+				generation = m_cursor->m_pool->Generation;
+			}
+
+			m_rows->Clear();
+			m_index = 0;
+
+			// Step the statement until the batch is full or the results are exhausted; the read
+			// transaction started by the first step is held open across every batch
+			int result = SQLITE_ROW;
+			while((m_rows->Count < m_cursor->m_batchsize) && ((result = sqlite3_step(m_statement)) == SQLITE_ROW)) {
+
+				if(first) { m_version = m_instance->Snapshot(generation); first = false; }
+				m_rows->Add(m_cursor->OnRead(m_statement, m_version));
+			}
+
+			// Release the statement and connection as soon as the results have been exhausted
+			if(result != SQLITE_ROW) {
+
+				m_done = true;
+				if(result != SQLITE_DONE) {
+
+					SQLiteException^ exception = gcnew SQLiteException(result, sqlite3_errmsg(*m_instance));
+					Close();
+					throw exception;
+				}
+
+				Close();
+			}
+		}
+
+		// CurrentNonGeneric (IEnumerator)
+		//
+		// Gets the element in the collection at the current position of the enumerator
+		property Object^ CurrentNonGeneric
+		{
+			virtual Object^ get(void) sealed = System::Collections::IEnumerator::Current::get
+			{
+				return Current;
+			}
+		}
+
+		//-------------------------------------------------------------------
+		// Member Variables
+
+		bool						m_disposed = false;		// Object disposal flag
+		DatabaseCursor^				m_cursor;				// Parent cursor
+		ConnectionPool::Lease^		m_instance;				// Leased connection
+		sqlite3_stmt*				m_statement = nullptr;	// Owned statement
+		List<_type>^				m_rows;					// Current batch of rows
+		int							m_index = -1;			// Position in the batch
+		bool						m_done = false;			// Results exhausted flag
+		int64_t						m_version = -1;			// Snapshot change generation
+	};
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	initonly ConnectionPool^	m_pool;					// Connection pool
+	initonly String^			m_sql;					// Query SQL text
+	initonly int				m_batchsize;			// Rows per batch
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::ronin::data
+
+#pragma warning(pop)
+
+#endif	// __DATABASECURSOR_H_
@@ -32,6 +32,30 @@ using namespace System::IO;
 
 namespace zuki::ronin::data {
 
+//---------------------------------------------------------------------------
+// column_file (local)
+//
+// Writes a text result column into a file
+//
+// Arguments:
+//
+//	statement	- SQL statement instance
+//	index		- Index of the result column
+//	path		- Path of the file to be written
+
+static void column_file(sqlite3_stmt* statement, int index, String^ path)
+{
+	// The database and the output files are both UTF-8, write the text
+	// directly without converting it into a System::String first
+	char const* text = reinterpret_cast<char const*>(sqlite3_column_text(statement, index));
+	int length = sqlite3_column_bytes(statement, index);
+
+	array<Byte>^ buffer = gcnew array<Byte>(length);
+	if(length > 0) Marshal::Copy(IntPtr(const_cast<char*>(text)), buffer, 0, length);
+
+	File::WriteAllBytes(path, buffer);
+}
+
 //---------------------------------------------------------------------------
 // export_artwork (local)
 //
@@ -64,12 +88,11 @@ static void export_artwork(SQLiteSafeHandle^ handle, String^ path)
 		while(result == SQLITE_ROW) {
 
 			// artworkid
-			wchar_t const* artworkid = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 0));
+			char const* artworkid = reinterpret_cast<char const*>(sqlite3_column_text(statement, 0));
 			if(artworkid != nullptr) {
 
 				String^ jsonfile = Path::Combine(path, gcnew String(artworkid) + ".json");
-				wchar_t const* json = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 1));
-				File::WriteAllText(jsonfile, gcnew String(json));
+				column_file(statement, 1, jsonfile);
 			}
 
 			result = sqlite3_step(statement);			// Move to the next result set row
@@ -102,7 +125,7 @@ static void export_card(SQLiteSafeHandle^ handle, String^ path)
 
 	// cardid | name | type | passcode | text
 	auto sql = L"select uuidstr(cardid), prettyjson(json_object('cardid', base64encode(cardid), 'name', name, "
-		"'type', type, 'passcode', passcode, 'text', text)) from card";
+		"'type', cardtypestr(type), 'passcode', passcode, 'text', text)) from card";
 
 	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
 	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
@@ -114,12 +137,11 @@ static void export_card(SQLiteSafeHandle^ handle, String^ path)
 		while(result == SQLITE_ROW) {
 
 			// cardid
-			wchar_t const* cardid = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 0));
+			char const* cardid = reinterpret_cast<char const*>(sqlite3_column_text(statement, 0));
 			if(cardid != nullptr) {
 
 				String^ jsonfile = Path::Combine(path, gcnew String(cardid) + ".json");
-				wchar_t const* json = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 1));
-				File::WriteAllText(jsonfile, gcnew String(json));
+				column_file(statement, 1, jsonfile);
 			}
 
 			result = sqlite3_step(statement);			// Move to the next result set row
@@ -164,12 +186,11 @@ static void export_defaultartwork(SQLiteSafeHandle^ handle, String^ path)
 		while(result == SQLITE_ROW) {
 
 			// cardid
-			wchar_t const* cardid = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 0));
+			char const* cardid = reinterpret_cast<char const*>(sqlite3_column_text(statement, 0));
 			if(cardid != nullptr) {
 
 				String^ jsonfile = Path::Combine(path, gcnew String(cardid) + ".json");
-				wchar_t const* json = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 1));
-				File::WriteAllText(jsonfile, gcnew String(json));
+				column_file(statement, 1, jsonfile);
 			}
 
 			result = sqlite3_step(statement);			// Move to the next result set row
@@ -201,8 +222,8 @@ static void export_monster(SQLiteSafeHandle^ handle, String^ path)
 	sqlite3_stmt* statement = nullptr;
 
 	// cardid | attribute | level | type | attack | defense | normal | effect | fusion | ritual | toon | union | spirit | gemini
-	auto sql = L"select uuidstr(cardid), prettyjson(json_object('cardid', base64encode(cardid), 'attribute', attribute, "
-		"'level', level, 'type', type, 'attack', attack, 'defense', defense, 'normal', normal, 'effect', effect, "
+	auto sql = L"select uuidstr(cardid), prettyjson(json_object('cardid', base64encode(cardid), 'attribute', cardattributestr(attribute), "
+		"'level', level, 'type', monstertypestr(type), 'attack', attack, 'defense', defense, 'normal', normal, 'effect', effect, "
 		"'fusion', fusion, 'ritual', ritual, 'toon', toon, 'union', [union], 'spirit', spirit, 'gemini', gemini)) from monster";
 
 	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
@@ -215,12 +236,11 @@ static void export_monster(SQLiteSafeHandle^ handle, String^ path)
 		while(result == SQLITE_ROW) {
 
 			// cardid
-			wchar_t const* cardid = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 0));
+			char const* cardid = reinterpret_cast<char const*>(sqlite3_column_text(statement, 0));
 			if(cardid != nullptr) {
 
 				String^ jsonfile = Path::Combine(path, gcnew String(cardid) + ".json");
-				wchar_t const* json = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 1));
-				File::WriteAllText(jsonfile, gcnew String(json));
+				column_file(statement, 1, jsonfile);
 			}
 
 			result = sqlite3_step(statement);			// Move to the next result set row
@@ -254,7 +274,7 @@ static void export_print(SQLiteSafeHandle^ handle, String^ path)
 	// printid | cardid | seriesid | artworkid | code | language | number | rarity | limitededition | releasedate
 	auto sql = L"select uuidstr(printid), prettyjson(json_object('printid', base64encode(printid), 'cardid', base64encode(cardid), "
 		"'seriesid', base64encode(seriesid), 'artworkid', base64encode(artworkid), 'code', code, 'language', language, "
-		"'number', number, 'rarity', rarity, 'limitededition', limitededition, 'releasedate', releasedate)) from print";
+		"'number', number, 'rarity', printraritystr(rarity), 'limitededition', limitededition, 'releasedate', releasedate)) from print";
 
 	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
 	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
@@ -266,12 +286,11 @@ static void export_print(SQLiteSafeHandle^ handle, String^ path)
 		while(result == SQLITE_ROW) {
 
 			// printid
-			wchar_t const* printid = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 0));
+			char const* printid = reinterpret_cast<char const*>(sqlite3_column_text(statement, 0));
 			if(printid != nullptr) {
 
 				String^ jsonfile = Path::Combine(path, gcnew String(printid) + ".json");
-				wchar_t const* json = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 1));
-				File::WriteAllText(jsonfile, gcnew String(json));
+				column_file(statement, 1, jsonfile);
 			}
 
 			result = sqlite3_step(statement);			// Move to the next result set row
@@ -304,7 +323,7 @@ static void export_restriction(SQLiteSafeHandle^ handle, String^ path)
 
 	// restrictionlistid | cardid | restriction
 	auto sql = L"select uuidstr(restrictionlistid), prettyjson(json_group_array(json_object('restrictionlistid', base64encode(restrictionlistid), "
-		"'cardid', base64encode(cardid), 'restriction', restriction))) from restriction group by restrictionlistid";
+		"'cardid', base64encode(cardid), 'restriction', restrictionstr(restriction)))) from restriction group by restrictionlistid";
 
 	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
 	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
@@ -316,12 +335,11 @@ static void export_restriction(SQLiteSafeHandle^ handle, String^ path)
 		while(result == SQLITE_ROW) {
 
 			// restrictionlistid
-			wchar_t const* restrictionlistid = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 0));
+			char const* restrictionlistid = reinterpret_cast<char const*>(sqlite3_column_text(statement, 0));
 			if(restrictionlistid != nullptr) {
 
 				String^ jsonfile = Path::Combine(path, gcnew String(restrictionlistid) + ".json");
-				wchar_t const* json = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 1));
-				File::WriteAllText(jsonfile, gcnew String(json));
+				column_file(statement, 1, jsonfile);
 			}
 
 			result = sqlite3_step(statement);			// Move to the next result set row
@@ -366,12 +384,11 @@ static void export_restrictionlist(SQLiteSafeHandle^ handle, String^ path)
 		while(result == SQLITE_ROW) {
 
 			// restrictionlistid
-			wchar_t const* restrictionlistid = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 0));
+			char const* restrictionlistid = reinterpret_cast<char const*>(sqlite3_column_text(statement, 0));
 			if(restrictionlistid != nullptr) {
 
 				String^ jsonfile = Path::Combine(path, gcnew String(restrictionlistid) + ".json");
-				wchar_t const* json = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 1));
-				File::WriteAllText(jsonfile, gcnew String(json));
+				column_file(statement, 1, jsonfile);
 			}
 
 			result = sqlite3_step(statement);			// Move to the next result set row
@@ -416,12 +433,11 @@ static void export_ruling(SQLiteSafeHandle^ handle, String^ path)
 		while(result == SQLITE_ROW) {
 
 			// cardid
-			wchar_t const* cardid = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 0));
+			char const* cardid = reinterpret_cast<char const*>(sqlite3_column_text(statement, 0));
 			if(cardid != nullptr) {
 
 				String^ jsonfile = Path::Combine(path, gcnew String(cardid) + ".json");
-				wchar_t const* json = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 1));
-				File::WriteAllText(jsonfile, gcnew String(json));
+				column_file(statement, 1, jsonfile);
 			}
 
 			result = sqlite3_step(statement);			// Move to the next result set row
@@ -466,12 +482,11 @@ static void export_series(SQLiteSafeHandle^ handle, String^ path)
 		while(result == SQLITE_ROW) {
 
 			// seriesid
-			wchar_t const* seriesid = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 0));
+			char const* seriesid = reinterpret_cast<char const*>(sqlite3_column_text(statement, 0));
 			if(seriesid != nullptr) {
 
 				String^ jsonfile = Path::Combine(path, gcnew String(seriesid) + ".json");
-				wchar_t const* json = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 1));
-				File::WriteAllText(jsonfile, gcnew String(json));
+				column_file(statement, 1, jsonfile);
 			}
 
 			result = sqlite3_step(statement);			// Move to the next result set row
@@ -516,12 +531,11 @@ static void export_spell(SQLiteSafeHandle^ handle, String^ path)
 		while(result == SQLITE_ROW) {
 
 			// cardid
-			wchar_t const* cardid = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 0));
+			char const* cardid = reinterpret_cast<char const*>(sqlite3_column_text(statement, 0));
 			if(cardid != nullptr) {
 
 				String^ jsonfile = Path::Combine(path, gcnew String(cardid) + ".json");
-				wchar_t const* json = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 1));
-				File::WriteAllText(jsonfile, gcnew String(json));
+				column_file(statement, 1, jsonfile);
 			}
 
 			result = sqlite3_step(statement);			// Move to the next result set row
@@ -566,12 +580,11 @@ static void export_trap(SQLiteSafeHandle^ handle, String^ path)
 		while(result == SQLITE_ROW) {
 
 			// cardid
-			wchar_t const* cardid = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 0));
+			char const* cardid = reinterpret_cast<char const*>(sqlite3_column_text(statement, 0));
 			if(cardid != nullptr) {
 
 				String^ jsonfile = Path::Combine(path, gcnew String(cardid) + ".json");
-				wchar_t const* json = reinterpret_cast<wchar_t const*>(sqlite3_column_text16(statement, 1));
-				File::WriteAllText(jsonfile, gcnew String(json));
+				column_file(statement, 1, jsonfile);
 			}
 
 			result = sqlite3_step(statement);			// Move to the next result set row
@@ -627,71 +640,75 @@ void Database::Export(String^ path)
 	path = Path::GetFullPath(path);
 	if(!try_create_directory(path)) throw gcnew Exception("Unable to create specified export directory");
 
+	// Lease a read-only connection from the pool for the export operation
+	ConnectionPool::Lease instance(m_pool, ConnectionPool::LeaseMode::Read);
+	SQLiteSafeHandle^ handle = instance.Handle;
+
 	// CARD
 	//
 	String^ cardpath = Path::Combine(path, "card");
 	if(!try_create_directory(cardpath)) throw gcnew Exception("Unable to create card export directory");
-	export_card(m_handle, cardpath);
+	export_card(handle, cardpath);
 
 	// MONSTER
 	//
 	String^ monsterpath = Path::Combine(path, "monster");
 	if(!try_create_directory(monsterpath)) throw gcnew Exception("Unable to create monster export directory");
-	export_monster(m_handle, monsterpath);
+	export_monster(handle, monsterpath);
 
 	// SPELL
 	//
 	String^ spellpath = Path::Combine(path, "spell");
 	if(!try_create_directory(spellpath)) throw gcnew Exception("Unable to create spell export directory");
-	export_spell(m_handle, spellpath);
+	export_spell(handle, spellpath);
 
 	// TRAP
 	//
 	String^ trappath = Path::Combine(path, "trap");
 	if(!try_create_directory(trappath)) throw gcnew Exception("Unable to create trap export directory");
-	export_trap(m_handle, trappath);
+	export_trap(handle, trappath);
 
 	// ARTWORK
 	//
 	String^ artworkpath = Path::Combine(path, "artwork");
 	if(!try_create_directory(artworkpath)) throw gcnew Exception("Unable to create artwork export directory");
-	export_artwork(m_handle, artworkpath);
+	export_artwork(handle, artworkpath);
 
 	// DEFAULTARTWORK
 	//
 	String^ defaultartworkpath = Path::Combine(path, "defaultartwork");
 	if(!try_create_directory(defaultartworkpath)) throw gcnew Exception("Unable to create defaultartwork export directory");
-	export_defaultartwork(m_handle, defaultartworkpath);
+	export_defaultartwork(handle, defaultartworkpath);
 
 	// SERIES
 	//
 	String^ seriespath = Path::Combine(path, "series");
 	if(!try_create_directory(seriespath)) throw gcnew Exception("Unable to create series export directory");
-	export_series(m_handle, seriespath);
+	export_series(handle, seriespath);
 
 	// PRINT
 	//
 	String^ printpath = Path::Combine(path, "print");
 	if(!try_create_directory(printpath)) throw gcnew Exception("Unable to create print export directory");
-	export_print(m_handle, printpath);
+	export_print(handle, printpath);
 
 	// RESTRICTIONLIST
 	//
 	String^ restrictionlistpath = Path::Combine(path, "restrictionlist");
 	if(!try_create_directory(restrictionlistpath)) throw gcnew Exception("Unable to create restrictionlist export directory");
-	export_restrictionlist(m_handle, restrictionlistpath);
+	export_restrictionlist(handle, restrictionlistpath);
 
 	// RESTRICTION
 	//
 	String^ restrictionpath = Path::Combine(path, "restriction");
 	if(!try_create_directory(restrictionpath)) throw gcnew Exception("Unable to create restriction export directory");
-	export_restriction(m_handle, restrictionpath);
+	export_restriction(handle, restrictionpath);
 
 	// RULING
 	//
 	String^ rulingpath = Path::Combine(path, "ruling");
 	if(!try_create_directory(rulingpath)) throw gcnew Exception("Unable to create ruling export directory");
-	export_ruling(m_handle, rulingpath);
+	export_ruling(handle, rulingpath);
 }
 
 //---------------------------------------------------------------------------
@@ -0,0 +1,162 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __IDENTITYMAP_H_
+#define __IDENTITYMAP_H_
+#pragma once
+
+#pragma warning(push, 4)
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+namespace zuki::ronin::data {
+
+//---------------------------------------------------------------------------
+// Class IdentityMap (internal)
+//
+// Maps unique identifiers to weakly held object instances so that repeated
+// lookups of the same identifier return the same object.  The map is tied to
+// a database data version and is emptied whenever that version changes
+//---------------------------------------------------------------------------
+
+template<typename _key, typename _value>
+ref class IdentityMap
+{
+public:
+
+	// Instance Constructor
+	//
+	IdentityMap() : m_lock(gcnew Object()), m_map(gcnew Dictionary<_key, WeakReference<_value>^>())
+	{
+	}
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Add
+	//
+	// Adds an object to the map, returns the existing object if one is still alive
+	_value Add(_key key, _value value)
+	{
+		WeakReference<_value>^ reference = nullptr;
+		_value existing = nullptr;
+
+		msclr::lock lock(m_lock);
+
+		// If there is a live object for this key already, that one wins
+		if(m_map->TryGetValue(key, reference) && reference->TryGetTarget(existing)) return existing;
+
+		// Periodically remove entries whose objects have been collected
+		if(m_map->Count >= m_prunecount) Prune();
+
+		m_map[key] = gcnew WeakReference<_value>(value);
+		return value;
+	}
+
+	// Clear
+	//
+	// Removes all objects from the map
+	void Clear(void)
+	{
+		msclr::lock lock(m_lock);
+		m_map->Clear();
+	}
+
+	// Find
+	//
+	// Locates an object in the map; returns nullptr if not present
+	_value Find(_key key)
+	{
+		WeakReference<_value>^ reference = nullptr;
+		_value value = nullptr;
+
+		msclr::lock lock(m_lock);
+
+		if(m_map->TryGetValue(key, reference) && reference->TryGetTarget(value)) return value;
+		return nullptr;
+	}
+
+	// Validate
+	//
+	// Empties the map if the data version has advanced since it was populated; returns
+	// true if the map is at the specified version, false if the version is out of date
+	bool Validate(int64_t version)
+	{
+		msclr::lock lock(m_lock);
+
+		// Versions only increase; a thread that observed an older version must not
+		// empty the map populated by a thread that has already observed a newer one
+		if(version <= m_version) return (version == m_version);
+
+		m_map->Clear();
+		m_version = version;
+
+		return true;
+	}
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// Prune
+	//
+	// Removes entries whose objects have been collected
+	void Prune(void)
+	{
+		List<_key>^ dead = gcnew List<_key>();
+		_value value = nullptr;
+
+		for each(KeyValuePair<_key, WeakReference<_value>^> entry in m_map)
+			if(!entry.Value->TryGetTarget(value)) dead->Add(entry.Key);
+
+		for each(_key key in dead) m_map->Remove(key);
+
+		// Wait until the map doubles in size from the surviving entries before pruning again
+		m_prunecount = Math::Max(MIN_PRUNE_COUNT, m_map->Count * 2);
+	}
+
+	//-----------------------------------------------------------------------
+	// Private Constants
+
+	// MIN_PRUNE_COUNT
+	//
+	// Minimum number of entries in the map before it will be pruned
+	literal int MIN_PRUNE_COUNT = 256;
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	Object^										m_lock;				// Synchronization object
+	Dictionary<_key, WeakReference<_value>^>^	m_map;				// Identifier to object map
+	int64_t										m_version = -1;		// Data version
+	int											m_prunecount = MIN_PRUNE_COUNT;	// Prune threshold
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::ronin::data
+
+#pragma warning(pop)
+
+#endif	// __IDENTITYMAP_H_
@@ -24,6 +24,8 @@
 
 #include "Database.h"
 
+#include "jsonimport.h"
+
 #include "SQLiteException.h"
 
 using namespace System::IO;
@@ -75,28 +77,39 @@ static int execute_non_query(SQLiteSafeHandle^ handle, wchar_t const* sql)
 }
 
 //---------------------------------------------------------------------------
-// import_artwork (local)
+// import_table (local)
 //
-// Imports the artwork table 
+// Imports the JSON files in a directory into a table. The files are read and
+// parsed by jsonimport worker threads; this thread only binds and inserts rows
 //
 // Arguments:
 //
 //	handle		- Database instance handle
 //	path		- Path to the import files
+//	sql			- Parameterized insert statement; one parameter per column
+//	columns		- Columns to be extracted from each JSON object
+//	isarray		- Flag indicating that each file contains an array of objects
+//	depth		- Maximum number of files parsed ahead of the insert statement
 
-static void import_artwork(SQLiteSafeHandle^ handle, String^ path)
+static void import_table(SQLiteSafeHandle^ handle, String^ path, wchar_t const* sql, std::vector<jsonimport::column_t> const& columns,
+	bool isarray, int depth)
 {
 	CLRASSERT(CLRISNOTNULL(handle));
 	CLRASSERT(CLRISNOTNULL(path));
+	CLRASSERT(sql != nullptr);
 
 	SQLiteSafeHandle::Reference instance(handle);
 	sqlite3_stmt* statement = nullptr;
 
-	// artworkid | cardid | format | height | width | image
-	auto sql = L"with input(json) as (select ?1) "
-		"insert into artwork select base64decode(json_extract(input.json, '$.artworkid')), base64decode(json_extract(input.json, '$.cardid')), "
-		"json_extract(input.json, '$.format'), json_extract(input.json, '$.height'), json_extract(input.json, '$.width'), "
-		"base64decode(json_extract(input.json, '$.image')) from input";
+	// Convert the import file paths into a standard library vector for the workers
+	array<String^>^ importfiles = Directory::GetFiles(path);
+	std::vector<std::wstring> files;
+	files.reserve(importfiles->Length);
+	for each(String^ importfile in importfiles) {
+
+		pin_ptr<wchar_t const> pinimportfile = PtrToStringChars(importfile);
+		files.emplace_back(pinimportfile, importfile->Length);
+	}
 
 	// Prepare the query
 	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
@@ -104,81 +117,113 @@ static void import_artwork(SQLiteSafeHandle^ handle, String^ path)
 
 	try {
 
-		for each(String^ importfile in Directory::GetFiles(path)) {
+		jsonimport reader(files, columns, isarray, static_cast<size_t>(Environment::ProcessorCount), static_cast<size_t>(depth));
+		std::vector<jsonimport::row_t> rows;
 
-			// Read the JSON from the input file and pin it
-			String^ json = File::ReadAllText(importfile);
-			pin_ptr<wchar_t const> pinjson = PtrToStringChars(json);
+		while(reader.next(rows)) {
 
-			// Bind the query parameter(s)
-			result = sqlite3_bind_text16(statement, 1, pinjson, -1, SQLITE_STATIC);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result);
+			for(auto const& row : rows) {
 
-			// Execute the query; no rows are expected to be returned
-			result = sqlite3_step(statement);
-			if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+				// Bind the query parameter(s); the field data outlives the statement execution
+				for(size_t index = 0; index < row.size(); index++) {
 
-			// Reset the prepared statement so that it can be executed again
-			result = sqlite3_clear_bindings(statement);
-			if(result == SQLITE_OK) result = sqlite3_reset(statement);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+					jsonimport::field_t const& field = row[index];
+					int param = static_cast<int>(index + 1);
+
+					switch(field.type) {
+
+						case jsonimport::fieldtype_t::integer: result = sqlite3_bind_int64(statement, param, field.integer); break;
+						case jsonimport::fieldtype_t::real: result = sqlite3_bind_double(statement, param, field.real); break;
+						case jsonimport::fieldtype_t::text: result = sqlite3_bind_text(statement, param, field.data.data(), static_cast<int>(field.data.size()), SQLITE_STATIC); break;
+						case jsonimport::fieldtype_t::blob: result = (field.data.empty()) ? sqlite3_bind_zeroblob(statement, param, 0) :
+							sqlite3_bind_blob(statement, param, field.data.data(), static_cast<int>(field.data.size()), SQLITE_STATIC); break;
+						default: result = sqlite3_bind_null(statement, param); break;
+					}
+
+					if(result != SQLITE_OK) throw gcnew SQLiteException(result);
+				}
+
+				// Execute the query; no rows are expected to be returned
+				result = sqlite3_step(statement);
+				if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+
+				// Reset the prepared statement so that it can be executed again
+				result = sqlite3_clear_bindings(statement);
+				if(result == SQLITE_OK) result = sqlite3_reset(statement);
+				if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+			}
 		}
 	}
 
+	catch(jsonimport::exception const& ex) {
+
+		throw gcnew Exception(String::Format("Import file {0} {1}", importfiles[static_cast<int>(ex.file)], gcnew String(ex.what())));
+	}
+
 	finally { sqlite3_finalize(statement); }
 }
 
 //---------------------------------------------------------------------------
-// import_card (local)
+// import_artwork (local)
 //
-// Imports the card table 
+// Imports the artwork table 
 //
 // Arguments:
 //
 //	handle		- Database instance handle
 //	path		- Path to the import files
+//	depth		- Maximum number of files parsed ahead of the insert statement
 
-static void import_card(SQLiteSafeHandle^ handle, String^ path)
+static void import_artwork(SQLiteSafeHandle^ handle, String^ path, int depth)
 {
 	CLRASSERT(CLRISNOTNULL(handle));
 	CLRASSERT(CLRISNOTNULL(path));
 
-	SQLiteSafeHandle::Reference instance(handle);
-	sqlite3_stmt* statement = nullptr;
+	// artworkid | cardid | format | height | width | image
+	auto sql = L"insert into artwork values(?1, ?2, ?3, ?4, ?5, ?6)";
 
-	// cardid | name | type | passcode | text
-	auto sql = L"with input(json) as (select ?1) "
-		"insert into card select base64decode(json_extract(input.json, '$.cardid')), json_extract(input.json, '$.name'), "
-		"json_extract(input.json, '$.type'), json_extract(input.json, '$.passcode'), json_extract(input.json, '$.text') from input";
+	std::vector<jsonimport::column_t> columns = {
 
-	// Prepare the query
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+		{ "artworkid", jsonimport::coltype_t::base64 },
+		{ "cardid", jsonimport::coltype_t::base64 },
+		{ "format", jsonimport::coltype_t::value },
+		{ "height", jsonimport::coltype_t::value },
+		{ "width", jsonimport::coltype_t::value },
+		{ "image", jsonimport::coltype_t::base64 }
+	};
 
-	try {
+	import_table(handle, path, sql, columns, false, depth);
+}
 
-		for each(String^ importfile in Directory::GetFiles(path)) {
+//---------------------------------------------------------------------------
+// import_card (local)
+//
+// Imports the card table 
+//
+// Arguments:
+//
+//	handle		- Database instance handle
+//	path		- Path to the import files
+//	depth		- Maximum number of files parsed ahead of the insert statement
 
-			// Read the JSON from the input file and pin it
-			String^ json = File::ReadAllText(importfile);
-			pin_ptr<wchar_t const> pinjson = PtrToStringChars(json);
+static void import_card(SQLiteSafeHandle^ handle, String^ path, int depth)
+{
+	CLRASSERT(CLRISNOTNULL(handle));
+	CLRASSERT(CLRISNOTNULL(path));
 
-			// Bind the query parameter(s)
-			result = sqlite3_bind_text16(statement, 1, pinjson, -1, SQLITE_STATIC);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result);
+	// cardid | name | type | passcode | text
+	auto sql = L"insert into card values(?1, ?2, cardtype(?3), ?4, ?5)";
 
-			// Execute the query; no rows are expected to be returned
-			result = sqlite3_step(statement);
-			if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	std::vector<jsonimport::column_t> columns = {
 
-			// Reset the prepared statement so that it can be executed again
-			result = sqlite3_clear_bindings(statement);
-			if(result == SQLITE_OK) result = sqlite3_reset(statement);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-		}
-	}
+		{ "cardid", jsonimport::coltype_t::base64 },
+		{ "name", jsonimport::coltype_t::value },
+		{ "type", jsonimport::coltype_t::value },
+		{ "passcode", jsonimport::coltype_t::value },
+		{ "text", jsonimport::coltype_t::value }
+	};
 
-	finally { sqlite3_finalize(statement); }
+	import_table(handle, path, sql, columns, false, depth);
 }
 
 //---------------------------------------------------------------------------
@@ -190,48 +235,23 @@ static void import_card(SQLiteSafeHandle^ handle, String^ path)
 //
 //	handle		- Database instance handle
 //	path		- Path to the import files
+//	depth		- Maximum number of files parsed ahead of the insert statement
 
-static void import_defaultartwork(SQLiteSafeHandle^ handle, String^ path)
+static void import_defaultartwork(SQLiteSafeHandle^ handle, String^ path, int depth)
 {
 	CLRASSERT(CLRISNOTNULL(handle));
 	CLRASSERT(CLRISNOTNULL(path));
 
-	SQLiteSafeHandle::Reference instance(handle);
-	sqlite3_stmt* statement = nullptr;
-
 	// cardid | artworkid
-	auto sql = L"with input(json) as (select ?1) "
-		"insert into defaultartwork select base64decode(json_extract(input.json, '$.cardid')), base64decode(json_extract(input.json, '$.artworkid')) "
-		"from input";
+	auto sql = L"insert into defaultartwork values(?1, ?2)";
 
-	// Prepare the query
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-
-	try {
-
-		for each(String ^ importfile in Directory::GetFiles(path)) {
-
-			// Read the JSON from the input file and pin it
-			String^ json = File::ReadAllText(importfile);
-			pin_ptr<wchar_t const> pinjson = PtrToStringChars(json);
+	std::vector<jsonimport::column_t> columns = {
 
-			// Bind the query parameter(s)
-			result = sqlite3_bind_text16(statement, 1, pinjson, -1, SQLITE_STATIC);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result);
+		{ "cardid", jsonimport::coltype_t::base64 },
+		{ "artworkid", jsonimport::coltype_t::base64 }
+	};
 
-			// Execute the query; no rows are expected to be returned
-			result = sqlite3_step(statement);
-			if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-
-			// Reset the prepared statement so that it can be executed again
-			result = sqlite3_clear_bindings(statement);
-			if(result == SQLITE_OK) result = sqlite3_reset(statement);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-		}
-	}
-
-	finally { sqlite3_finalize(statement); }
+	import_table(handle, path, sql, columns, false, depth);
 }
 
 //---------------------------------------------------------------------------
@@ -243,52 +263,35 @@ static void import_defaultartwork(SQLiteSafeHandle^ handle, String^ path)
 //
 //	handle		- Database instance handle
 //	path		- Path to the import files
+//	depth		- Maximum number of files parsed ahead of the insert statement
 
-static void import_monster(SQLiteSafeHandle^ handle, String^ path)
+static void import_monster(SQLiteSafeHandle^ handle, String^ path, int depth)
 {
 	CLRASSERT(CLRISNOTNULL(handle));
 	CLRASSERT(CLRISNOTNULL(path));
 
-	SQLiteSafeHandle::Reference instance(handle);
-	sqlite3_stmt* statement = nullptr;
-
 	// cardid | attribute | level | type | attack | defense | normal | effect | fusion | ritual | toon | union | spirit | gemini
-	auto sql = L"with input(json) as (select ?1) "
-		"insert into monster select base64decode(json_extract(input.json, '$.cardid')), json_extract(input.json, '$.attribute'), "
-		"json_extract(input.json, '$.level'),   json_extract(input.json, '$.type'),   json_extract(input.json, '$.attack'), "
-		"json_extract(input.json, '$.defense'), json_extract(input.json, '$.normal'), json_extract(input.json, '$.effect'), "
-		"json_extract(input.json, '$.fusion'),  json_extract(input.json, '$.ritual'), json_extract(input.json, '$.toon'), "
-		"json_extract(input.json, '$.union'),   json_extract(input.json, '$.spirit'), json_extract(input.json, '$.gemini') "
-		"from input";
-
-	// Prepare the query
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-
-	try {
-
-		for each(String ^ importfile in Directory::GetFiles(path)) {
-
-			// Read the JSON from the input file and pin it
-			String^ json = File::ReadAllText(importfile);
-			pin_ptr<wchar_t const> pinjson = PtrToStringChars(json);
-
-			// Bind the query parameter(s)
-			result = sqlite3_bind_text16(statement, 1, pinjson, -1, SQLITE_STATIC);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result);
-
-			// Execute the query; no rows are expected to be returned
-			result = sqlite3_step(statement);
-			if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-
-			// Reset the prepared statement so that it can be executed again
-			result = sqlite3_clear_bindings(statement);
-			if(result == SQLITE_OK) result = sqlite3_reset(statement);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-		}
-	}
-
-	finally { sqlite3_finalize(statement); }
+	auto sql = L"insert into monster values(?1, cardattribute(?2), ?3, monstertype(?4), ?5, ?6, ?7, ?8, ?9, ?10, ?11, ?12, ?13, ?14)";
+
+	std::vector<jsonimport::column_t> columns = {
+
+		{ "cardid", jsonimport::coltype_t::base64 },
+		{ "attribute", jsonimport::coltype_t::value },
+		{ "level", jsonimport::coltype_t::value },
+		{ "type", jsonimport::coltype_t::value },
+		{ "attack", jsonimport::coltype_t::value },
+		{ "defense", jsonimport::coltype_t::value },
+		{ "normal", jsonimport::coltype_t::value },
+		{ "effect", jsonimport::coltype_t::value },
+		{ "fusion", jsonimport::coltype_t::value },
+		{ "ritual", jsonimport::coltype_t::value },
+		{ "toon", jsonimport::coltype_t::value },
+		{ "union", jsonimport::coltype_t::value },
+		{ "spirit", jsonimport::coltype_t::value },
+		{ "gemini", jsonimport::coltype_t::value }
+	};
+
+	import_table(handle, path, sql, columns, false, depth);
 }
 
 //---------------------------------------------------------------------------
@@ -300,50 +303,31 @@ static void import_monster(SQLiteSafeHandle^ handle, String^ path)
 //
 //	handle		- Database instance handle
 //	path		- Path to the import files
+//	depth		- Maximum number of files parsed ahead of the insert statement
 
-static void import_print(SQLiteSafeHandle^ handle, String^ path)
+static void import_print(SQLiteSafeHandle^ handle, String^ path, int depth)
 {
 	CLRASSERT(CLRISNOTNULL(handle));
 	CLRASSERT(CLRISNOTNULL(path));
 
-	SQLiteSafeHandle::Reference instance(handle);
-	sqlite3_stmt* statement = nullptr;
-
 	// printid | cardid | seriesid | artworkid | code | language | number | rarity | limitededition | releasedate
-	auto sql = L"with input(json) as (select ?1) "
-		"insert into print select base64decode(json_extract(input.json, '$.printid')), base64decode(json_extract(input.json, '$.cardid')), "
-		"base64decode(json_extract(input.json, '$.seriesid')), base64decode(json_extract(input.json, '$.artworkid')), json_extract(input.json, '$.code'), "
-		"json_extract(input.json, '$.language'), json_extract(input.json, '$.number'), json_extract(input.json, '$.rarity'), "
-		"json_extract(input.json, '$.limitededition'), json_extract(input.json, '$.releasedate') from input";
-
-	// Prepare the query
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-
-	try {
-
-		for each(String ^ importfile in Directory::GetFiles(path)) {
-
-			// Read the JSON from the input file and pin it
-			String^ json = File::ReadAllText(importfile);
-			pin_ptr<wchar_t const> pinjson = PtrToStringChars(json);
-
-			// Bind the query parameter(s)
-			result = sqlite3_bind_text16(statement, 1, pinjson, -1, SQLITE_STATIC);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result);
-
-			// Execute the query; no rows are expected to be returned
-			result = sqlite3_step(statement);
-			if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-
-			// Reset the prepared statement so that it can be executed again
-			result = sqlite3_clear_bindings(statement);
-			if(result == SQLITE_OK) result = sqlite3_reset(statement);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-		}
-	}
-
-	finally { sqlite3_finalize(statement); }
+	auto sql = L"insert into print values(?1, ?2, ?3, ?4, ?5, ?6, ?7, printrarity(?8), ?9, ?10)";
+
+	std::vector<jsonimport::column_t> columns = {
+
+		{ "printid", jsonimport::coltype_t::base64 },
+		{ "cardid", jsonimport::coltype_t::base64 },
+		{ "seriesid", jsonimport::coltype_t::base64 },
+		{ "artworkid", jsonimport::coltype_t::base64 },
+		{ "code", jsonimport::coltype_t::value },
+		{ "language", jsonimport::coltype_t::value },
+		{ "number", jsonimport::coltype_t::value },
+		{ "rarity", jsonimport::coltype_t::value },
+		{ "limitededition", jsonimport::coltype_t::value },
+		{ "releasedate", jsonimport::coltype_t::value }
+	};
+
+	import_table(handle, path, sql, columns, false, depth);
 }
 
 //---------------------------------------------------------------------------
@@ -355,48 +339,24 @@ static void import_print(SQLiteSafeHandle^ handle, String^ path)
 //
 //	handle		- Database instance handle
 //	path		- Path to the import files
+//	depth		- Maximum number of files parsed ahead of the insert statement
 
-static void import_restriction(SQLiteSafeHandle^ handle, String^ path)
+static void import_restriction(SQLiteSafeHandle^ handle, String^ path, int depth)
 {
 	CLRASSERT(CLRISNOTNULL(handle));
 	CLRASSERT(CLRISNOTNULL(path));
 
-	SQLiteSafeHandle::Reference instance(handle);
-	sqlite3_stmt* statement = nullptr;
-
 	// restrictionlistid | cardid | restriction
-	auto sql = L"with input(json) as (select ?1) "
-		"insert into restriction select base64decode(json_extract(json.value, '$.restrictionlistid')), base64decode(json_extract(json.value, '$.cardid')), "
-		"json_extract(json.value, '$.restriction') from input, json_each(input.json) as json";
-
-	// Prepare the query
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-
-	try {
-
-		for each(String ^ importfile in Directory::GetFiles(path)) {
-
-			// Read the JSON from the input file and pin it
-			String^ json = File::ReadAllText(importfile);
-			pin_ptr<wchar_t const> pinjson = PtrToStringChars(json);
+	auto sql = L"insert into restriction values(?1, ?2, restriction(?3))";
 
-			// Bind the query parameter(s)
-			result = sqlite3_bind_text16(statement, 1, pinjson, -1, SQLITE_STATIC);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result);
+	std::vector<jsonimport::column_t> columns = {
 
-			// Execute the query; no rows are expected to be returned
-			result = sqlite3_step(statement);
-			if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+		{ "restrictionlistid", jsonimport::coltype_t::base64 },
+		{ "cardid", jsonimport::coltype_t::base64 },
+		{ "restriction", jsonimport::coltype_t::value }
+	};
 
-			// Reset the prepared statement so that it can be executed again
-			result = sqlite3_clear_bindings(statement);
-			if(result == SQLITE_OK) result = sqlite3_reset(statement);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-		}
-	}
-
-	finally { sqlite3_finalize(statement); }
+	import_table(handle, path, sql, columns, true, depth);
 }
 
 //---------------------------------------------------------------------------
@@ -408,48 +368,23 @@ static void import_restriction(SQLiteSafeHandle^ handle, String^ path)
 //
 //	handle		- Database instance handle
 //	path		- Path to the import files
+//	depth		- Maximum number of files parsed ahead of the insert statement
 
-static void import_restrictionlist(SQLiteSafeHandle^ handle, String^ path)
+static void import_restrictionlist(SQLiteSafeHandle^ handle, String^ path, int depth)
 {
 	CLRASSERT(CLRISNOTNULL(handle));
 	CLRASSERT(CLRISNOTNULL(path));
 
-	SQLiteSafeHandle::Reference instance(handle);
-	sqlite3_stmt* statement = nullptr;
-
 	// restrictionlistid | effective
-	auto sql = L"with input(json) as (select ?1) "
-		"insert into restrictionlist select base64decode(json_extract(input.json, '$.restrictionlistid')), "
-		"json_extract(input.json, '$.effective') from input";
-
-	// Prepare the query
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	auto sql = L"insert into restrictionlist values(?1, ?2)";
 
-	try {
+	std::vector<jsonimport::column_t> columns = {
 
-		for each(String ^ importfile in Directory::GetFiles(path)) {
+		{ "restrictionlistid", jsonimport::coltype_t::base64 },
+		{ "effective", jsonimport::coltype_t::value }
+	};
 
-			// Read the JSON from the input file and pin it
-			String^ json = File::ReadAllText(importfile);
-			pin_ptr<wchar_t const> pinjson = PtrToStringChars(json);
-
-			// Bind the query parameter(s)
-			result = sqlite3_bind_text16(statement, 1, pinjson, -1, SQLITE_STATIC);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result);
-
-			// Execute the query; no rows are expected to be returned
-			result = sqlite3_step(statement);
-			if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-
-			// Reset the prepared statement so that it can be executed again
-			result = sqlite3_clear_bindings(statement);
-			if(result == SQLITE_OK) result = sqlite3_reset(statement);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-		}
-	}
-
-	finally { sqlite3_finalize(statement); }
+	import_table(handle, path, sql, columns, false, depth);
 }
 
 //---------------------------------------------------------------------------
@@ -461,48 +396,24 @@ static void import_restrictionlist(SQLiteSafeHandle^ handle, String^ path)
 //
 //	handle		- Database instance handle
 //	path		- Path to the import files
+//	depth		- Maximum number of files parsed ahead of the insert statement
 
-static void import_ruling(SQLiteSafeHandle^ handle, String^ path)
+static void import_ruling(SQLiteSafeHandle^ handle, String^ path, int depth)
 {
 	CLRASSERT(CLRISNOTNULL(handle));
 	CLRASSERT(CLRISNOTNULL(path));
 
-	SQLiteSafeHandle::Reference instance(handle);
-	sqlite3_stmt* statement = nullptr;
-
 	// cardid | sequence | ruling
-	auto sql = L"with input(json) as (select ?1) "
-		"insert into ruling select base64decode(json_extract(json.value, '$.cardid')), json_extract(json.value, '$.sequence'), "
-		"json_extract(json.value, '$.ruling') from input, json_each(input.json) as json";
+	auto sql = L"insert into ruling values(?1, ?2, ?3)";
 
-	// Prepare the query
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-
-	try {
-
-		for each(String ^ importfile in Directory::GetFiles(path)) {
-
-			// Read the JSON from the input file and pin it
-			String^ json = File::ReadAllText(importfile);
-			pin_ptr<wchar_t const> pinjson = PtrToStringChars(json);
-
-			// Bind the query parameter(s)
-			result = sqlite3_bind_text16(statement, 1, pinjson, -1, SQLITE_STATIC);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result);
+	std::vector<jsonimport::column_t> columns = {
 
-			// Execute the query; no rows are expected to be returned
-			result = sqlite3_step(statement);
-			if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+		{ "cardid", jsonimport::coltype_t::base64 },
+		{ "sequence", jsonimport::coltype_t::value },
+		{ "ruling", jsonimport::coltype_t::value }
+	};
 
-			// Reset the prepared statement so that it can be executed again
-			result = sqlite3_clear_bindings(statement);
-			if(result == SQLITE_OK) result = sqlite3_reset(statement);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-		}
-	}
-
-	finally { sqlite3_finalize(statement); }
+	import_table(handle, path, sql, columns, true, depth);
 }
 
 //---------------------------------------------------------------------------
@@ -514,48 +425,26 @@ static void import_ruling(SQLiteSafeHandle^ handle, String^ path)
 //
 //	handle		- Database instance handle
 //	path		- Path to the import files
+//	depth		- Maximum number of files parsed ahead of the insert statement
 
-static void import_series(SQLiteSafeHandle^ handle, String^ path)
+static void import_series(SQLiteSafeHandle^ handle, String^ path, int depth)
 {
 	CLRASSERT(CLRISNOTNULL(handle));
 	CLRASSERT(CLRISNOTNULL(path));
 
-	SQLiteSafeHandle::Reference instance(handle);
-	sqlite3_stmt* statement = nullptr;
-
 	// seriesid | code | name | boosterpack | releasedate
-	auto sql = L"with input(json) as (select ?1) "
-		"insert into series select base64decode(json_extract(input.json, '$.seriesid')), json_extract(input.json, '$.code'), "
-		"json_extract(input.json, '$.name'), json_extract(input.json, '$.boosterpack'), json_extract(input.json, '$.releasedate') from input";
-
-	// Prepare the query
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	auto sql = L"insert into series values(?1, ?2, ?3, ?4, ?5)";
 
-	try {
-
-		for each(String ^ importfile in Directory::GetFiles(path)) {
-
-			// Read the JSON from the input file and pin it
-			String^ json = File::ReadAllText(importfile);
-			pin_ptr<wchar_t const> pinjson = PtrToStringChars(json);
+	std::vector<jsonimport::column_t> columns = {
 
-			// Bind the query parameter(s)
-			result = sqlite3_bind_text16(statement, 1, pinjson, -1, SQLITE_STATIC);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result);
+		{ "seriesid", jsonimport::coltype_t::base64 },
+		{ "code", jsonimport::coltype_t::value },
+		{ "name", jsonimport::coltype_t::value },
+		{ "boosterpack", jsonimport::coltype_t::value },
+		{ "releasedate", jsonimport::coltype_t::value }
+	};
 
-			// Execute the query; no rows are expected to be returned
-			result = sqlite3_step(statement);
-			if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-
-			// Reset the prepared statement so that it can be executed again
-			result = sqlite3_clear_bindings(statement);
-			if(result == SQLITE_OK) result = sqlite3_reset(statement);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-		}
-	}
-
-	finally { sqlite3_finalize(statement); }
+	import_table(handle, path, sql, columns, false, depth);
 }
 
 //---------------------------------------------------------------------------
@@ -567,49 +456,28 @@ static void import_series(SQLiteSafeHandle^ handle, String^ path)
 //
 //	handle		- Database instance handle
 //	path		- Path to the import files
+//	depth		- Maximum number of files parsed ahead of the insert statement
 
-static void import_spell(SQLiteSafeHandle^ handle, String^ path)
+static void import_spell(SQLiteSafeHandle^ handle, String^ path, int depth)
 {
 	CLRASSERT(CLRISNOTNULL(handle));
 	CLRASSERT(CLRISNOTNULL(path));
 
-	SQLiteSafeHandle::Reference instance(handle);
-	sqlite3_stmt* statement = nullptr;
-
 	// cardid | normal | continuous | equip | field | quickplay | ritual
-	auto sql = L"with input(json) as (select ?1) "
-		"insert into spell select base64decode(json_extract(input.json, '$.cardid')), json_extract(input.json, '$.normal'), "
-		"json_extract(input.json, '$.continuous'), json_extract(input.json, '$.equip'), json_extract(input.json, '$.field'), "
-		"json_extract(input.json, '$.quickplay'),  json_extract(input.json, '$.ritual') from input";
-
-	// Prepare the query
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-
-	try {
+	auto sql = L"insert into spell values(?1, ?2, ?3, ?4, ?5, ?6, ?7)";
 
-		for each(String ^ importfile in Directory::GetFiles(path)) {
+	std::vector<jsonimport::column_t> columns = {
 
-			// Read the JSON from the input file and pin it
-			String^ json = File::ReadAllText(importfile);
-			pin_ptr<wchar_t const> pinjson = PtrToStringChars(json);
+		{ "cardid", jsonimport::coltype_t::base64 },
+		{ "normal", jsonimport::coltype_t::value },
+		{ "continuous", jsonimport::coltype_t::value },
+		{ "equip", jsonimport::coltype_t::value },
+		{ "field", jsonimport::coltype_t::value },
+		{ "quickplay", jsonimport::coltype_t::value },
+		{ "ritual", jsonimport::coltype_t::value }
+	};
 
-			// Bind the query parameter(s)
-			result = sqlite3_bind_text16(statement, 1, pinjson, -1, SQLITE_STATIC);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result);
-
-			// Execute the query; no rows are expected to be returned
-			result = sqlite3_step(statement);
-			if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-
-			// Reset the prepared statement so that it can be executed again
-			result = sqlite3_clear_bindings(statement);
-			if(result == SQLITE_OK) result = sqlite3_reset(statement);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-		}
-	}
-
-	finally { sqlite3_finalize(statement); }
+	import_table(handle, path, sql, columns, false, depth);
 }
 
 //---------------------------------------------------------------------------
@@ -621,48 +489,25 @@ static void import_spell(SQLiteSafeHandle^ handle, String^ path)
 //
 //	handle		- Database instance handle
 //	path		- Path to the import files
+//	depth		- Maximum number of files parsed ahead of the insert statement
 
-static void import_trap(SQLiteSafeHandle^ handle, String^ path)
+static void import_trap(SQLiteSafeHandle^ handle, String^ path, int depth)
 {
 	CLRASSERT(CLRISNOTNULL(handle));
 	CLRASSERT(CLRISNOTNULL(path));
 
-	SQLiteSafeHandle::Reference instance(handle);
-	sqlite3_stmt* statement = nullptr;
-
 	// cardid | normal | continuous | counter
-	auto sql = L"with input(json) as (select ?1) "
-		"insert into trap select base64decode(json_extract(input.json, '$.cardid')), json_extract(input.json, '$.normal'), "
-		"json_extract(input.json, '$.continuous'), json_extract(input.json, '$.counter') from input";
+	auto sql = L"insert into trap values(?1, ?2, ?3, ?4)";
 
-	// Prepare the query
-	int result = sqlite3_prepare16_v2(instance, sql, -1, &statement, nullptr);
-	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+	std::vector<jsonimport::column_t> columns = {
 
-	try {
-
-		for each(String ^ importfile in Directory::GetFiles(path)) {
-
-			// Read the JSON from the input file and pin it
-			String^ json = File::ReadAllText(importfile);
-			pin_ptr<wchar_t const> pinjson = PtrToStringChars(json);
+		{ "cardid", jsonimport::coltype_t::base64 },
+		{ "normal", jsonimport::coltype_t::value },
+		{ "continuous", jsonimport::coltype_t::value },
+		{ "counter", jsonimport::coltype_t::value }
+	};
 
-			// Bind the query parameter(s)
-			result = sqlite3_bind_text16(statement, 1, pinjson, -1, SQLITE_STATIC);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result);
-
-			// Execute the query; no rows are expected to be returned
-			result = sqlite3_step(statement);
-			if(result != SQLITE_DONE) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-
-			// Reset the prepared statement so that it can be executed again
-			result = sqlite3_clear_bindings(statement);
-			if(result == SQLITE_OK) result = sqlite3_reset(statement);
-			if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
-		}
-	}
-
-	finally { sqlite3_finalize(statement); }
+	import_table(handle, path, sql, columns, false, depth);
 }
 
 //---------------------------------------------------------------------------
@@ -745,73 +590,82 @@ Database^ Database::Import(String^ path, String^ outputfile)
 		//
 		String^ cardpath = Path::Combine(path, "card");
 		if(!Directory::Exists(cardpath)) throw gcnew Exception("Unable to access card import directory");
-		import_card(handle, cardpath);
+		import_card(handle, cardpath, IMPORT_QUEUE_DEPTH);
 		
 		// MONSTER
 		//
 		String^ monsterpath = Path::Combine(path, "monster");
 		if(!try_create_directory(monsterpath)) throw gcnew Exception("Unable to access monster import directory");
-		import_monster(handle, monsterpath);
+		import_monster(handle, monsterpath, IMPORT_QUEUE_DEPTH);
 		
 		// SPELL
 		//
 		String^ spellpath = Path::Combine(path, "spell");
 		if(!try_create_directory(spellpath)) throw gcnew Exception("Unable to access spell import directory");
-		import_spell(handle, spellpath);
+		import_spell(handle, spellpath, IMPORT_QUEUE_DEPTH);
 		
 		// TRAP
 		//
 		String^ trappath = Path::Combine(path, "trap");
 		if(!try_create_directory(trappath)) throw gcnew Exception("Unable to access trap import directory");
-		import_trap(handle, trappath);
+		import_trap(handle, trappath, IMPORT_QUEUE_DEPTH);
 		
 		// ARTWORK
 		//
 		String^ artworkpath = Path::Combine(path, "artwork");
 		if(!try_create_directory(artworkpath)) throw gcnew Exception("Unable to access artwork import directory");
-		import_artwork(handle, artworkpath);
+		import_artwork(handle, artworkpath, IMPORT_QUEUE_DEPTH);
 		
 		// DEFAULTARTWORK
 		//
 		String^ defaultartworkpath = Path::Combine(path, "defaultartwork");
 		if(!try_create_directory(defaultartworkpath)) throw gcnew Exception("Unable to access defaultartwork import directory");
-		import_defaultartwork(handle, defaultartworkpath);
+		import_defaultartwork(handle, defaultartworkpath, IMPORT_QUEUE_DEPTH);
 		
 		// SERIES
 		//
 		String^ seriespath = Path::Combine(path, "series");
 		if(!try_create_directory(seriespath)) throw gcnew Exception("Unable to access series import directory");
-		import_series(handle, seriespath);
+		import_series(handle, seriespath, IMPORT_QUEUE_DEPTH);
 		
 		// PRINT
 		//
 		String^ printpath = Path::Combine(path, "print");
 		if(!try_create_directory(printpath)) throw gcnew Exception("Unable to access print import directory");
-		import_print(handle, printpath);
+		import_print(handle, printpath, IMPORT_QUEUE_DEPTH);
 		
 		// RESTRICTIONLIST
 		//
 		String^ restrictionlistpath = Path::Combine(path, "restrictionlist");
 		if(!try_create_directory(restrictionlistpath)) throw gcnew Exception("Unable to access restrictionlist import directory");
-		import_restrictionlist(handle, restrictionlistpath);
+		import_restrictionlist(handle, restrictionlistpath, IMPORT_QUEUE_DEPTH);
 		
 		// RESTRICTION
 		//
 		String^ restrictionpath = Path::Combine(path, "restriction");
 		if(!try_create_directory(restrictionpath)) throw gcnew Exception("Unable to access restriction import directory");
-		import_restriction(handle, restrictionpath);
+		import_restriction(handle, restrictionpath, IMPORT_QUEUE_DEPTH);
 		
 		// RULING
 		//
 		String^ rulingpath = Path::Combine(path, "ruling");
 		if(!try_create_directory(rulingpath)) throw gcnew Exception("Unable to access ruling import directory");
-		import_ruling(handle, rulingpath);
+		import_ruling(handle, rulingpath, IMPORT_QUEUE_DEPTH);
+
+		// CARDSEARCH
+		//
+		// Build the full-text index from the imported card and ruling data, then merge
+		// the index b-trees since no further changes are expected
+		execute_non_query(handle, L"insert into cardsearch select card.cardid, card.name, card.text, "
+			"(select group_concat(ruling.ruling, char(10)) from ruling where ruling.cardid = card.cardid) from card");
+		execute_non_query(handle, L"insert into cardsearchkey select cardid, rowid from cardsearch");
+		execute_non_query(handle, L"insert into cardsearch(cardsearch) values('optimize')");
 
 		// Commit the transaction
 		execute_non_query(handle, L"commit transaction");
 
 		// Create and Vacuum the database instance
-		Database^ database = gcnew Database(handle);
+		Database^ database = gcnew Database(handle, outputfile, DEFAULT_READ_CONNECTIONS, false);
 		database->Vacuum();
 
 		return database;
@@ -0,0 +1,145 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __PARALLELENUMERATOR_H_
+#define __PARALLELENUMERATOR_H_
+#pragma once
+
+#pragma warning(push, 4)
+
+using namespace System;
+using namespace System::Collections::Concurrent;
+using namespace System::Collections::Generic;
+using namespace System::Threading;
+using namespace System::Threading::Tasks;
+
+namespace zuki::ronin::data {
+
+//---------------------------------------------------------------------------
+// Class ParallelEnumerator (internal)
+//
+// Producer/consumer enumeration of a collection. A dedicated reader thread
+// enumerates the source collection into a bounded queue that is drained by
+// a set of consumer tasks; the reader blocks when the queue is full so that
+// the queue capacity limits how far the reader can get ahead of the consumers.
+// Exceptions thrown by the reader or the consumers are collected and thrown
+// from Run() as an AggregateException once all items have been consumed
+//---------------------------------------------------------------------------
+
+template<typename _type>
+ref class ParallelEnumerator
+{
+public:
+
+	// Instance Constructor
+	//
+	ParallelEnumerator(IEnumerable<_type>^ source, Action<_type>^ callback, int capacity, int consumers) :
+		m_source(source), m_callback(callback), m_capacity(capacity), m_consumers(consumers)
+	{
+		if(CLRISNULL(source)) throw gcnew ArgumentNullException("source");
+		if(CLRISNULL(callback)) throw gcnew ArgumentNullException("callback");
+		if(capacity <= 0) throw gcnew ArgumentOutOfRangeException("capacity");
+		if(consumers <= 0) throw gcnew ArgumentOutOfRangeException("consumers");
+	}
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Run
+	//
+	// Enumerates the source collection and waits for all items to be consumed
+	void Run(void)
+	{
+		m_queue = gcnew BlockingCollection<_type>(gcnew ConcurrentQueue<_type>(), m_capacity);
+		m_exceptions = gcnew ConcurrentQueue<Exception^>();
+
+		try {
+
+			// Start the reader thread that steps through the source collection
+			Thread^ reader = gcnew Thread(gcnew ThreadStart(this, &ParallelEnumerator::Produce));
+			reader->IsBackground = true;
+			reader->Start();
+
+			// Start the consumer tasks that drain the queue
+			array<Task^>^ consumers = gcnew array<Task^>(m_consumers);
+			for(int index = 0; index < m_consumers; index++)
+				consumers[index] = Task::Factory->StartNew(gcnew Action(this, &ParallelEnumerator::Consume), TaskCreationOptions::LongRunning);
+
+			Task::WaitAll(consumers);
+			reader->Join();
+
+			// Forward any exceptions that occurred enumerating or consuming the collection
+			if(!m_exceptions->IsEmpty) throw gcnew AggregateException(m_exceptions);
+		}
+
+		finally { delete m_queue; }
+	}
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// Consume
+	//
+	// Consumer task entry point
+	void Consume(void)
+	{
+		for each(_type item in m_queue->GetConsumingEnumerable()) {
+
+			// Invoke the callback and collect any exceptions that occur; the consumer keeps
+			// draining the queue so that the reader is never left blocked on a full queue
+			try { m_callback->Invoke(item); }
+			catch(Exception^ ex) { m_exceptions->Enqueue(ex); }
+		}
+	}
+
+	// Produce
+	//
+	// Reader thread entry point
+	void Produce(void)
+	{
+		try { for each(_type item in m_source) m_queue->Add(item); }
+		catch(Exception^ ex) { m_exceptions->Enqueue(ex); }
+
+		// Release the consumers once the queue has been drained
+		finally { m_queue->CompleteAdding(); }
+	}
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	initonly IEnumerable<_type>^	m_source;			// Source collection
+	initonly Action<_type>^			m_callback;			// Consumer callback
+	initonly int					m_capacity;			// Queue capacity
+	initonly int					m_consumers;		// Number of consumers
+	BlockingCollection<_type>^		m_queue;			// Bounded queue
+	ConcurrentQueue<Exception^>^	m_exceptions;		// Reader and consumer exceptions
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::ronin::data
+
+#pragma warning(pop)
+
+#endif	// __PARALLELENUMERATOR_H_
@@ -74,6 +74,16 @@ bool Print::operator!=(Print^ lhs, Print^ rhs)
 	return lhs->m_printid != rhs->m_printid;
 }
 
+//---------------------------------------------------------------------------
+// Print::CardID::get (internal)
+//
+// Gets the card unique identifier
+
+CardId^ Print::CardID::get(void)
+{
+	return m_cardid;
+}
+
 //---------------------------------------------------------------------------
 // Print::Code::get
 //
@@ -165,6 +165,14 @@ internal:
 	//
 	Print(Database^ database, PrintId^ printid, CardId^ cardid, SeriesId^ seriesid, ArtworkId^ artworkid);
 
+	// CardID
+	//
+	// Gets the card unique identifier
+	property CardId^ CardID
+	{
+		CardId^ get(void);
+	}
+
 private:
 
 	//-----------------------------------------------------------------------
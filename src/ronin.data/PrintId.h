@@ -42,9 +42,10 @@ ref class PrintId : public Uuid
 {
 public:
 
-	// Instance Constructor
+	// Instance Constructors
 	//
 	PrintId(Guid uuid) : Uuid(uuid) {}
+	PrintId(uuidkey_t const& key) : Uuid(key) {}
 };
 
 //---------------------------------------------------------------------------
@@ -0,0 +1,147 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "ReleaseIndex.h"
+
+#pragma warning(push, 4)
+
+namespace zuki::ronin::data {
+
+//---------------------------------------------------------------------------
+// ReleaseIndex Constructor
+//
+// Arguments:
+//
+//	version			- Database version that the index was loaded from
+//	cards			- Cards in order of release date
+//	releasedays		- Release day number of each card
+//	effectivedays	- Effective day number of each restriction list, ascending
+//	restrictions	- Card restrictions for each restriction list
+
+ReleaseIndex::ReleaseIndex(int64_t version, List<Card^>^ cards, List<int>^ releasedays, List<int>^ effectivedays, 
+	List<Dictionary<CardId^, Restriction>^>^ restrictions) : m_version(version)
+{
+	if(CLRISNULL(cards)) throw gcnew ArgumentNullException("cards");
+	if(CLRISNULL(releasedays)) throw gcnew ArgumentNullException("releasedays");
+	if(CLRISNULL(effectivedays)) throw gcnew ArgumentNullException("effectivedays");
+	if(CLRISNULL(restrictions)) throw gcnew ArgumentNullException("restrictions");
+
+	CLRASSERT(cards->Count == releasedays->Count);
+	CLRASSERT(effectivedays->Count == restrictions->Count);
+
+	m_cards = cards->ToArray();
+	m_releasedays = releasedays->ToArray();
+	m_effectivedays = effectivedays->ToArray();
+	m_restrictions = restrictions->ToArray();
+}
+
+//---------------------------------------------------------------------------
+// ReleaseIndex::Enumerate
+//
+// Enumerates the Cards released as of a date and their restriction at that date
+//
+// Arguments:
+//
+//	date		- Date at which to evaluate the cards
+//	callback	- Callback function to invoke for each card
+
+void ReleaseIndex::Enumerate(DateTime date, Action<Card^, Restriction>^ callback)
+{
+	if(CLRISNULL(callback)) throw gcnew ArgumentNullException("callback");
+
+	int day = ToDay(date);
+
+	// The restriction list in effect is the last one that became effective on or before the date
+	int list = UpperBound(m_effectivedays, day) - 1;
+	Dictionary<CardId^, Restriction>^ restrictions = (list >= 0) ? m_restrictions[list] : nullptr;
+
+	// The released cards are the prefix of the cards that were released on or before the date
+	int released = UpperBound(m_releasedays, day);
+	for(int index = 0; index < released; index++) {
+
+		Card^ card = m_cards[index];
+
+		// Cards that are not on the restriction list are unlimited
+		Restriction restriction = Restriction::Unlimited;
+		if(CLRISNULL(restrictions) || !restrictions->TryGetValue(card->CardID, restriction)) restriction = Restriction::Unlimited;
+
+		// Invoke the callback and just eat any exceptions that occur
+		try { callback->Invoke(card, restriction); }
+		catch(Exception^) { /* DO NOTHING */ }
+	}
+}
+
+//---------------------------------------------------------------------------
+// ReleaseIndex::ToDay (static)
+//
+// Converts a DateTime into a day number
+//
+// Arguments:
+//
+//	date		- DateTime to be converted
+
+int ReleaseIndex::ToDay(DateTime date)
+{
+	return static_cast<int>(date.Date.Ticks / TimeSpan::TicksPerDay);
+}
+
+//---------------------------------------------------------------------------
+// ReleaseIndex::UpperBound (private, static)
+//
+// Gets the number of elements in a sorted array less than or equal to a value
+//
+// Arguments:
+//
+//	days		- Sorted array of day numbers
+//	day			- Day number to search for
+
+int ReleaseIndex::UpperBound(array<int>^ days, int day)
+{
+	int lower = 0;
+	int upper = days->Length;
+
+	while(lower < upper) {
+
+		int middle = lower + ((upper - lower) >> 1);
+		if(days[middle] <= day) lower = middle + 1;
+		else upper = middle;
+	}
+
+	return lower;
+}
+
+//---------------------------------------------------------------------------
+// ReleaseIndex::Version::get
+//
+// Gets the database version that the index was loaded from
+
+int64_t ReleaseIndex::Version::get(void)
+{
+	return m_version;
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::ronin::data
+
+#pragma warning(pop)
@@ -0,0 +1,108 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __RELEASEINDEX_H_
+#define __RELEASEINDEX_H_
+#pragma once
+
+#include "Card.h"
+#include "CardId.h"
+#include "Restriction.h"
+
+#pragma warning(push, 4)
+
+using namespace System;
+using namespace System::Collections::Generic;
+
+namespace zuki::ronin::data {
+
+//---------------------------------------------------------------------------
+// Class ReleaseIndex (internal)
+//
+// In-memory index used to answer as-of-date queries. Cards are held in order
+// of their release date, and each restriction list covers the interval from
+// its effective date up to the effective date of the next list; both are
+// located with a binary search on a sorted array of day numbers
+//---------------------------------------------------------------------------
+
+ref class ReleaseIndex
+{
+public:
+
+	// Instance Constructor
+	//
+	ReleaseIndex(int64_t version, List<Card^>^ cards, List<int>^ releasedays, List<int>^ effectivedays, 
+		List<Dictionary<CardId^, Restriction>^>^ restrictions);
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Enumerate
+	//
+	// Enumerates the Cards released as of a date and their restriction at that date
+	void Enumerate(DateTime date, Action<Card^, Restriction>^ callback);
+
+	// ToDay (static)
+	//
+	// Converts a DateTime into a day number
+	static int ToDay(DateTime date);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Version
+	//
+	// Gets the database version that the index was loaded from
+	property int64_t Version
+	{
+		int64_t get(void);
+	}
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// UpperBound (static)
+	//
+	// Gets the number of elements in a sorted array less than or equal to a value
+	static int UpperBound(array<int>^ days, int day);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	initonly int64_t							m_version;			// Database version
+	initonly array<Card^>^						m_cards;			// Cards by release date
+	initonly array<int>^						m_releasedays;		// Card release days
+	initonly array<int>^						m_effectivedays;	// List effective days
+
+	// Card restrictions by restriction list; unlimited cards are not present
+	initonly array<Dictionary<CardId^, Restriction>^>^	m_restrictions;
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::ronin::data
+
+#pragma warning(pop)
+
+#endif	// __RELEASEINDEX_H_
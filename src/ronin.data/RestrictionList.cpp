@@ -165,6 +165,16 @@ int RestrictionList::GetHashCode(void)
 	return m_restrictionlistid->GetHashCode();
 }
 
+//---------------------------------------------------------------------------
+// RestrictionList::RestrictionListID::get (internal)
+//
+// Gets the restriction list unique identifier
+
+RestrictionListId^ RestrictionList::RestrictionListID::get(void)
+{
+	return m_restrictionlistid;
+}
+
 //---------------------------------------------------------------------------
 // RestrictionList::ToString
 //
@@ -107,6 +107,14 @@ internal:
 	//
 	RestrictionList(Database^ database, RestrictionListId^ restrictionlistid);
 
+	// RestrictionListID
+	//
+	// Gets the restriction list unique identifier
+	property RestrictionListId^ RestrictionListID
+	{
+		RestrictionListId^ get(void);
+	}
+
 private:
 
 	//-----------------------------------------------------------------------
@@ -42,9 +42,10 @@ ref class RestrictionListId : public Uuid
 {
 public:
 
-	// Instance Constructor
+	// Instance Constructors
 	//
 	RestrictionListId(Guid uuid) : Uuid(uuid) {}
+	RestrictionListId(uuidkey_t const& key) : Uuid(key) {}
 };
 
 //---------------------------------------------------------------------------
@@ -42,9 +42,10 @@ ref class SeriesId : public Uuid
 {
 public:
 
-	// Instance Constructor
+	// Instance Constructors
 	//
 	SeriesId(Guid uuid) : Uuid(uuid) {}
+	SeriesId(uuidkey_t const& key) : Uuid(key) {}
 };
 
 //---------------------------------------------------------------------------
@@ -0,0 +1,215 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "StatementCache.h"
+
+#include "SQLiteException.h"
+
+#pragma warning(push, 4)
+
+namespace zuki::ronin::data {
+
+//---------------------------------------------------------------------------
+// StatementCache Constructor
+//
+// Arguments:
+//
+//	NONE
+
+StatementCache::StatementCache() : m_lock(gcnew Object())
+{
+	m_statements = new map_t();
+	m_owners = new owner_t();
+	m_keys = new keys_t();
+}
+
+//---------------------------------------------------------------------------
+// StatementCache Destructor
+
+StatementCache::~StatementCache()
+{
+	if(m_disposed) return;
+
+	this->!StatementCache();
+	m_disposed = true;
+}
+
+//---------------------------------------------------------------------------
+// StatementCache Finalizer
+
+StatementCache::!StatementCache()
+{
+	// Statements must be finalized before the database connection can
+	// be closed; the SQLiteSafeHandle is a critical finalizer object and
+	// will not be released before this finalizer has been executed
+	Clear();
+
+	if(m_statements != nullptr) { delete m_statements; m_statements = nullptr; }
+	if(m_owners != nullptr) { delete m_owners; m_owners = nullptr; }
+	if(m_keys != nullptr) { delete m_keys; m_keys = nullptr; }
+}
+
+//---------------------------------------------------------------------------
+// StatementCache::Acquire
+//
+// Acquires a prepared statement for the specified SQL text
+//
+// Arguments:
+//
+//	instance	- Database connection that owns the cache
+//	sql			- SQL text of the statement to acquire
+
+sqlite3_stmt* StatementCache::Acquire(sqlite3* instance, wchar_t const* sql)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if(instance == nullptr) throw gcnew ArgumentNullException("instance");
+	if(sql == nullptr) throw gcnew ArgumentNullException("sql");
+
+	std::wstring_view key(sql);
+	sqlite3_stmt* statement = nullptr;
+
+	msclr::lock lock(m_lock);
+
+	// Check the cache for an idle statement with the same SQL text
+	auto found = m_statements->find(key);
+	if((found != m_statements->end()) && (found->second != nullptr)) {
+
+		statement = found->second;
+		found->second = nullptr;
+		m_owners->emplace(statement, found->first);
+
+		m_hits++;
+		return statement;
+	}
+
+	// Prepare a new persistent statement for the SQL text
+	int result = sqlite3_prepare16_v3(instance, sql, -1, SQLITE_PREPARE_PERSISTENT, &statement, nullptr);
+	if(result != SQLITE_OK) throw gcnew SQLiteException(result, sqlite3_errmsg(instance));
+
+	// Create the key for SQL text that hasn't been seen before; the key is owned
+	// by the cache so the caller's string need not outlive the statement
+	if(found == m_statements->end()) {
+
+		key = m_keys->emplace_front(sql);
+		found = m_statements->emplace(key, nullptr).first;
+	}
+
+	m_owners->emplace(statement, found->first);
+
+	m_misses++;
+	return statement;
+}
+
+//---------------------------------------------------------------------------
+// StatementCache::Clear
+//
+// Finalizes all of the statements held by the cache
+//
+// Arguments:
+//
+//	NONE
+
+void StatementCache::Clear(void)
+{
+	msclr::lock lock(m_lock);
+
+	if(m_statements != nullptr) {
+
+		for(auto& iterator : *m_statements) {
+
+			if(iterator.second != nullptr) sqlite3_finalize(iterator.second);
+			iterator.second = nullptr;
+		}
+	}
+
+	// Checked out statements are finalized as well, Release() will
+	// ignore any statements that are no longer owned by the cache
+	if(m_owners != nullptr) {
+
+		for(auto& iterator : *m_owners) sqlite3_finalize(iterator.first);
+		m_owners->clear();
+	}
+}
+
+//---------------------------------------------------------------------------
+// StatementCache::Hits::get
+//
+// Gets the number of requests satisfied from the cache
+
+int64_t StatementCache::Hits::get(void)
+{
+	return m_hits;
+}
+
+//---------------------------------------------------------------------------
+// StatementCache::Misses::get
+//
+// Gets the number of requests that required a new statement
+
+int64_t StatementCache::Misses::get(void)
+{
+	return m_misses;
+}
+
+//---------------------------------------------------------------------------
+// StatementCache::Release
+//
+// Resets a statement and returns it to the cache
+//
+// Arguments:
+//
+//	statement	- Statement previously returned from Acquire
+
+void StatementCache::Release(sqlite3_stmt* statement)
+{
+	if(statement == nullptr) return;
+
+	msclr::lock lock(m_lock);
+
+	// Statements that are not owned by the cache have already been
+	// finalized by Clear() and cannot be accessed
+	if((m_owners == nullptr) || (m_statements == nullptr)) return;
+
+	auto owner = m_owners->find(statement);
+	if(owner == m_owners->end()) return;
+
+	// Reset the statement and clear the bindings, which may refer to pinned
+	// managed memory that is no longer valid once the caller has returned
+	sqlite3_reset(statement);
+	sqlite3_clear_bindings(statement);
+
+	// Only one statement is cached per SQL text, if the slot has been
+	// filled by another caller in the meantime, finalize this statement
+	auto found = m_statements->find(owner->second);
+	if((found != m_statements->end()) && (found->second == nullptr)) found->second = statement;
+	else sqlite3_finalize(statement);
+
+	m_owners->erase(owner);
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::ronin::data
+
+#pragma warning(pop)
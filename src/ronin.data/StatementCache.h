@@ -0,0 +1,137 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __STATEMENTCACHE_H_
+#define __STATEMENTCACHE_H_
+#pragma once
+
+#include <forward_list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#pragma warning(push, 4)
+
+using namespace System;
+
+namespace zuki::ronin::data {
+
+//---------------------------------------------------------------------------
+// Class StatementCache (internal)
+//
+// Per-connection cache of prepared SQLite statements keyed on the SQL text.
+// Statements are removed from the cache while they are in use, a request
+// for SQL that is already checked out prepares a new statement instead
+//---------------------------------------------------------------------------
+
+ref class StatementCache
+{
+public:
+
+	// Instance Constructor
+	//
+	StatementCache();
+
+	// Destructor
+	//
+	~StatementCache();
+
+	// Finalizer
+	//
+	!StatementCache();
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Acquire
+	//
+	// Acquires a prepared statement for the specified SQL text
+	sqlite3_stmt* Acquire(sqlite3* instance, wchar_t const* sql);
+
+	// Clear
+	//
+	// Finalizes all of the statements held by the cache
+	void Clear(void);
+
+	// Release
+	//
+	// Resets a statement and returns it to the cache
+	void Release(sqlite3_stmt* statement);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Hits
+	//
+	// Gets the number of requests satisfied from the cache
+	property int64_t Hits
+	{
+		int64_t get(void);
+	}
+
+	// Misses
+	//
+	// Gets the number of requests that required a new statement
+	property int64_t Misses
+	{
+		int64_t get(void);
+	}
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Private Type Declarations
+
+	// map_t
+	//
+	// Collection of idle statements keyed on the SQL text
+	using map_t = std::unordered_map<std::wstring_view, sqlite3_stmt*>;
+
+	// owner_t
+	//
+	// Collection of checked out statements and their SQL text key
+	using owner_t = std::unordered_map<sqlite3_stmt*, std::wstring_view>;
+
+	// keys_t
+	//
+	// Owning storage for the SQL text keys; node addresses are stable
+	using keys_t = std::forward_list<std::wstring>;
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	bool					m_disposed = false;		// Object disposal flag
+	Object^					m_lock;					// Synchronization object
+	map_t*					m_statements;			// Cached statements
+	owner_t*				m_owners;				// Checked out statements
+	keys_t*					m_keys;					// Cached SQL text
+	int64_t					m_hits = 0;				// Number of cache hits
+	int64_t					m_misses = 0;			// Number of cache misses
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::ronin::data
+
+#pragma warning(pop)
+
+#endif	// __STATEMENTCACHE_H_
@@ -0,0 +1,119 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#include "stdafx.h"
+#include "StringPool.h"
+
+#pragma warning(push, 4)
+
+namespace zuki::ronin::data {
+
+//---------------------------------------------------------------------------
+// StringPool Constructor
+//
+// Arguments:
+//
+//	capacity	- Maximum number of strings to hold in the pool
+
+StringPool::StringPool(int capacity) : m_lock(gcnew Object()), m_capacity(capacity)
+{
+	if(capacity < 0) throw gcnew ArgumentOutOfRangeException("capacity");
+
+	m_strings = new map_t();
+	m_keys = new keys_t();
+}
+
+//---------------------------------------------------------------------------
+// StringPool Destructor
+
+StringPool::~StringPool()
+{
+	if(m_disposed) return;
+
+	this->!StringPool();
+	m_disposed = true;
+}
+
+//---------------------------------------------------------------------------
+// StringPool Finalizer
+
+StringPool::!StringPool()
+{
+	if(m_strings != nullptr) { delete m_strings; m_strings = nullptr; }
+	if(m_keys != nullptr) { delete m_keys; m_keys = nullptr; }
+}
+
+//---------------------------------------------------------------------------
+// StringPool::Count::get
+//
+// Gets the number of strings held by the pool
+
+int StringPool::Count::get(void)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	msclr::lock lock(m_lock);
+	return static_cast<int>(m_strings->size());
+}
+
+//---------------------------------------------------------------------------
+// StringPool::Intern
+//
+// Gets the String instance for a UTF-8 value
+//
+// Arguments:
+//
+//	utf8		- Pointer to the UTF-8 value
+//	length		- Length of the UTF-8 value, in bytes
+
+String^ StringPool::Intern(char const* utf8, int length)
+{
+	CHECK_DISPOSED(m_disposed);
+
+	if((utf8 == nullptr) || (length <= 0)) return String::Empty;
+
+	std::string_view key(utf8, static_cast<size_t>(length));
+
+	msclr::lock lock(m_lock);
+
+	// Return the existing instance if the value has been seen before
+	auto found = m_strings->find(key);
+	if(found != m_strings->end()) return found->second;
+
+	String^ value = gcnew String(utf8, 0, length, Text::Encoding::UTF8);
+
+	// Once the pool is full new values are no longer retained; this bounds the
+	// memory used if the pool is applied to a column with more values than expected
+	if(m_strings->size() < static_cast<size_t>(m_capacity)) {
+
+		key = m_keys->emplace_front(utf8, static_cast<size_t>(length));
+		m_strings->emplace(key, gcroot<String^>(value));
+	}
+
+	return value;
+}
+
+//---------------------------------------------------------------------------
+
+} // zuki::ronin::data
+
+#pragma warning(pop)
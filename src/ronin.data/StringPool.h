@@ -0,0 +1,113 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __STRINGPOOL_H_
+#define __STRINGPOOL_H_
+#pragma once
+
+#include <forward_list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vcclr.h>
+
+#pragma warning(push, 4)
+
+using namespace System;
+
+namespace zuki::ronin::data {
+
+//---------------------------------------------------------------------------
+// Class StringPool (internal)
+//
+// Per-database intern pool for low-cardinality text column values. Strings
+// are keyed on their native UTF-8 bytes so that a repeated value returns the
+// same String instance without any managed allocation
+//---------------------------------------------------------------------------
+
+ref class StringPool
+{
+public:
+
+	// Instance Constructor
+	//
+	StringPool(int capacity);
+
+	// Destructor
+	//
+	~StringPool();
+
+	// Finalizer
+	//
+	!StringPool();
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// Intern
+	//
+	// Gets the String instance for a UTF-8 value
+	String^ Intern(char const* utf8, int length);
+
+	//-----------------------------------------------------------------------
+	// Properties
+
+	// Count
+	//
+	// Gets the number of strings held by the pool
+	property int Count
+	{
+		int get(void);
+	}
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Private Type Declarations
+
+	// map_t
+	//
+	// Collection of interned strings keyed on the UTF-8 bytes
+	using map_t = std::unordered_map<std::string_view, gcroot<String^>>;
+
+	// keys_t
+	//
+	// Owning storage for the UTF-8 keys; node addresses are stable
+	using keys_t = std::forward_list<std::string>;
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	bool					m_disposed = false;		// Object disposal flag
+	Object^					m_lock;					// Synchronization object
+	int						m_capacity;				// Maximum number of strings
+	map_t*					m_strings;				// Interned strings
+	keys_t*					m_keys;					// Interned UTF-8 keys
+};
+
+//---------------------------------------------------------------------------
+
+} // zuki::ronin::data
+
+#pragma warning(pop)
+
+#endif	// __STRINGPOOL_H_
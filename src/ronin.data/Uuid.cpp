@@ -34,7 +34,25 @@ namespace zuki::ronin::data {
 //
 //	uuid		- Underlying unique identifier
 
-Uuid::Uuid(Guid uuid) : m_uuid(uuid)
+Uuid::Uuid(Guid uuid)
+{
+	// System::Guid is blittable and has the same layout as uuidkey_t
+	uuidkey_t key;
+	pin_ptr<Guid> pinuuid = &uuid;
+	memcpy(&key, pinuuid, sizeof(uuidkey_t));
+
+	m_low = key.low;
+	m_high = key.high;
+}
+
+//---------------------------------------------------------------------------
+// Uuid Constructor (protected)
+//
+// Arguments:
+//
+//	key			- Underlying native key
+
+Uuid::Uuid(uuidkey_t const& key) : m_low(key.low), m_high(key.high)
 {
 }
 
@@ -46,7 +64,7 @@ bool Uuid::operator==(Uuid^ lhs, Uuid^ rhs)
 	if(Object::ReferenceEquals(lhs, rhs)) return true;
 	if(Object::ReferenceEquals(lhs, nullptr) || Object::ReferenceEquals(rhs, nullptr)) return false;
 
-	return lhs->m_uuid == rhs->m_uuid;
+	return (lhs->m_low == rhs->m_low) && (lhs->m_high == rhs->m_high);
 }
 
 //---------------------------------------------------------------------------
@@ -57,7 +75,7 @@ bool Uuid::operator!=(Uuid^ lhs, Uuid^ rhs)
 	if(Object::ReferenceEquals(lhs, rhs)) return false;
 	if(Object::ReferenceEquals(lhs, nullptr) || Object::ReferenceEquals(rhs, nullptr)) return true;
 
-	return lhs->m_uuid != rhs->m_uuid;
+	return (lhs->m_low != rhs->m_low) || (lhs->m_high != rhs->m_high);
 }
 
 //---------------------------------------------------------------------------
@@ -105,21 +123,22 @@ bool Uuid::Equals(Object^ rhs)
 
 int Uuid::GetHashCode(void)
 {
-	return m_uuid.GetHashCode();
+	return static_cast<int>(uuidkey_hash(ToKey()));
 }
 
 //---------------------------------------------------------------------------
-// Uuid::ToByteArray
+// Uuid::ToKey
 //
-// Converts the underlying unique identifier into a byte array
+// Converts the underlying unique identifier into a native key
 //
 // Arguments:
 //
 //	NONE
 
-array<Byte>^ Uuid::ToByteArray(void)
+uuidkey_t Uuid::ToKey(void)
 {
-	return m_uuid.ToByteArray();
+	uuidkey_t key = { m_low, m_high };
+	return key;
 }
 
 //---------------------------------------------------------------------------
@@ -133,7 +152,14 @@ array<Byte>^ Uuid::ToByteArray(void)
 
 String^ Uuid::ToString(void)
 {
-	return m_uuid.ToString();
+	uuidkey_t key = ToKey();
+
+	// Reconstruct the System::Guid in place to access its string formatting
+	Guid uuid;
+	pin_ptr<Guid> pinuuid = &uuid;
+	memcpy(pinuuid, &key, sizeof(uuidkey_t));
+
+	return uuid.ToString();
 }
 
 //---------------------------------------------------------------------------
@@ -24,6 +24,8 @@
 #define __UUID_H_
 #pragma once
 
+#include "uuidkey.h"
+
 #pragma warning(push, 4)
 
 using namespace System;
@@ -33,7 +35,7 @@ namespace zuki::ronin::data {
 //---------------------------------------------------------------------------
 // Class Uuid (internal)
 //
-// Abstraction around a System::Guid
+// Abstraction around a 128-bit unique identifier
 //---------------------------------------------------------------------------
 
 ref class Uuid abstract
@@ -69,10 +71,10 @@ public:
 	// Overrides Object::GetHashCode()
 	virtual int GetHashCode(void) override;
 
-	// ToByteArray
+	// ToKey
 	//
-	// Converts the underlying unique identifier into a byte array
-	array<Byte>^ ToByteArray(void);
+	// Converts the underlying unique identifier into a native key
+	uuidkey_t ToKey(void);
 
 	// ToString
 	//
@@ -81,16 +83,21 @@ public:
 
 protected:
 
-	// Instance Constructor
+	// Instance Constructors
 	//
 	Uuid(Guid uuid);
+	Uuid(uuidkey_t const& key);
 
 private:
 
 	//-----------------------------------------------------------------------
 	// Member Variables
 
-	Guid			m_uuid;			// Underlying unique identifier
+	// A managed class cannot contain a native struct; the uuidkey_t
+	// is held by value as its two 64-bit halves instead
+
+	uint64_t		m_low;			// Underlying key, first 8 bytes
+	uint64_t		m_high;			// Underlying key, last 8 bytes
 };
 
 //---------------------------------------------------------------------------
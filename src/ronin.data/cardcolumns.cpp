@@ -0,0 +1,341 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+// cardcolumns.cpp is compiled as native code without precompiled headers; the
+// SIMD kernels cannot be compiled into MSIL
+
+#include <intrin.h>
+#include <immintrin.h>
+
+#include "cardcolumns.h"
+
+#pragma warning(push, 4)
+
+//---------------------------------------------------------------------------
+// ROWS_PER_WORD
+//
+// Number of rows represented by each word of a selection bitmap
+#define ROWS_PER_WORD		32
+
+//---------------------------------------------------------------------------
+// has_avx2 (local)
+//
+// Determines if the processor and operating system support AVX2 instructions
+//
+// Arguments:
+//
+//	NONE
+
+static bool has_avx2(void)
+{
+	int info[4] = { 0, 0, 0, 0 };
+
+	// CPUID.1:ECX.OSXSAVE[27] and CPUID.1:ECX.AVX[28]
+	__cpuid(info, 1);
+	if((info[2] & ((1 << 27) | (1 << 28))) != ((1 << 27) | (1 << 28))) return false;
+
+	// XCR0 must indicate that the operating system saves the XMM and YMM state
+	if((_xgetbv(0) & 0x06) != 0x06) return false;
+
+	// CPUID.(EAX=07H, ECX=0H):EBX.AVX2[5]
+	__cpuidex(info, 7, 0);
+	return ((info[1] & (1 << 5)) != 0);
+}
+
+// s_avx2
+//
+// Flag indicating that the AVX2 kernels can be used
+static bool const s_avx2 = has_avx2();
+
+//---------------------------------------------------------------------------
+// anyflags_avx2 (local)
+//
+// Clears the bitmap bits for rows that have none of the specified flags set
+//
+// Arguments:
+//
+//	column		- Flags column; padded to a multiple of ROWS_PER_WORD
+//	words		- Number of words in the bitmap
+//	flags		- Flags to test against
+//	bitmap		- Selection bitmap
+
+static void anyflags_avx2(uint32_t const* column, size_t words, uint32_t flags, uint32_t* bitmap)
+{
+	__m256i const vflags = _mm256_set1_epi32(static_cast<int>(flags));
+	__m256i const vzero = _mm256_setzero_si256();
+
+	for(size_t word = 0; word < words; word++) {
+
+		if(bitmap[word] == 0) continue;			// No rows left to test
+
+		uint32_t bits = 0;
+		for(int lane = 0; lane < ROWS_PER_WORD; lane += 8) {
+
+			__m256i values = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(&column[(word * ROWS_PER_WORD) + lane]));
+			__m256i none = _mm256_cmpeq_epi32(_mm256_and_si256(values, vflags), vzero);
+			bits |= static_cast<uint32_t>(~_mm256_movemask_ps(_mm256_castsi256_ps(none)) & 0xFF) << lane;
+		}
+
+		bitmap[word] &= bits;
+	}
+
+	_mm256_zeroupper();
+}
+
+//---------------------------------------------------------------------------
+// anyflags_sse2 (local)
+//
+// Clears the bitmap bits for rows that have none of the specified flags set
+//
+// Arguments:
+//
+//	column		- Flags column; padded to a multiple of ROWS_PER_WORD
+//	words		- Number of words in the bitmap
+//	flags		- Flags to test against
+//	bitmap		- Selection bitmap
+
+static void anyflags_sse2(uint32_t const* column, size_t words, uint32_t flags, uint32_t* bitmap)
+{
+	__m128i const vflags = _mm_set1_epi32(static_cast<int>(flags));
+	__m128i const vzero = _mm_setzero_si128();
+
+	for(size_t word = 0; word < words; word++) {
+
+		if(bitmap[word] == 0) continue;			// No rows left to test
+
+		uint32_t bits = 0;
+		for(int lane = 0; lane < ROWS_PER_WORD; lane += 4) {
+
+			__m128i values = _mm_loadu_si128(reinterpret_cast<__m128i const*>(&column[(word * ROWS_PER_WORD) + lane]));
+			__m128i none = _mm_cmpeq_epi32(_mm_and_si128(values, vflags), vzero);
+			bits |= static_cast<uint32_t>(~_mm_movemask_ps(_mm_castsi128_ps(none)) & 0x0F) << lane;
+		}
+
+		bitmap[word] &= bits;
+	}
+}
+
+//---------------------------------------------------------------------------
+// range_avx2 (local)
+//
+// Clears the bitmap bits for rows with a column value outside of a range
+//
+// Arguments:
+//
+//	column		- Integer column; padded to a multiple of ROWS_PER_WORD
+//	words		- Number of words in the bitmap
+//	minimum		- Minimum column value
+//	maximum		- Maximum column value
+//	bitmap		- Selection bitmap
+
+static void range_avx2(int32_t const* column, size_t words, int32_t minimum, int32_t maximum, uint32_t* bitmap)
+{
+	__m256i const vminimum = _mm256_set1_epi32(minimum);
+	__m256i const vmaximum = _mm256_set1_epi32(maximum);
+
+	for(size_t word = 0; word < words; word++) {
+
+		if(bitmap[word] == 0) continue;			// No rows left to test
+
+		uint32_t bits = 0;
+		for(int lane = 0; lane < ROWS_PER_WORD; lane += 8) {
+
+			__m256i values = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(&column[(word * ROWS_PER_WORD) + lane]));
+			__m256i outside = _mm256_or_si256(_mm256_cmpgt_epi32(vminimum, values), _mm256_cmpgt_epi32(values, vmaximum));
+			bits |= static_cast<uint32_t>(~_mm256_movemask_ps(_mm256_castsi256_ps(outside)) & 0xFF) << lane;
+		}
+
+		bitmap[word] &= bits;
+	}
+
+	_mm256_zeroupper();
+}
+
+//---------------------------------------------------------------------------
+// range_sse2 (local)
+//
+// Clears the bitmap bits for rows with a column value outside of a range
+//
+// Arguments:
+//
+//	column		- Integer column; padded to a multiple of ROWS_PER_WORD
+//	words		- Number of words in the bitmap
+//	minimum		- Minimum column value
+//	maximum		- Maximum column value
+//	bitmap		- Selection bitmap
+
+static void range_sse2(int32_t const* column, size_t words, int32_t minimum, int32_t maximum, uint32_t* bitmap)
+{
+	__m128i const vminimum = _mm_set1_epi32(minimum);
+	__m128i const vmaximum = _mm_set1_epi32(maximum);
+
+	for(size_t word = 0; word < words; word++) {
+
+		if(bitmap[word] == 0) continue;			// No rows left to test
+
+		uint32_t bits = 0;
+		for(int lane = 0; lane < ROWS_PER_WORD; lane += 4) {
+
+			__m128i values = _mm_loadu_si128(reinterpret_cast<__m128i const*>(&column[(word * ROWS_PER_WORD) + lane]));
+			__m128i outside = _mm_or_si128(_mm_cmpgt_epi32(vminimum, values), _mm_cmpgt_epi32(values, vmaximum));
+			bits |= static_cast<uint32_t>(~_mm_movemask_ps(_mm_castsi128_ps(outside)) & 0x0F) << lane;
+		}
+
+		bitmap[word] &= bits;
+	}
+}
+
+//---------------------------------------------------------------------------
+// cardcolumns Constructor
+//
+// Arguments:
+//
+//	capacity	- Initial row capacity of the catalog
+
+cardcolumns::cardcolumns(size_t capacity)
+{
+	// Round the capacity up to the next multiple of ROWS_PER_WORD
+	capacity = ((capacity + ROWS_PER_WORD - 1) / ROWS_PER_WORD) * ROWS_PER_WORD;
+
+	for(auto& column : m_columns) column.reserve(capacity);
+	m_flags.reserve(capacity);
+}
+
+//---------------------------------------------------------------------------
+// cardcolumns::append
+//
+// Appends a row to the catalog and returns its index
+//
+// Arguments:
+//
+//	values		- Integer column values for the row
+//	flags		- Flags column value for the row
+
+size_t cardcolumns::append(int32_t const (&values)[columncount], uint32_t flags)
+{
+	// Grow the columns by a full word of padding rows when the current word is full;
+	// padding rows have null values and no flags and can never be selected
+	if((m_size % ROWS_PER_WORD) == 0) {
+
+		for(auto& column : m_columns) column.resize(m_size + ROWS_PER_WORD, CARDCOLUMNS_NULL);
+		m_flags.resize(m_size + ROWS_PER_WORD, 0);
+	}
+
+	for(int index = 0; index < columncount; index++) m_columns[index][m_size] = values[index];
+	m_flags[m_size] = flags;
+
+	return m_size++;
+}
+
+//---------------------------------------------------------------------------
+// cardcolumns::initialize (static)
+//
+// Initializes a filter_t with no active criteria
+//
+// Arguments:
+//
+//	filter		- filter_t to be initialized
+
+void cardcolumns::initialize(filter_t& filter)
+{
+	for(int index = 0; index < columncount; index++) {
+
+		filter.active[index] = false;
+		filter.minimum[index] = INT32_MIN;
+		filter.maximum[index] = INT32_MAX;
+	}
+
+	filter.anyflags = 0;
+}
+
+//---------------------------------------------------------------------------
+// cardcolumns::select
+//
+// Evaluates a filter and writes the matching row indexes into a selection vector
+//
+// Arguments:
+//
+//	filter		- Filter criteria to evaluate
+//	selection	- On output, contains the indexes of the matching rows
+
+size_t cardcolumns::select(filter_t const& filter, std::vector<uint32_t>& selection) const
+{
+	size_t const words = (m_size + ROWS_PER_WORD - 1) / ROWS_PER_WORD;
+
+	selection.clear();
+	if(words == 0) return 0;
+
+	// Start with all of the rows selected, excluding the padding rows in the final word
+	std::vector<uint32_t> bitmap(words, UINT32_MAX);
+	if((m_size % ROWS_PER_WORD) != 0) bitmap[words - 1] = (1U << (m_size % ROWS_PER_WORD)) - 1;
+
+	// Evaluate each active column range; null values are always excluded from an active range
+	for(int index = 0; index < columncount; index++) {
+
+		if(!filter.active[index]) continue;
+
+		int32_t minimum = (filter.minimum[index] == CARDCOLUMNS_NULL) ? CARDCOLUMNS_NULL + 1 : filter.minimum[index];
+		if(s_avx2) range_avx2(m_columns[index].data(), words, minimum, filter.maximum[index], bitmap.data());
+		else range_sse2(m_columns[index].data(), words, minimum, filter.maximum[index], bitmap.data());
+	}
+
+	// Evaluate the flags
+	if(filter.anyflags != 0) {
+
+		if(s_avx2) anyflags_avx2(m_flags.data(), words, filter.anyflags, bitmap.data());
+		else anyflags_sse2(m_flags.data(), words, filter.anyflags, bitmap.data());
+	}
+
+	// Convert the bitmap into the selection vector
+	for(size_t word = 0; word < words; word++) {
+
+		uint32_t bits = bitmap[word];
+		while(bits != 0) {
+
+			unsigned long bit = 0;
+			_BitScanForward(&bit, bits);
+
+			selection.push_back(static_cast<uint32_t>((word * ROWS_PER_WORD) + bit));
+			bits &= (bits - 1);
+		}
+	}
+
+	return selection.size();
+}
+
+//---------------------------------------------------------------------------
+// cardcolumns::size
+//
+// Gets the number of rows in the catalog
+//
+// Arguments:
+//
+//	NONE
+
+size_t cardcolumns::size(void) const
+{
+	return m_size;
+}
+
+//---------------------------------------------------------------------------
+
+#pragma warning(pop)
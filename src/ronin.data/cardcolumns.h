@@ -0,0 +1,136 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __CARDCOLUMNS_H_
+#define __CARDCOLUMNS_H_
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#pragma warning(push, 4)
+
+//---------------------------------------------------------------------------
+// Constants
+
+// CARDCOLUMNS_NULL
+//
+// Column value used for rows that have no value; never matches a range
+#define CARDCOLUMNS_NULL INT32_MIN
+
+// CARDFLAG_XXXX
+//
+// Bits of the flags column
+#define CARDFLAG_MONSTERNORMAL		0x00000001
+#define CARDFLAG_MONSTEREFFECT		0x00000002
+#define CARDFLAG_MONSTERFUSION		0x00000004
+#define CARDFLAG_MONSTERRITUAL		0x00000008
+#define CARDFLAG_MONSTERTOON		0x00000010
+#define CARDFLAG_MONSTERUNION		0x00000020
+#define CARDFLAG_MONSTERSPIRIT		0x00000040
+#define CARDFLAG_MONSTERGEMINI		0x00000080
+#define CARDFLAG_SPELLNORMAL		0x00000100
+#define CARDFLAG_SPELLCONTINUOUS	0x00000200
+#define CARDFLAG_SPELLEQUIP			0x00000400
+#define CARDFLAG_SPELLFIELD			0x00000800
+#define CARDFLAG_SPELLQUICKPLAY		0x00001000
+#define CARDFLAG_SPELLRITUAL		0x00002000
+#define CARDFLAG_TRAPNORMAL			0x00004000
+#define CARDFLAG_TRAPCONTINUOUS		0x00008000
+#define CARDFLAG_TRAPCOUNTER		0x00010000
+
+//---------------------------------------------------------------------------
+// Class cardcolumns
+//
+// Native struct-of-arrays card catalog; each column is stored as a contiguous
+// array of 32-bit values padded to a multiple of 32 rows. Filters are evaluated
+// one column at a time with SIMD kernels into a selection bitmap
+//---------------------------------------------------------------------------
+
+class cardcolumns
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Type Declarations
+
+	// column_t
+	//
+	// Identifiers of the integer columns
+	enum column_t { type = 0, attribute, monstertype, level, attack, defense, releaseday, columncount };
+
+	// filter_t
+	//
+	// Filter criteria; a column participates when its range is active
+	struct filter_t {
+
+		bool		active[columncount];		// Column range is active
+		int32_t		minimum[columncount];		// Minimum column value
+		int32_t		maximum[columncount];		// Maximum column value
+		uint32_t	anyflags;					// Any of the flags must be set (0 = inactive)
+	};
+
+	// Instance Constructor
+	//
+	explicit cardcolumns(size_t capacity);
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// append
+	//
+	// Appends a row to the catalog and returns its index
+	size_t append(int32_t const (&values)[columncount], uint32_t flags);
+
+	// initialize (static)
+	//
+	// Initializes a filter_t with no active criteria
+	static void initialize(filter_t& filter);
+
+	// select
+	//
+	// Evaluates a filter and writes the matching row indexes into a selection vector
+	size_t select(filter_t const& filter, std::vector<uint32_t>& selection) const;
+
+	// size
+	//
+	// Gets the number of rows in the catalog
+	size_t size(void) const;
+
+private:
+
+	cardcolumns(cardcolumns const&)=delete;
+	cardcolumns& operator=(cardcolumns const&)=delete;
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	size_t							m_size = 0;					// Number of rows
+	std::vector<int32_t>			m_columns[columncount];		// Integer columns
+	std::vector<uint32_t>			m_flags;					// Flags column
+};
+
+//---------------------------------------------------------------------------
+
+#pragma warning(pop)
+
+#endif	// __CARDCOLUMNS_H_
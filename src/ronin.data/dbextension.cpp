@@ -31,6 +31,7 @@
 
 #include "CardAttribute.h"
 #include "CardType.h"
+#include "dbextension.h"
 #include "MonsterType.h"
 #include "PrintRarity.h"
 #include "Restriction.h"
@@ -160,6 +161,36 @@ static void cardattribute(sqlite3_context* context, int argc, sqlite3_value** ar
 	return sqlite3_result_int(context, static_cast<int>(CardAttribute::None));
 }
 
+//---------------------------------------------------------------------------
+// cardattributestr (local)
+//
+// SQLite scalar function to convert a CardAttribute into a attribute string
+//
+// Arguments:
+//
+//	context		- SQLite context object
+//	argc		- Number of supplied arguments
+//	argv		- Argument values
+
+static void cardattributestr(sqlite3_context* context, int argc, sqlite3_value** argv)
+{
+	if((argc != 1) || (argv[0] == nullptr)) return sqlite3_result_error(context, "invalid arguments", -1);
+
+	CardAttribute cardattribute = static_cast<CardAttribute>(sqlite3_value_int(argv[0]));
+
+	if(cardattribute == CardAttribute::Dark) return sqlite3_result_text16(context, L"DARK", -1, SQLITE_STATIC);
+	else if(cardattribute == CardAttribute::Earth) return sqlite3_result_text16(context, L"EARTH", -1, SQLITE_STATIC);
+	else if(cardattribute == CardAttribute::Fire) return sqlite3_result_text16(context, L"FIRE", -1, SQLITE_STATIC);
+	else if(cardattribute == CardAttribute::Light) return sqlite3_result_text16(context, L"LIGHT", -1, SQLITE_STATIC);
+	else if(cardattribute == CardAttribute::Spell) return sqlite3_result_text16(context, L"SPELL", -1, SQLITE_STATIC);
+	else if(cardattribute == CardAttribute::Trap) return sqlite3_result_text16(context, L"TRAP", -1, SQLITE_STATIC);
+	else if(cardattribute == CardAttribute::Water) return sqlite3_result_text16(context, L"WATER", -1, SQLITE_STATIC);
+	else if(cardattribute == CardAttribute::Wind) return sqlite3_result_text16(context, L"WIND", -1, SQLITE_STATIC);
+	
+	// Input value was not a valid attribute
+	return sqlite3_result_null(context);
+}
+
 //---------------------------------------------------------------------------
 // cardtype (local)
 //
@@ -188,6 +219,31 @@ static void cardtype(sqlite3_context* context, int argc, sqlite3_value** argv)
 	return sqlite3_result_int(context, static_cast<int>(CardType::None));
 }
 
+//---------------------------------------------------------------------------
+// cardtypestr (local)
+//
+// SQLite scalar function to convert a CardType into a card type string
+//
+// Arguments:
+//
+//	context		- SQLite context object
+//	argc		- Number of supplied arguments
+//	argv		- Argument values
+
+static void cardtypestr(sqlite3_context* context, int argc, sqlite3_value** argv)
+{
+	if((argc != 1) || (argv[0] == nullptr)) return sqlite3_result_error(context, "invalid arguments", -1);
+
+	CardType cardtype = static_cast<CardType>(sqlite3_value_int(argv[0]));
+
+	if(cardtype == CardType::Monster) return sqlite3_result_text16(context, L"Monster", -1, SQLITE_STATIC);
+	else if(cardtype == CardType::Spell) return sqlite3_result_text16(context, L"Spell", -1, SQLITE_STATIC);
+	else if(cardtype == CardType::Trap) return sqlite3_result_text16(context, L"Trap", -1, SQLITE_STATIC);
+	
+	// Input value was not a valid card type
+	return sqlite3_result_null(context);
+}
+
 //---------------------------------------------------------------------------
 // monstertype (local)
 //
@@ -233,6 +289,48 @@ static void monstertype(sqlite3_context* context, int argc, sqlite3_value** argv
 	return sqlite3_result_int(context, static_cast<int>(CardAttribute::None));
 }
 
+//---------------------------------------------------------------------------
+// monstertypestr (local)
+//
+// SQLite scalar function to convert a MonsterType into a monster type string
+//
+// Arguments:
+//
+//	context		- SQLite context object
+//	argc		- Number of supplied arguments
+//	argv		- Argument values
+
+static void monstertypestr(sqlite3_context* context, int argc, sqlite3_value** argv)
+{
+	if((argc != 1) || (argv[0] == nullptr)) return sqlite3_result_error(context, "invalid arguments", -1);
+
+	MonsterType monstertype = static_cast<MonsterType>(sqlite3_value_int(argv[0]));
+
+	if(monstertype == MonsterType::Aqua) return sqlite3_result_text16(context, L"Aqua", -1, SQLITE_STATIC);
+	else if(monstertype == MonsterType::Beast) return sqlite3_result_text16(context, L"Beast", -1, SQLITE_STATIC);
+	else if(monstertype == MonsterType::BeastWarrior) return sqlite3_result_text16(context, L"Beast-Warrior", -1, SQLITE_STATIC);
+	else if(monstertype == MonsterType::Dinosaur) return sqlite3_result_text16(context, L"Dinosaur", -1, SQLITE_STATIC);
+	else if(monstertype == MonsterType::Dragon) return sqlite3_result_text16(context, L"Dragon", -1, SQLITE_STATIC);
+	else if(monstertype == MonsterType::Fairy) return sqlite3_result_text16(context, L"Fairy", -1, SQLITE_STATIC);
+	else if(monstertype == MonsterType::Fiend) return sqlite3_result_text16(context, L"Fiend", -1, SQLITE_STATIC);
+	else if(monstertype == MonsterType::Fish) return sqlite3_result_text16(context, L"Fish", -1, SQLITE_STATIC);
+	else if(monstertype == MonsterType::Insect) return sqlite3_result_text16(context, L"Insect", -1, SQLITE_STATIC);
+	else if(monstertype == MonsterType::Machine) return sqlite3_result_text16(context, L"Machine", -1, SQLITE_STATIC);
+	else if(monstertype == MonsterType::Plant) return sqlite3_result_text16(context, L"Plant", -1, SQLITE_STATIC);
+	else if(monstertype == MonsterType::Pyro) return sqlite3_result_text16(context, L"Pyro", -1, SQLITE_STATIC);
+	else if(monstertype == MonsterType::Reptile) return sqlite3_result_text16(context, L"Reptile", -1, SQLITE_STATIC);
+	else if(monstertype == MonsterType::Rock) return sqlite3_result_text16(context, L"Rock", -1, SQLITE_STATIC);
+	else if(monstertype == MonsterType::SeaSerpent) return sqlite3_result_text16(context, L"Sea Serpent", -1, SQLITE_STATIC);
+	else if(monstertype == MonsterType::Spellcaster) return sqlite3_result_text16(context, L"Spellcaster", -1, SQLITE_STATIC);
+	else if(monstertype == MonsterType::Thunder) return sqlite3_result_text16(context, L"Thunder", -1, SQLITE_STATIC);
+	else if(monstertype == MonsterType::Warrior) return sqlite3_result_text16(context, L"Warrior", -1, SQLITE_STATIC);
+	else if(monstertype == MonsterType::WingedBeast) return sqlite3_result_text16(context, L"Winged Beast", -1, SQLITE_STATIC);
+	else if(monstertype == MonsterType::Zombie) return sqlite3_result_text16(context, L"Zombie", -1, SQLITE_STATIC);
+	
+	// Input value was not a valid monster type
+	return sqlite3_result_null(context);
+}
+
 //---------------------------------------------------------------------------
 // newid (local)
 //
@@ -321,6 +419,37 @@ static void printrarity(sqlite3_context* context, int argc, sqlite3_value** argv
 	return sqlite3_result_int(context, static_cast<int>(PrintRarity::None));
 }
 
+//---------------------------------------------------------------------------
+// printraritystr (local)
+//
+// SQLite scalar function to convert a PrintRarity into a rarity string
+//
+// Arguments:
+//
+//	context		- SQLite context object
+//	argc		- Number of supplied arguments
+//	argv		- Argument values
+
+static void printraritystr(sqlite3_context* context, int argc, sqlite3_value** argv)
+{
+	if((argc != 1) || (argv[0] == nullptr)) return sqlite3_result_error(context, "invalid arguments", -1);
+
+	PrintRarity printrarity = static_cast<PrintRarity>(sqlite3_value_int(argv[0]));
+
+	if(printrarity == PrintRarity::Common) return sqlite3_result_text16(context, L"Common", -1, SQLITE_STATIC);
+	else if(printrarity == PrintRarity::GoldRare) return sqlite3_result_text16(context, L"Gold Rare", -1, SQLITE_STATIC);
+	else if(printrarity == PrintRarity::ParallelRare) return sqlite3_result_text16(context, L"Parallel Rare", -1, SQLITE_STATIC);
+	else if(printrarity == PrintRarity::PrismaticSecretRare) return sqlite3_result_text16(context, L"Prismatic Secret Rare", -1, SQLITE_STATIC);
+	else if(printrarity == PrintRarity::Rare) return sqlite3_result_text16(context, L"Rare", -1, SQLITE_STATIC);
+	else if(printrarity == PrintRarity::SecretRare) return sqlite3_result_text16(context, L"Secret Rare", -1, SQLITE_STATIC);
+	else if(printrarity == PrintRarity::SuperRare) return sqlite3_result_text16(context, L"Super Rare", -1, SQLITE_STATIC);
+	else if(printrarity == PrintRarity::UltraParallelRare) return sqlite3_result_text16(context, L"Ultra Parallel Rare", -1, SQLITE_STATIC);
+	else if(printrarity == PrintRarity::UltraRare) return sqlite3_result_text16(context, L"Ultra Rare", -1, SQLITE_STATIC);
+	
+	// Input value was not a valid rarity
+	return sqlite3_result_null(context);
+}
+
 //---------------------------------------------------------------------------
 // restriction (local)
 //
@@ -396,10 +525,9 @@ static void uuid(sqlite3_context* context, int argc, sqlite3_value** argv)
 		Guid uuid = Guid::Empty;
 		if(Guid::TryParse(gcnew String(inputptr), uuid)) {
 
-			// If the Guid parsed, return it as a 16-byte blob
-			array<Byte>^ bytes = uuid.ToByteArray();
-			pin_ptr<Byte> pinbytes = &bytes[0];
-			return sqlite3_result_blob(context, &pinbytes[0], sizeof(UUID), SQLITE_TRANSIENT);
+			// If the Guid parsed, return it as a 16-byte blob; System::Guid is blittable
+			pin_ptr<Guid> pinuuid = &uuid;
+			return sqlite3_result_blob(context, pinuuid, sizeof(UUID), SQLITE_TRANSIENT);
 		}
 	}
 
@@ -439,6 +567,266 @@ static void uuidstr(sqlite3_context* context, int argc, sqlite3_value** argv)
 	return sqlite3_result_null(context);
 }
 
+//---------------------------------------------------------------------------
+// uuidarray_cursor (local)
+//
+// Cursor implementation for the uuidarray virtual table
+
+struct uuidarray_cursor {
+
+	sqlite3_vtab_cursor	base;			// Base class (must be first)
+	uuidarray_t const*	uuids;			// Bound array of UUIDs
+	size_t				index;			// Current array index
+};
+
+//---------------------------------------------------------------------------
+// uuidarray_bestindex (local)
+//
+// Determines the best way to access the uuidarray virtual table
+//
+// Arguments:
+//
+//	vtab		- Virtual table instance
+//	info		- Index information
+
+static int uuidarray_bestindex(sqlite3_vtab* /*vtab*/, sqlite3_index_info* info)
+{
+	// The hidden pointer column (1) must be constrained by equality for the table
+	// to produce any rows; this is how the table-valued function argument arrives
+	for(int index = 0; index < info->nConstraint; index++) {
+
+		sqlite3_index_info::sqlite3_index_constraint const* constraint = &info->aConstraint[index];
+		if((constraint->iColumn == 1) && (constraint->op == SQLITE_INDEX_CONSTRAINT_EQ)) {
+
+			if(!constraint->usable) return SQLITE_CONSTRAINT;
+
+			info->aConstraintUsage[index].argvIndex = 1;
+			info->aConstraintUsage[index].omit = 1;
+			info->idxNum = 1;
+			info->estimatedCost = 1.0;
+			info->estimatedRows = 100;
+
+			return SQLITE_OK;
+		}
+	}
+
+	// No array was provided; this will produce an empty result set
+	info->idxNum = 0;
+	info->estimatedCost = 2147483647.0;
+	info->estimatedRows = 1;
+
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// uuidarray_close (local)
+//
+// Closes a uuidarray virtual table cursor
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+
+static int uuidarray_close(sqlite3_vtab_cursor* cursor)
+{
+	sqlite3_free(cursor);
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// uuidarray_column (local)
+//
+// Accesses a column of the current uuidarray virtual table cursor row
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+//	context		- Result context object
+//	ordinal		- Ordinal of the column to access
+
+static int uuidarray_column(sqlite3_vtab_cursor* cursor, sqlite3_context* context, int ordinal)
+{
+	uuidarray_cursor* uuidcursor = reinterpret_cast<uuidarray_cursor*>(cursor);
+	assert(uuidcursor->uuids != nullptr);
+
+	// value
+	if(ordinal == 0) sqlite3_result_blob(context, &(*uuidcursor->uuids)[uuidcursor->index], sizeof(uuidkey_t), SQLITE_TRANSIENT);
+
+	// pointer (hidden) is never returned
+	else sqlite3_result_null(context);
+
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// uuidarray_connect (local)
+//
+// Connects to the eponymous uuidarray virtual table
+//
+// Arguments:
+//
+//	db			- SQLite database instance
+//	aux			- Client data pointer passed to sqlite3_create_module_v2
+//	argc		- Number of module arguments
+//	argv		- Module arguments
+//	vtab		- On success, receives the virtual table instance
+//	errmsg		- On failure, receives the error message
+
+static int uuidarray_connect(sqlite3* db, void* /*aux*/, int /*argc*/, const char* const* /*argv*/, sqlite3_vtab** vtab, char** /*errmsg*/)
+{
+	int result = sqlite3_declare_vtab(db, "create table uuidarray(value blob, pointer hidden)");
+	if(result != SQLITE_OK) return result;
+
+	*vtab = reinterpret_cast<sqlite3_vtab*>(sqlite3_malloc(sizeof(sqlite3_vtab)));
+	if(*vtab == nullptr) return SQLITE_NOMEM;
+
+	memset(*vtab, 0, sizeof(sqlite3_vtab));
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// uuidarray_disconnect (local)
+//
+// Disconnects from the eponymous uuidarray virtual table
+//
+// Arguments:
+//
+//	vtab		- Virtual table instance
+
+static int uuidarray_disconnect(sqlite3_vtab* vtab)
+{
+	sqlite3_free(vtab);
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// uuidarray_eof (local)
+//
+// Determines if the uuidarray virtual table cursor is past the last row
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+
+static int uuidarray_eof(sqlite3_vtab_cursor* cursor)
+{
+	uuidarray_cursor* uuidcursor = reinterpret_cast<uuidarray_cursor*>(cursor);
+	return ((uuidcursor->uuids == nullptr) || (uuidcursor->index >= uuidcursor->uuids->size())) ? 1 : 0;
+}
+
+//---------------------------------------------------------------------------
+// uuidarray_filter (local)
+//
+// Begins a search of the uuidarray virtual table
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+//	idxnum		- Index number selected by uuidarray_bestindex
+//	idxstr		- Index string selected by uuidarray_bestindex
+//	argc		- Number of constraint arguments
+//	argv		- Constraint arguments
+
+static int uuidarray_filter(sqlite3_vtab_cursor* cursor, int idxnum, const char* /*idxstr*/, int argc, sqlite3_value** argv)
+{
+	uuidarray_cursor* uuidcursor = reinterpret_cast<uuidarray_cursor*>(cursor);
+
+	uuidcursor->uuids = nullptr;
+	uuidcursor->index = 0;
+
+	// The array must have been bound with sqlite3_bind_pointer and the correct type name,
+	// anything else (including NULL) is treated as an empty array
+	if((idxnum == 1) && (argc == 1))
+		uuidcursor->uuids = reinterpret_cast<uuidarray_t const*>(sqlite3_value_pointer(argv[0], UUIDARRAY_POINTER_TYPE));
+
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// uuidarray_next (local)
+//
+// Advances the uuidarray virtual table cursor to the next row
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+
+static int uuidarray_next(sqlite3_vtab_cursor* cursor)
+{
+	reinterpret_cast<uuidarray_cursor*>(cursor)->index++;
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// uuidarray_open (local)
+//
+// Opens a new uuidarray virtual table cursor
+//
+// Arguments:
+//
+//	vtab		- Virtual table instance
+//	cursor		- On success, receives the cursor instance
+
+static int uuidarray_open(sqlite3_vtab* /*vtab*/, sqlite3_vtab_cursor** cursor)
+{
+	uuidarray_cursor* uuidcursor = reinterpret_cast<uuidarray_cursor*>(sqlite3_malloc(sizeof(uuidarray_cursor)));
+	if(uuidcursor == nullptr) return SQLITE_NOMEM;
+
+	memset(uuidcursor, 0, sizeof(uuidarray_cursor));
+	*cursor = &uuidcursor->base;
+
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// uuidarray_rowid (local)
+//
+// Gets the rowid of the current uuidarray virtual table cursor row
+//
+// Arguments:
+//
+//	cursor		- Cursor instance
+//	rowid		- Receives the rowid
+
+static int uuidarray_rowid(sqlite3_vtab_cursor* cursor, sqlite_int64* rowid)
+{
+	*rowid = static_cast<sqlite_int64>(reinterpret_cast<uuidarray_cursor*>(cursor)->index) + 1;
+	return SQLITE_OK;
+}
+
+//---------------------------------------------------------------------------
+// uuidarray_module (local)
+//
+// SQLite eponymous-only virtual table module used to expose an array of UUIDs
+// bound as a pointer to a query; use as "select value from uuidarray(?1)"
+
+static sqlite3_module uuidarray_module = {
+
+	0,							// iVersion
+	nullptr,					// xCreate (eponymous-only)
+	uuidarray_connect,			// xConnect
+	uuidarray_bestindex,		// xBestIndex
+	uuidarray_disconnect,		// xDisconnect
+	nullptr,					// xDestroy
+	uuidarray_open,				// xOpen
+	uuidarray_close,			// xClose
+	uuidarray_filter,			// xFilter
+	uuidarray_next,				// xNext
+	uuidarray_eof,				// xEof
+	uuidarray_column,			// xColumn
+	uuidarray_rowid,			// xRowid
+	nullptr,					// xUpdate
+	nullptr,					// xBegin
+	nullptr,					// xSync
+	nullptr,					// xCommit
+	nullptr,					// xRollback
+	nullptr,					// xFindFunction
+	nullptr,					// xRename
+	nullptr,					// xSavepoint
+	nullptr,					// xRelease
+	nullptr						// xRollbackTo
+};
+
 //---------------------------------------------------------------------------
 // sqlite3_extension_init
 //
@@ -471,16 +859,31 @@ extern "C" int sqlite3_extension_init(sqlite3* db, char** errmsg, const sqlite3_
 	result = sqlite3_create_function16(db, L"cardattribute", 1, SQLITE_UTF16, nullptr, cardattribute, nullptr, nullptr);
 	if(result != SQLITE_OK) { *errmsg = sqlite3_mprintf("Unable to register scalar function cardattribute (%d)", result); return result; }
 
+	// cardattributestr function
+	//
+	result = sqlite3_create_function16(db, L"cardattributestr", 1, SQLITE_UTF16, nullptr, cardattributestr, nullptr, nullptr);
+	if(result != SQLITE_OK) { *errmsg = sqlite3_mprintf("Unable to register scalar function cardattributestr (%d)", result); return result; }
+
 	// cardtype function
 	//
 	result = sqlite3_create_function16(db, L"cardtype", 1, SQLITE_UTF16, nullptr, cardtype, nullptr, nullptr);
 	if(result != SQLITE_OK) { *errmsg = sqlite3_mprintf("Unable to register scalar function cardtype (%d)", result); return result; }
 
+	// cardtypestr function
+	//
+	result = sqlite3_create_function16(db, L"cardtypestr", 1, SQLITE_UTF16, nullptr, cardtypestr, nullptr, nullptr);
+	if(result != SQLITE_OK) { *errmsg = sqlite3_mprintf("Unable to register scalar function cardtypestr (%d)", result); return result; }
+
 	// monstertype function
 	//
 	result = sqlite3_create_function16(db, L"monstertype", 1, SQLITE_UTF16, nullptr, monstertype, nullptr, nullptr);
 	if(result != SQLITE_OK) { *errmsg = sqlite3_mprintf("Unable to register scalar function monstertype (%d)", result); return result; }
 
+	// monstertypestr function
+	//
+	result = sqlite3_create_function16(db, L"monstertypestr", 1, SQLITE_UTF16, nullptr, monstertypestr, nullptr, nullptr);
+	if(result != SQLITE_OK) { *errmsg = sqlite3_mprintf("Unable to register scalar function monstertypestr (%d)", result); return result; }
+
 	// newid function
 	//
 	result = sqlite3_create_function16(db, L"newid", 0, SQLITE_UTF16, nullptr, newid, nullptr, nullptr);
@@ -496,6 +899,11 @@ extern "C" int sqlite3_extension_init(sqlite3* db, char** errmsg, const sqlite3_
 	result = sqlite3_create_function16(db, L"printrarity", 1, SQLITE_UTF16, nullptr, printrarity, nullptr, nullptr);
 	if(result != SQLITE_OK) { *errmsg = sqlite3_mprintf("Unable to register scalar function printrarity (%d)", result); return result; }
 
+	// printraritystr function
+	//
+	result = sqlite3_create_function16(db, L"printraritystr", 1, SQLITE_UTF16, nullptr, printraritystr, nullptr, nullptr);
+	if(result != SQLITE_OK) { *errmsg = sqlite3_mprintf("Unable to register scalar function printraritystr (%d)", result); return result; }
+
 	// restriction function
 	//
 	result = sqlite3_create_function16(db, L"restriction", 1, SQLITE_UTF16, nullptr, restriction, nullptr, nullptr);
@@ -516,6 +924,11 @@ extern "C" int sqlite3_extension_init(sqlite3* db, char** errmsg, const sqlite3_
 	result = sqlite3_create_function16(db, L"uuidstr", 1, SQLITE_UTF16, nullptr, uuidstr, nullptr, nullptr);
 	if(result != SQLITE_OK) { *errmsg = sqlite3_mprintf("Unable to register scalar function uuidstr (%d)", result); return result; }
 
+	// uuidarray virtual table
+	//
+	result = sqlite3_create_module_v2(db, "uuidarray", &uuidarray_module, nullptr, nullptr);
+	if(result != SQLITE_OK) { *errmsg = sqlite3_mprintf("Unable to register virtual table module uuidarray (%d)", result); return result; }
+
 	return SQLITE_OK;
 }
 
@@ -0,0 +1,62 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __DBEXTENSION_H_
+#define __DBEXTENSION_H_
+#pragma once
+
+#include <rpc.h>
+#include <vector>
+
+#include "uuidkey.h"
+
+#pragma warning(push, 4)
+
+//---------------------------------------------------------------------------
+// Type Declarations
+
+// uuidarray_t
+//
+// Array of UUID keys bound to the uuidarray table-valued function
+using uuidarray_t = std::vector<uuidkey_t>;
+
+//---------------------------------------------------------------------------
+// Constants
+
+// UUIDARRAY_POINTER_TYPE
+//
+// Pointer type name used to bind a uuidarray_t with sqlite3_bind_pointer
+#define UUIDARRAY_POINTER_TYPE "uuidarray_t"
+
+//---------------------------------------------------------------------------
+// Functions
+
+// sqlite3_extension_init
+//
+// SQLite Extension Library entry point
+extern "C" int sqlite3_extension_init(sqlite3* db, char** errmsg, const sqlite3_api_routines* api);
+
+//---------------------------------------------------------------------------
+
+#pragma warning(pop)
+
+#endif	// __DBEXTENSION_H_
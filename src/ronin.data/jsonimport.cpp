@@ -0,0 +1,310 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+// jsonimport.cpp is compiled as native code without precompiled headers; the
+// standard library threading primitives cannot be used from code compiled with /clr
+
+#define NOMINMAX
+
+#include <Windows.h>
+#include <wincrypt.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include <rapidjson/document.h>
+#include <rapidjson/error/en.h>
+
+#include "jsonimport.h"
+
+#pragma warning(push, 4)
+
+//---------------------------------------------------------------------------
+// jsonimport::context_t
+//
+// Worker threads and the state shared between the workers and the consumer
+
+struct jsonimport::context_t {
+
+	// extract
+	//
+	// Extracts the column values from a JSON object into a row
+	void extract(rapidjson::Value const& object, row_t& row) const;
+
+	// parse
+	//
+	// Reads and parses a single import file into rows
+	void parse(std::wstring const& path, std::vector<row_t>& rows) const;
+
+	// run
+	//
+	// Worker thread entry point
+	void run(void);
+
+	std::vector<std::wstring>				files;				// Import file paths
+	std::vector<column_t>					columns;			// Columns to be extracted
+	bool									isarray = false;	// Files contain arrays of objects
+	size_t									depth = 0;			// Maximum files ahead of the consumer
+
+	std::mutex								lock;				// Synchronization object
+	std::condition_variable					changed;			// Signaled when the state changes
+	size_t									claimed = 0;		// Next file to be claimed by a worker
+	size_t									consumed = 0;		// Next file to be returned to the consumer
+	bool									stopped = false;	// Workers have been asked to stop
+	std::map<size_t, std::vector<row_t>>	results;			// Parsed files not yet consumed
+	std::map<size_t, std::string>			errors;				// Files that could not be parsed
+	std::vector<std::thread>				threads;			// Worker threads
+};
+
+//---------------------------------------------------------------------------
+// jsonimport::context_t::extract
+//
+// Extracts the column values from a JSON object into a row
+//
+// Arguments:
+//
+//	object		- JSON object to extract the column values from
+//	row			- Row to receive the extracted values
+
+void jsonimport::context_t::extract(rapidjson::Value const& object, row_t& row) const
+{
+	if(!object.IsObject()) throw std::runtime_error("contains a value that is not a JSON object");
+
+	row.resize(columns.size());
+
+	for(size_t index = 0; index < columns.size(); index++) {
+
+		column_t const& column = columns[index];
+		field_t& field = row[index];
+
+		// Missing and null members are both imported as null, the same as json_extract()
+		auto member = object.FindMember(column.name);
+		if((member == object.MemberEnd()) || member->value.IsNull()) continue;
+
+		rapidjson::Value const& value = member->value;
+
+		if(column.type == coltype_t::base64) {
+
+			if(!value.IsString()) throw std::runtime_error("contains a binary value that is not a base-64 string");
+
+			field.type = fieldtype_t::blob;
+
+			// A zero length tells CryptStringToBinaryA that the string is null-terminated
+			DWORD length = static_cast<DWORD>(value.GetStringLength());
+			if(length == 0) continue;
+
+			DWORD cb = 0;
+			CryptStringToBinaryA(value.GetString(), length, CRYPT_STRING_BASE64_ANY, nullptr, &cb, nullptr, nullptr);
+
+			field.data.resize(cb);
+			if(!CryptStringToBinaryA(value.GetString(), length, CRYPT_STRING_BASE64_ANY, reinterpret_cast<BYTE*>(&field.data[0]), &cb, nullptr, nullptr))
+				throw std::runtime_error("contains a binary value that could not be decoded from base-64");
+
+			field.data.resize(cb);
+		}
+
+		// Booleans are converted into integers, the same as json_extract()
+		else if(value.IsBool()) { field.type = fieldtype_t::integer; field.integer = value.GetBool() ? 1 : 0; }
+		else if(value.IsInt64()) { field.type = fieldtype_t::integer; field.integer = value.GetInt64(); }
+		else if(value.IsNumber()) { field.type = fieldtype_t::real; field.real = value.GetDouble(); }
+		else if(value.IsString()) { field.type = fieldtype_t::text; field.data.assign(value.GetString(), value.GetStringLength()); }
+		else throw std::runtime_error("contains an object or array where a scalar value is expected");
+	}
+}
+
+//---------------------------------------------------------------------------
+// jsonimport::context_t::parse
+//
+// Reads and parses a single import file into rows
+//
+// Arguments:
+//
+//	path		- Path of the file to be parsed
+//	rows		- Vector to receive the parsed rows
+
+void jsonimport::context_t::parse(std::wstring const& path, std::vector<row_t>& rows) const
+{
+	std::ifstream stream(path, std::ios::in | std::ios::binary);
+	if(!stream) throw std::runtime_error("could not be opened");
+
+	std::string json((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+	if(stream.bad()) throw std::runtime_error("could not be read");
+
+	// Remove the UTF-8 byte order mark from the file data if present
+	size_t offset = ((json.size() >= 3) && (json.compare(0, 3, "\xEF\xBB\xBF") == 0)) ? 3 : 0;
+	if(json.size() == offset) throw std::runtime_error("is empty");
+
+	rapidjson::Document document;
+	document.Parse(json.data() + offset, json.size() - offset);
+	if(document.HasParseError()) throw std::runtime_error(std::string("is not valid JSON: ") + rapidjson::GetParseError_En(document.GetParseError()));
+
+	// Files that contain an array produce one row for each element of the array
+	if(isarray) {
+
+		if(!document.IsArray()) throw std::runtime_error("does not contain a JSON array");
+
+		rows.resize(document.Size());
+		for(rapidjson::SizeType index = 0; index < document.Size(); index++) extract(document[index], rows[index]);
+	}
+
+	else {
+
+		rows.resize(1);
+		extract(document, rows[0]);
+	}
+}
+
+//---------------------------------------------------------------------------
+// jsonimport::context_t::run
+//
+// Worker thread entry point
+//
+// Arguments:
+//
+//	NONE
+
+void jsonimport::context_t::run(void)
+{
+	while(true) {
+
+		size_t index = 0;
+
+		{
+			std::unique_lock<std::mutex> guard(lock);
+
+			// Limit the number of files held ahead of the consumer; the worker that claims
+			// the file the consumer is waiting for is never blocked by this limit
+			changed.wait(guard, [&]() { return stopped || (claimed >= files.size()) || ((claimed - consumed) < depth); });
+			if(stopped || (claimed >= files.size())) return;
+
+			index = claimed++;
+		}
+
+		std::vector<row_t> rows;
+		std::string error;
+
+		try { parse(files[index], rows); }
+		catch(std::exception& ex) { error = ex.what(); }
+
+		{
+			std::lock_guard<std::mutex> guard(lock);
+
+			if(error.empty()) results.emplace(index, std::move(rows));
+			else errors.emplace(index, std::move(error));
+		}
+
+		changed.notify_all();
+	}
+}
+
+//---------------------------------------------------------------------------
+// jsonimport Constructor
+//
+// Arguments:
+//
+//	files		- Paths of the files to be imported
+//	columns		- Columns to be extracted from each JSON object
+//	isarray		- Flag indicating that each file contains an array of objects
+//	threads		- Number of worker threads
+//	depth		- Maximum number of files parsed ahead of the consumer
+
+jsonimport::jsonimport(std::vector<std::wstring> const& files, std::vector<column_t> const& columns, bool isarray, size_t threads, size_t depth) : 
+	m_context(new context_t())
+{
+	m_context->files = files;
+	m_context->columns = columns;
+	m_context->isarray = isarray;
+
+	// There is no benefit to more workers than files; each worker needs room to work ahead
+	threads = std::max<size_t>(1, std::min(threads, files.size()));
+	m_context->depth = std::max(depth, threads);
+
+	try {
+
+		for(size_t index = 0; index < threads; index++) m_context->threads.emplace_back(&context_t::run, m_context.get());
+	}
+
+	catch(...) {
+
+		{ std::lock_guard<std::mutex> guard(m_context->lock); m_context->stopped = true; }
+		m_context->changed.notify_all();
+
+		for(auto& thread : m_context->threads) thread.join();
+		throw;
+	}
+}
+
+//---------------------------------------------------------------------------
+// jsonimport Destructor
+
+jsonimport::~jsonimport()
+{
+	// Stop any workers that are still running; files that have not been consumed are discarded
+	{ std::lock_guard<std::mutex> guard(m_context->lock); m_context->stopped = true; }
+	m_context->changed.notify_all();
+
+	for(auto& thread : m_context->threads) thread.join();
+}
+
+//---------------------------------------------------------------------------
+// jsonimport::next
+//
+// Gets the rows parsed from the next file; returns false when all files have been read
+//
+// Arguments:
+//
+//	rows		- Vector to receive the rows parsed from the file
+
+bool jsonimport::next(std::vector<row_t>& rows)
+{
+	context_t& context = *m_context;
+
+	std::unique_lock<std::mutex> guard(context.lock);
+
+	if(context.consumed >= context.files.size()) return false;
+	size_t index = context.consumed;
+
+	// Files are returned in order regardless of the order in which the workers finish them
+	context.changed.wait(guard, [&]() { return (context.results.count(index) != 0) || (context.errors.count(index) != 0); });
+
+	auto error = context.errors.find(index);
+	if(error != context.errors.end()) throw exception(index, error->second.c_str());
+
+	auto result = context.results.find(index);
+	rows = std::move(result->second);
+	context.results.erase(result);
+	context.consumed++;
+
+	guard.unlock();
+	context.changed.notify_all();
+
+	return true;
+}
+
+//---------------------------------------------------------------------------
+
+#pragma warning(pop)
@@ -0,0 +1,138 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __JSONIMPORT_H_
+#define __JSONIMPORT_H_
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#pragma warning(push, 4)
+
+//---------------------------------------------------------------------------
+// Class jsonimport
+//
+// Native parallel reader for the JSON import files. Worker threads read and
+// parse the files with RapidJSON into rows of typed field values; the rows of
+// each file are handed back to the single consumer thread in file order. The
+// threading primitives live in the implementation so that this header can be
+// included by code that is compiled with /clr
+//---------------------------------------------------------------------------
+
+class jsonimport
+{
+public:
+
+	//-----------------------------------------------------------------------
+	// Type Declarations
+
+	// coltype_t
+	//
+	// Conversion applied to a column value
+	enum class coltype_t { value, base64 };
+
+	// column_t
+	//
+	// Describes a column to be extracted from each JSON object
+	struct column_t {
+
+		char const*		name;				// Name of the JSON member
+		coltype_t		type;				// Conversion applied to the value
+	};
+
+	// fieldtype_t
+	//
+	// Type of a field value; matches the SQLite storage classes
+	enum class fieldtype_t { null, integer, real, text, blob };
+
+	// field_t
+	//
+	// Single extracted field value
+	struct field_t {
+
+		fieldtype_t		type = fieldtype_t::null;	// Field value type
+		int64_t			integer = 0;				// Integer value
+		double			real = 0.0;					// Real value
+		std::string		data;						// UTF-8 text or binary data
+	};
+
+	// row_t
+	//
+	// Extracted field values, in the order of the columns
+	using row_t = std::vector<field_t>;
+
+	// exception
+	//
+	// Exception thrown when an import file cannot be read or parsed
+	class exception : public std::runtime_error
+	{
+	public:
+
+		exception(size_t file, char const* message) : std::runtime_error(message), file(file) {}
+
+		size_t const file;					// Index of the failed file
+	};
+
+	// Instance Constructor
+	//
+	jsonimport(std::vector<std::wstring> const& files, std::vector<column_t> const& columns, bool isarray, size_t threads, size_t depth);
+
+	// Destructor
+	//
+	~jsonimport();
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// next
+	//
+	// Gets the rows parsed from the next file; returns false when all files have been read
+	bool next(std::vector<row_t>& rows);
+
+private:
+
+	jsonimport(jsonimport const&)=delete;
+	jsonimport& operator=(jsonimport const&)=delete;
+
+	//-----------------------------------------------------------------------
+	// Private Type Declarations
+
+	// context_t
+	//
+	// Worker threads and shared state; declared in the implementation
+	struct context_t;
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	std::unique_ptr<context_t>		m_context;			// Worker context
+};
+
+//---------------------------------------------------------------------------
+
+#pragma warning(pop)
+
+#endif	// __JSONIMPORT_H_
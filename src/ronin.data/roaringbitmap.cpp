@@ -0,0 +1,511 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+// roaringbitmap.cpp is compiled as native code without precompiled headers;
+// the container algorithms are not suited to MSIL
+
+#include <intrin.h>
+#include <algorithm>
+#include <iterator>
+
+#include "roaringbitmap.h"
+
+#pragma warning(push, 4)
+
+//---------------------------------------------------------------------------
+// has_popcnt (local)
+//
+// Determines if the processor supports the POPCNT instruction
+//
+// Arguments:
+//
+//	NONE
+
+static bool has_popcnt(void)
+{
+	int info[4] = { 0, 0, 0, 0 };
+
+	// CPUID.1:ECX.POPCNT[23]
+	__cpuid(info, 1);
+	return ((info[2] & (1 << 23)) != 0);
+}
+
+// s_popcnt
+//
+// Flag indicating that the POPCNT instruction can be used
+static bool const s_popcnt = has_popcnt();
+
+//---------------------------------------------------------------------------
+// popcount (local)
+//
+// Counts the number of bits set in a 64-bit word
+//
+// Arguments:
+//
+//	word		- Word to count the bits of
+
+static size_t popcount(uint64_t word)
+{
+	if(s_popcnt) {
+
+#ifdef _M_X64
+		return static_cast<size_t>(__popcnt64(word));
+#else
+		return static_cast<size_t>(__popcnt(static_cast<uint32_t>(word)) + __popcnt(static_cast<uint32_t>(word >> 32)));
+#endif
+	}
+
+	// Processor does not support POPCNT; count the bits in parallel
+	word = word - ((word >> 1) & 0x5555555555555555ULL);
+	word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+	word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+	return static_cast<size_t>((word * 0x0101010101010101ULL) >> 56);
+}
+
+//---------------------------------------------------------------------------
+// popcount (local)
+//
+// Counts the number of bits set in a bitmap container
+//
+// Arguments:
+//
+//	bitmap		- Bitmap container words
+
+static size_t popcount(std::vector<uint64_t> const& bitmap)
+{
+	size_t count = 0;
+	for(uint64_t word : bitmap) count += popcount(word);
+
+	return count;
+}
+
+//---------------------------------------------------------------------------
+// for_each_bit (local)
+//
+// Invokes a function for each bit set in a bitmap container in ascending order
+//
+// Arguments:
+//
+//	bitmap		- Bitmap container words
+//	func		- Function to invoke with the 16-bit value of each set bit
+
+template<typename _func>
+static void for_each_bit(std::vector<uint64_t> const& bitmap, _func func)
+{
+	for(size_t index = 0; index < bitmap.size(); index++) {
+
+		uint64_t word = bitmap[index];
+		while(word != 0) {
+
+			uint64_t lowest = word & (~word + 1);
+			func(static_cast<uint16_t>((index << 6) + popcount(lowest - 1)));
+			word ^= lowest;
+		}
+	}
+}
+
+//---------------------------------------------------------------------------
+// test_bit (local)
+//
+// Determines if a value is set in a bitmap container
+//
+// Arguments:
+//
+//	bitmap		- Bitmap container words
+//	value		- 16-bit value to test
+
+inline static bool test_bit(std::vector<uint64_t> const& bitmap, uint16_t value)
+{
+	return (bitmap[value >> 6] & (1ULL << (value & 63))) != 0;
+}
+
+//---------------------------------------------------------------------------
+// roaringbitmap::add
+//
+// Adds a value to the set
+//
+// Arguments:
+//
+//	value		- Value to be added to the set
+
+void roaringbitmap::add(uint32_t value)
+{
+	uint16_t key = static_cast<uint16_t>(value >> 16);
+	uint16_t low = static_cast<uint16_t>(value & 0xFFFF);
+
+	// Locate or insert the container for the upper 16 bits of the value
+	auto container = std::lower_bound(m_containers.begin(), m_containers.end(), key,
+		[](container_t const& lhs, uint16_t rhs) -> bool { return lhs.key < rhs; });
+
+	if((container == m_containers.end()) || (container->key != key)) {
+
+		container = m_containers.insert(container, container_t());
+		container->key = key;
+	}
+
+	// Bitmap container
+	if(!container->bitmap.empty()) {
+
+		uint64_t& word = container->bitmap[low >> 6];
+		uint64_t bit = 1ULL << (low & 63);
+
+		if((word & bit) == 0) { word |= bit; container->cardinality++; }
+	}
+
+	// Array container
+	else {
+
+		auto position = std::lower_bound(container->array.begin(), container->array.end(), low);
+		if((position == container->array.end()) || (*position != low)) {
+
+			container->array.insert(position, low);
+			container->cardinality++;
+			normalize(*container);
+		}
+	}
+}
+
+//---------------------------------------------------------------------------
+// roaringbitmap::cardinality
+//
+// Gets the number of values in the set
+//
+// Arguments:
+//
+//	NONE
+
+size_t roaringbitmap::cardinality(void) const
+{
+	size_t cardinality = 0;
+	for(auto const& container : m_containers) cardinality += container.cardinality;
+
+	return cardinality;
+}
+
+//---------------------------------------------------------------------------
+// roaringbitmap::contains
+//
+// Determines if a value is present in the set
+//
+// Arguments:
+//
+//	value		- Value to be located in the set
+
+bool roaringbitmap::contains(uint32_t value) const
+{
+	uint16_t key = static_cast<uint16_t>(value >> 16);
+	uint16_t low = static_cast<uint16_t>(value & 0xFFFF);
+
+	auto container = std::lower_bound(m_containers.begin(), m_containers.end(), key,
+		[](container_t const& lhs, uint16_t rhs) -> bool { return lhs.key < rhs; });
+
+	if((container == m_containers.end()) || (container->key != key)) return false;
+
+	return (container->bitmap.empty()) ? std::binary_search(container->array.begin(), container->array.end(), low) :
+		test_bit(container->bitmap, low);
+}
+
+//---------------------------------------------------------------------------
+// roaringbitmap::intersect (static)
+//
+// Generates the intersection (AND) of two sets
+//
+// Arguments:
+//
+//	lhs			- Left-hand set
+//	rhs			- Right-hand set
+
+roaringbitmap roaringbitmap::intersect(roaringbitmap const& lhs, roaringbitmap const& rhs)
+{
+	roaringbitmap result;
+
+	size_t left = 0, right = 0;
+	while((left < lhs.m_containers.size()) && (right < rhs.m_containers.size())) {
+
+		container_t const& lcontainer = lhs.m_containers[left];
+		container_t const& rcontainer = rhs.m_containers[right];
+
+		if(lcontainer.key < rcontainer.key) left++;
+		else if(rcontainer.key < lcontainer.key) right++;
+		else {
+
+			container_t container;
+			intersect(lcontainer, rcontainer, container);
+			if(container.cardinality > 0) result.m_containers.push_back(std::move(container));
+
+			left++;
+			right++;
+		}
+	}
+
+	return result;
+}
+
+//---------------------------------------------------------------------------
+// roaringbitmap::intersect (private, static)
+//
+// Generates the intersection of two containers
+//
+// Arguments:
+//
+//	lhs			- Left-hand container
+//	rhs			- Right-hand container
+//	result		- Resultant container
+
+void roaringbitmap::intersect(container_t const& lhs, container_t const& rhs, container_t& result)
+{
+	result.key = lhs.key;
+
+	// array & array
+	if(lhs.bitmap.empty() && rhs.bitmap.empty()) {
+
+		std::set_intersection(lhs.array.begin(), lhs.array.end(), rhs.array.begin(), rhs.array.end(), std::back_inserter(result.array));
+		result.cardinality = result.array.size();
+	}
+
+	// array & bitmap
+	else if(lhs.bitmap.empty() || rhs.bitmap.empty()) {
+
+		container_t const& array = (lhs.bitmap.empty()) ? lhs : rhs;
+		container_t const& bitmap = (lhs.bitmap.empty()) ? rhs : lhs;
+
+		for(uint16_t value : array.array) if(test_bit(bitmap.bitmap, value)) result.array.push_back(value);
+		result.cardinality = result.array.size();
+	}
+
+	// bitmap & bitmap
+	else {
+
+		result.bitmap.resize(ROARINGBITMAP_WORDS);
+		for(size_t index = 0; index < ROARINGBITMAP_WORDS; index++) result.bitmap[index] = lhs.bitmap[index] & rhs.bitmap[index];
+
+		result.cardinality = popcount(result.bitmap);
+		normalize(result);
+	}
+}
+
+//---------------------------------------------------------------------------
+// roaringbitmap::normalize (private, static)
+//
+// Converts a container to the representation best suited to its cardinality
+//
+// Arguments:
+//
+//	container	- Container to be normalized
+
+void roaringbitmap::normalize(container_t& container)
+{
+	// bitmap -> array
+	if(!container.bitmap.empty() && (container.cardinality <= ROARINGBITMAP_ARRAYMAX)) {
+
+		container.array.reserve(container.cardinality);
+		for_each_bit(container.bitmap, [&](uint16_t value) -> void { container.array.push_back(value); });
+
+		container.bitmap.clear();
+		container.bitmap.shrink_to_fit();
+	}
+
+	// array -> bitmap
+	else if(container.bitmap.empty() && (container.cardinality > ROARINGBITMAP_ARRAYMAX)) {
+
+		container.bitmap.assign(ROARINGBITMAP_WORDS, 0);
+		for(uint16_t value : container.array) container.bitmap[value >> 6] |= (1ULL << (value & 63));
+
+		container.array.clear();
+		container.array.shrink_to_fit();
+	}
+}
+
+//---------------------------------------------------------------------------
+// roaringbitmap::subtract (static)
+//
+// Generates the difference (ANDNOT) of two sets
+//
+// Arguments:
+//
+//	lhs			- Left-hand set
+//	rhs			- Right-hand set
+
+roaringbitmap roaringbitmap::subtract(roaringbitmap const& lhs, roaringbitmap const& rhs)
+{
+	roaringbitmap result;
+
+	size_t right = 0;
+	for(container_t const& lcontainer : lhs.m_containers) {
+
+		while((right < rhs.m_containers.size()) && (rhs.m_containers[right].key < lcontainer.key)) right++;
+
+		// Containers without a counterpart are copied as-is
+		if((right == rhs.m_containers.size()) || (rhs.m_containers[right].key != lcontainer.key)) {
+
+			result.m_containers.push_back(lcontainer);
+			continue;
+		}
+
+		container_t container;
+		subtract(lcontainer, rhs.m_containers[right], container);
+		if(container.cardinality > 0) result.m_containers.push_back(std::move(container));
+	}
+
+	return result;
+}
+
+//---------------------------------------------------------------------------
+// roaringbitmap::subtract (private, static)
+//
+// Generates the difference of two containers
+//
+// Arguments:
+//
+//	lhs			- Left-hand container
+//	rhs			- Right-hand container
+//	result		- Resultant container
+
+void roaringbitmap::subtract(container_t const& lhs, container_t const& rhs, container_t& result)
+{
+	result.key = lhs.key;
+
+	// array - array
+	if(lhs.bitmap.empty() && rhs.bitmap.empty()) {
+
+		std::set_difference(lhs.array.begin(), lhs.array.end(), rhs.array.begin(), rhs.array.end(), std::back_inserter(result.array));
+		result.cardinality = result.array.size();
+	}
+
+	// array - bitmap
+	else if(lhs.bitmap.empty()) {
+
+		for(uint16_t value : lhs.array) if(!test_bit(rhs.bitmap, value)) result.array.push_back(value);
+		result.cardinality = result.array.size();
+	}
+
+	// bitmap - array | bitmap - bitmap
+	else {
+
+		result.bitmap = lhs.bitmap;
+
+		if(rhs.bitmap.empty()) { for(uint16_t value : rhs.array) result.bitmap[value >> 6] &= ~(1ULL << (value & 63)); }
+		else { for(size_t index = 0; index < ROARINGBITMAP_WORDS; index++) result.bitmap[index] &= ~rhs.bitmap[index]; }
+
+		result.cardinality = popcount(result.bitmap);
+		normalize(result);
+	}
+}
+
+//---------------------------------------------------------------------------
+// roaringbitmap::unite (static)
+//
+// Generates the union (OR) of two sets
+//
+// Arguments:
+//
+//	lhs			- Left-hand set
+//	rhs			- Right-hand set
+
+roaringbitmap roaringbitmap::unite(roaringbitmap const& lhs, roaringbitmap const& rhs)
+{
+	roaringbitmap result;
+
+	size_t left = 0, right = 0;
+	while((left < lhs.m_containers.size()) || (right < rhs.m_containers.size())) {
+
+		// Containers without a counterpart are copied as-is
+		if(right == rhs.m_containers.size()) result.m_containers.push_back(lhs.m_containers[left++]);
+		else if(left == lhs.m_containers.size()) result.m_containers.push_back(rhs.m_containers[right++]);
+		else if(lhs.m_containers[left].key < rhs.m_containers[right].key) result.m_containers.push_back(lhs.m_containers[left++]);
+		else if(rhs.m_containers[right].key < lhs.m_containers[left].key) result.m_containers.push_back(rhs.m_containers[right++]);
+		else {
+
+			container_t container;
+			unite(lhs.m_containers[left++], rhs.m_containers[right++], container);
+			result.m_containers.push_back(std::move(container));
+		}
+	}
+
+	return result;
+}
+
+//---------------------------------------------------------------------------
+// roaringbitmap::unite (private, static)
+//
+// Generates the union of two containers
+//
+// Arguments:
+//
+//	lhs			- Left-hand container
+//	rhs			- Right-hand container
+//	result		- Resultant container
+
+void roaringbitmap::unite(container_t const& lhs, container_t const& rhs, container_t& result)
+{
+	result.key = lhs.key;
+
+	// array | array
+	if(lhs.bitmap.empty() && rhs.bitmap.empty()) {
+
+		std::set_union(lhs.array.begin(), lhs.array.end(), rhs.array.begin(), rhs.array.end(), std::back_inserter(result.array));
+		result.cardinality = result.array.size();
+	}
+
+	// bitmap | array | bitmap | bitmap
+	else {
+
+		container_t const& bitmap = (lhs.bitmap.empty()) ? rhs : lhs;
+		container_t const& other = (lhs.bitmap.empty()) ? lhs : rhs;
+
+		result.bitmap = bitmap.bitmap;
+
+		if(other.bitmap.empty()) { for(uint16_t value : other.array) result.bitmap[value >> 6] |= (1ULL << (value & 63)); }
+		else { for(size_t index = 0; index < ROARINGBITMAP_WORDS; index++) result.bitmap[index] |= other.bitmap[index]; }
+
+		result.cardinality = popcount(result.bitmap);
+	}
+
+	normalize(result);
+}
+
+//---------------------------------------------------------------------------
+// roaringbitmap::values
+//
+// Writes the values in the set into a vector in ascending order
+//
+// Arguments:
+//
+//	values		- Vector to receive the values
+
+void roaringbitmap::values(std::vector<uint32_t>& values) const
+{
+	values.clear();
+	values.reserve(cardinality());
+
+	for(auto const& container : m_containers) {
+
+		uint32_t base = static_cast<uint32_t>(container.key) << 16;
+
+		if(container.bitmap.empty()) { for(uint16_t value : container.array) values.push_back(base | value); }
+		else for_each_bit(container.bitmap, [&](uint16_t value) -> void { values.push_back(base | value); });
+	}
+}
+
+//---------------------------------------------------------------------------
+
+#pragma warning(pop)
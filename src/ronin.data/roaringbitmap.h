@@ -0,0 +1,155 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __ROARINGBITMAP_H_
+#define __ROARINGBITMAP_H_
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#pragma warning(push, 4)
+
+//---------------------------------------------------------------------------
+// Constants
+
+// ROARINGBITMAP_ARRAYMAX
+//
+// Maximum cardinality of an array container before it becomes a bitmap
+#define ROARINGBITMAP_ARRAYMAX		4096
+
+// ROARINGBITMAP_WORDS
+//
+// Number of 64-bit words in a bitmap container
+#define ROARINGBITMAP_WORDS			1024
+
+//---------------------------------------------------------------------------
+// Class roaringbitmap
+//
+// Compressed set of 32-bit values. Values are partitioned by their upper 16
+// bits into containers that hold the lower 16 bits either as a sorted array
+// (sparse) or as a 65536-bit bitmap (dense)
+//---------------------------------------------------------------------------
+
+class roaringbitmap
+{
+public:
+
+	// Instance Constructors
+	//
+	roaringbitmap()=default;
+	roaringbitmap(roaringbitmap const&)=default;
+	roaringbitmap(roaringbitmap&&)=default;
+
+	// Assignment Operators
+	//
+	roaringbitmap& operator=(roaringbitmap const&)=default;
+	roaringbitmap& operator=(roaringbitmap&&)=default;
+
+	//-----------------------------------------------------------------------
+	// Member Functions
+
+	// add
+	//
+	// Adds a value to the set
+	void add(uint32_t value);
+
+	// cardinality
+	//
+	// Gets the number of values in the set
+	size_t cardinality(void) const;
+
+	// contains
+	//
+	// Determines if a value is present in the set
+	bool contains(uint32_t value) const;
+
+	// intersect (static)
+	//
+	// Generates the intersection (AND) of two sets
+	static roaringbitmap intersect(roaringbitmap const& lhs, roaringbitmap const& rhs);
+
+	// subtract (static)
+	//
+	// Generates the difference (ANDNOT) of two sets
+	static roaringbitmap subtract(roaringbitmap const& lhs, roaringbitmap const& rhs);
+
+	// unite (static)
+	//
+	// Generates the union (OR) of two sets
+	static roaringbitmap unite(roaringbitmap const& lhs, roaringbitmap const& rhs);
+
+	// values
+	//
+	// Writes the values in the set into a vector in ascending order
+	void values(std::vector<uint32_t>& values) const;
+
+private:
+
+	//-----------------------------------------------------------------------
+	// Private Type Declarations
+
+	// container_t
+	//
+	// Lower 16 bits of the values that share the same upper 16 bits
+	struct container_t {
+
+		uint16_t					key = 0;			// Upper 16 bits
+		size_t						cardinality = 0;	// Number of values
+		std::vector<uint16_t>		array;				// Sparse values
+		std::vector<uint64_t>		bitmap;				// Dense values
+	};
+
+	//-----------------------------------------------------------------------
+	// Private Member Functions
+
+	// intersect (static)
+	//
+	// Generates the intersection of two containers
+	static void intersect(container_t const& lhs, container_t const& rhs, container_t& result);
+
+	// normalize (static)
+	//
+	// Converts a container to the representation best suited to its cardinality
+	static void normalize(container_t& container);
+
+	// subtract (static)
+	//
+	// Generates the difference of two containers
+	static void subtract(container_t const& lhs, container_t const& rhs, container_t& result);
+
+	// unite (static)
+	//
+	// Generates the union of two containers
+	static void unite(container_t const& lhs, container_t const& rhs, container_t& result);
+
+	//-----------------------------------------------------------------------
+	// Member Variables
+
+	std::vector<container_t>		m_containers;		// Containers ordered by key
+};
+
+//---------------------------------------------------------------------------
+
+#pragma warning(pop)
+
+#endif	// __ROARINGBITMAP_H_
@@ -72,6 +72,8 @@
 #include <sqlite3.h>
 
 struct sqlite3 {};					// LNK4248: Unresolved typeref token
+struct sqlite3_backup {};			// LNK4248: Unresolved typeref token
+struct sqlite3_blob {};				// LNK4248: Unresolved typeref token
 struct sqlite3_context {};			// LNK4248: Unresolved typeref token
 struct sqlite3_stmt {};				// LNK4248: Unresolved typeref token
 struct sqlite3_value {};			// LNK4248: Unresolved typeref token
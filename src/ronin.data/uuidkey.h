@@ -0,0 +1,84 @@
+//---------------------------------------------------------------------------
+// Copyright (c) 2004-2024 Michael G. Brehm
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//---------------------------------------------------------------------------
+
+#ifndef __UUIDKEY_H_
+#define __UUIDKEY_H_
+#pragma once
+
+#include <stdint.h>
+
+#pragma warning(push, 4)
+
+//---------------------------------------------------------------------------
+// Type Declarations
+
+// uuidkey_t
+//
+// Blittable 128-bit UUID key; the 16 bytes are laid out identically to a UUID,
+// a System::Guid and the BLOB representation stored in the database
+struct uuidkey_t {
+
+	uint64_t		low;			// First 8 bytes of the UUID
+	uint64_t		high;			// Last 8 bytes of the UUID
+};
+
+static_assert(sizeof(uuidkey_t) == 16, "uuidkey_t must be exactly 16 bytes");
+
+//---------------------------------------------------------------------------
+// Functions
+
+// operator== (uuidkey_t)
+//
+inline bool operator==(uuidkey_t const& lhs, uuidkey_t const& rhs)
+{
+	return (lhs.low == rhs.low) && (lhs.high == rhs.high);
+}
+
+// operator!= (uuidkey_t)
+//
+inline bool operator!=(uuidkey_t const& lhs, uuidkey_t const& rhs)
+{
+	return (lhs.low != rhs.low) || (lhs.high != rhs.high);
+}
+
+// operator< (uuidkey_t)
+//
+inline bool operator<(uuidkey_t const& lhs, uuidkey_t const& rhs)
+{
+	return (lhs.low < rhs.low) || ((lhs.low == rhs.low) && (lhs.high < rhs.high));
+}
+
+// uuidkey_hash
+//
+// Generates a 32-bit hash code for a uuidkey_t; the bits of a random UUID are
+// already uniformly distributed so the two halves only need to be folded
+inline uint32_t uuidkey_hash(uuidkey_t const& key)
+{
+	uint64_t hash = key.low ^ (key.high * 0x9E3779B97F4A7C15ULL);
+	return static_cast<uint32_t>(hash ^ (hash >> 32));
+}
+
+//---------------------------------------------------------------------------
+
+#pragma warning(pop)
+
+#endif	// __UUIDKEY_H_
@@ -239,7 +239,7 @@ namespace zuki.ronin.ui
 			Print print = m_prints[args.ItemIndex];
 
 			// Create and initialize a new ListViewItem to return
-			// TODO: The call to .GetSeries every time will be a performance concern
+			// Print.GetSeries() is served from the database identity map after the first call
 			args.Item = new ListViewItem(new string[] { String.Empty, print.GetSeries().Name, print.ToString(), print.Rarity.EnumDescription() })
 			{
 				Font = m_listview.Font,
@@ -188,7 +188,7 @@ namespace zuki.ronin
 			string databasepath = Environment.GetFolderPath(Environment.SpecialFolder.CommonApplicationData);
 			databasepath = Path.Combine(databasepath, "ZukiSoft\\RONIN\\ronin.db");
 			
-			m_database = Database.Open("d:\\ronin.db");
+			m_database = Database.OpenImmutable("d:\\ronin.db");
 
 			List<Card> allcards = new List<Card>();
 			m_database.EnumerateCards(card => allcards.Add(card));